@@ -0,0 +1,688 @@
+/** Sub0Pub performance benchmarks
+ * @remark Run with '--benchmark_out=<file> --benchmark_out_format=json' (or build target Sub0Pub_BenchmarkJson) to record results
+ */
+
+#include "sub0pub/sub0pub.hpp"
+#include "sub0pub/async.hpp"
+#include "sub0pub/pool.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm> //< std::min
+#include <atomic> //< std::atomic
+#include <cstring> //< std::memcpy
+#include <memory> //< std::unique_ptr
+#include <thread> //< std::thread
+#include <vector> //< std::vector
+
+namespace
+{
+    const int cMaxSubscribers = 64; ///< Upper bound of the subscriber count sweep
+
+    /** Published data for the subscriber count sweep
+     */
+    struct Tick
+    {
+        uint64_t value;
+    };
+
+    /** Published data for the filter hit-rate sweep
+     */
+    struct Filtered
+    {
+        uint32_t value;
+    };
+
+    /** Published data of Size bytes for the payload sweep
+     */
+    template< size_t Size >
+    struct Payload
+    {
+        char bytes[Size];
+    };
+
+    /** Published data for the serialiser round-trip
+     */
+    struct Sample
+    {
+        uint64_t timestamp;
+        double value;
+    };
+
+    /** Cross-thread request and reply
+     */
+    struct Ping
+    {
+        uint64_t sequence;
+    };
+
+    struct Pong
+    {
+        uint64_t sequence;
+    };
+
+    /** State-like data sampled by a conflating subscriber
+     */
+    struct Pose
+    {
+        double position[3];
+        double orientation[4];
+        uint64_t timestamp;
+    };
+
+    /** Published data for the keyed subscription comparison, routed by symbol
+     */
+    struct MarketTick
+    {
+        uint32_t symbol;
+        double price;
+    };
+
+    /** Published data for the parallel fan-out comparison
+     */
+    struct Frame
+    {
+        uint64_t sequence;
+    };
+
+    /** Key extractor of MarketTick for KeySubscribe
+     */
+    struct SymbolOf
+    {
+        typedef uint32_t Key;
+        static Key key( const MarketTick& tick ) { return tick.symbol; }
+    };
+} // END: anon
+
+template<>
+struct sub0::BrokerTraits<Tick> : sub0::DefaultBrokerTraits
+{
+    static const uint32_t cMaxSubscriptions = cMaxSubscribers;
+};
+
+template<>
+struct sub0::BrokerTraits<MarketTick> : sub0::DefaultBrokerTraits
+{
+    static const uint32_t cMaxSubscriptions = cMaxSubscribers;
+};
+
+SUB0_TYPENAME(Sample, "Sample")
+
+namespace
+{
+    /** Subscriber accumulating received data so delivery cannot be optimised away
+     */
+    template< typename Data >
+    class Sink : public sub0::Subscribe<Data>
+    {
+    public:
+        Sink()
+            : count(0U)
+        {}
+
+        virtual void receive( const Data& data ) final
+        {
+            benchmark::DoNotOptimize( &data );
+            ++count;
+        }
+
+        uint64_t count;
+    };
+
+    /** Subscriber accepting 'hitPercent' percent of published values
+     */
+    class FilterSink : public sub0::Subscribe<Filtered>
+    {
+    public:
+        explicit FilterSink( const uint32_t hitPercent )
+            : hitPercent_(hitPercent)
+            , count(0U)
+        {}
+
+        virtual bool filter( const Filtered& data ) final
+        { return (data.value % 100U) < hitPercent_; }
+
+        virtual void receive( const Filtered& data ) final
+        {
+            benchmark::DoNotOptimize( &data );
+            ++count;
+        }
+
+    private:
+        const uint32_t hitPercent_;
+
+    public:
+        uint64_t count;
+    };
+
+    /** Subscriber to one symbol filtering every published tick
+     */
+    class SymbolFilterSink : public sub0::Subscribe<MarketTick>
+    {
+    public:
+        explicit SymbolFilterSink( const uint32_t symbol )
+            : symbol_(symbol)
+            , count(0U)
+        {}
+
+        virtual bool filter( const MarketTick& tick ) final
+        { return tick.symbol == symbol_; }
+
+        virtual void receive( const MarketTick& tick ) final
+        {
+            benchmark::DoNotOptimize( &tick );
+            ++count;
+        }
+
+    private:
+        const uint32_t symbol_;
+
+    public:
+        uint64_t count;
+    };
+
+    /** Subscriber to one symbol delivered only its ticks by the key index
+     */
+    class SymbolKeySink : public sub0::KeySubscribe<MarketTick, SymbolOf>
+    {
+    public:
+        explicit SymbolKeySink( const uint32_t symbol )
+            : sub0::KeySubscribe<MarketTick, SymbolOf>( symbol )
+            , count(0U)
+        {}
+
+        virtual void receive( const MarketTick& tick ) final
+        {
+            benchmark::DoNotOptimize( &tick );
+            ++count;
+        }
+
+        uint64_t count;
+    };
+
+    /** Fixed compute cost standing in for a heavyweight handler
+     */
+    inline uint64_t work( uint64_t value )
+    {
+        for ( int iRound = 0; iRound < 2000; ++iRound )
+            value = (value ^ (value >> 7U)) * 0x9E3779B97F4A7C15ULL;
+        return value;
+    }
+
+    /** Heavyweight subscriber receiving on the publishing thread
+     */
+    class FrameSink : public sub0::Subscribe<Frame>
+    {
+    public:
+        virtual void receive( const Frame& frame ) final
+        { benchmark::DoNotOptimize( work( frame.sequence ) ); }
+    };
+
+    /** Heavyweight subscriber receiving on a ParallelExecutor worker
+     */
+    class ParallelFrameSink : public sub0::ParallelSubscribe<Frame>
+    {
+    public:
+        explicit ParallelFrameSink( sub0::ParallelDelivery<Frame>& delivery )
+            : sub0::ParallelSubscribe<Frame>( delivery )
+        {}
+
+        ~ParallelFrameSink()
+        { unsubscribe(); }
+
+        virtual void receive( const Frame& frame ) final
+        { benchmark::DoNotOptimize( work( frame.sequence ) ); }
+    };
+
+    /** Growable in-memory stream used as both serialiser output and deserialiser input
+     */
+    class MemoryStream : public sub0::OStream, public sub0::IStream
+    {
+    public:
+        MemoryStream()
+            : buffer_()
+            , readPosition_(0U)
+        {}
+
+        /** Discard content retaining capacity
+         */
+        void clear()
+        {
+            buffer_.clear();
+            readPosition_ = 0U;
+        }
+
+        size_t size() const
+        { return buffer_.size(); }
+
+        virtual sub0::OStream::StreamSize write( const char* const buffer, const sub0::OStream::StreamSize bufferCount ) final
+        {
+            buffer_.insert( buffer_.end(), buffer, buffer + bufferCount );
+            return bufferCount;
+        }
+
+        virtual void flush() final
+        {}
+
+        virtual sub0::IStream::StreamSize read( char* const buffer, const sub0::IStream::StreamSize bufferCount ) final
+        {
+            const sub0::IStream::StreamSize count = available( bufferCount );
+            std::memcpy( buffer, buffer_.data() + readPosition_, count );
+            readPosition_ += count;
+            return count;
+        }
+
+        virtual sub0::IStream::StreamSize ignore( const sub0::IStream::StreamSize bufferCount ) final
+        {
+            const sub0::IStream::StreamSize count = available( bufferCount );
+            readPosition_ += count;
+            return count;
+        }
+
+        virtual sub0::IStream::StreamSize ignore( const sub0::IStream::StreamSize bufferCount, const char delimiter ) final
+        {
+            sub0::IStream::StreamSize count = 0U;
+            while ( (count < bufferCount) && (readPosition_ < buffer_.size()) )
+            {
+                ++count;
+                if ( buffer_[readPosition_++] == delimiter )
+                    break;
+            }
+            return count;
+        }
+
+        virtual bool isEof() final
+        { return readPosition_ == buffer_.size(); }
+
+    private:
+        sub0::IStream::StreamSize available( const sub0::IStream::StreamSize bufferCount ) const
+        { return static_cast<sub0::IStream::StreamSize>( std::min<size_t>( bufferCount, buffer_.size() - readPosition_ ) ); }
+
+    private:
+        std::vector<char> buffer_; ///< Written bytes
+        size_t readPosition_; ///< Offset of the next byte to read
+    };
+
+    MemoryStream roundTripStream; ///< Stream shared by the round-trip serialiser and deserialiser
+
+    class SampleSerializer : public sub0::StreamSerializer<>
+                           , public sub0::ForwardSubscribe<Sample, SampleSerializer>
+    {
+    public:
+        explicit SampleSerializer( const size_t bufferSize )
+            : sub0::StreamSerializer<>( roundTripStream, bufferSize )
+        {}
+    };
+
+    class SampleDeserializer : public sub0::StreamDeserializer<>
+                             , public sub0::ForwardPublish<Sample, SampleDeserializer>
+    {
+    public:
+        SampleDeserializer()
+            : sub0::StreamDeserializer<>( roundTripStream )
+        {}
+    };
+
+    class SampleBufferDeserializer : public sub0::BufferDeserializer<>
+                                   , public sub0::DirectPublish<Sample, SampleBufferDeserializer>
+    {};
+
+    /** Subscriber queuing Ping for a worker thread which replies with Pong
+     */
+    class Echo : public sub0::AsyncSubscribe<Ping>
+               , public sub0::Publish<Pong>
+    {
+    public:
+        virtual void receive( const Ping& ping ) final
+        {
+            const Pong pong = { ping.sequence };
+            sub0::publish( this, pong );
+        }
+    };
+
+    /** Subscriber queuing Pong replies for the benchmark thread
+     */
+    class Reply : public sub0::AsyncSubscribe<Pong>
+    {
+    public:
+        Reply()
+            : sequence(0U)
+        {}
+
+        virtual void receive( const Pong& pong ) final
+        { sequence = pong.sequence; }
+
+        uint64_t sequence;
+    };
+} // END: anon
+
+/** Publish latency against the count of subscribers of the type
+ */
+static void BM_PublishSubscriberCount( benchmark::State& state )
+{
+    const sub0::Publish<Tick> publisher;
+    std::vector< std::unique_ptr< Sink<Tick> > > subscribers;
+    for ( int64_t iSubscriber = 0; iSubscriber < state.range(0); ++iSubscriber )
+    {
+        subscribers.emplace_back( new Sink<Tick>() );
+    }
+
+    Tick tick = { 0U };
+    for ( auto _ : state )
+    {
+        publisher.publish( tick );
+        ++tick.value;
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK(BM_PublishSubscriberCount)->RangeMultiplier(2)->Range(1, cMaxSubscribers);
+
+/** Publish latency against the size of the published data
+ */
+template< size_t Size >
+static void BM_PublishPayloadSize( benchmark::State& state )
+{
+    const sub0::Publish< Payload<Size> > publisher;
+    const Sink< Payload<Size> > subscriber;
+
+    Payload<Size> payload = {};
+    for ( auto _ : state )
+    {
+        publisher.publish( payload );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>(Size) );
+}
+BENCHMARK_TEMPLATE(BM_PublishPayloadSize, 8);
+BENCHMARK_TEMPLATE(BM_PublishPayloadSize, 64);
+BENCHMARK_TEMPLATE(BM_PublishPayloadSize, 512);
+BENCHMARK_TEMPLATE(BM_PublishPayloadSize, 4096);
+BENCHMARK_TEMPLATE(BM_PublishPayloadSize, 65536);
+
+/** Publish latency against the percentage of data accepted by Subscribe::filter()
+ */
+static void BM_PublishFilterHitRate( benchmark::State& state )
+{
+    const sub0::Publish<Filtered> publisher;
+    FilterSink subscriber( static_cast<uint32_t>(state.range(0)) );
+
+    Filtered data = { 0U };
+    for ( auto _ : state )
+    {
+        publisher.publish( data );
+        ++data.value;
+    }
+
+    state.counters["received"] = benchmark::Counter( static_cast<double>(subscriber.count), benchmark::Counter::kAvgIterations );
+}
+BENCHMARK(BM_PublishFilterHitRate)->Arg(0)->Arg(25)->Arg(50)->Arg(75)->Arg(100);
+
+/** Publish latency routing ticks over a sweep of symbols with one subscriber per symbol
+ * @remark Compares every subscriber filtering by symbol (Arg 0) with a KeySubscribe index delivering to the matching subscriber only (Arg 1)
+ */
+static void BM_PublishSymbolRouting( benchmark::State& state )
+{
+    const uint32_t symbolCount = static_cast<uint32_t>( state.range(0) );
+    const bool keyed = (state.range(1) != 0);
+    std::vector< std::unique_ptr<SymbolFilterSink> > filterSinks;
+    std::vector< std::unique_ptr<SymbolKeySink> > keySinks;
+    for ( uint32_t iSymbol = 0U; iSymbol < symbolCount; ++iSymbol )
+    {
+        if ( keyed )
+            keySinks.emplace_back( new SymbolKeySink(iSymbol) );
+        else
+            filterSinks.emplace_back( new SymbolFilterSink(iSymbol) );
+    }
+
+    const sub0::Publish<MarketTick> publisher;
+    MarketTick tick = { 0U, 100.0 };
+    for ( auto _ : state )
+    {
+        publisher.publish( tick );
+        tick.symbol = (tick.symbol + 1U) % symbolCount;
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK(BM_PublishSymbolRouting)->ArgsProduct( { { 1, 8, 50 }, { 0, 1 } } );
+
+/** StreamSerializer to StreamDeserializer throughput with DefaultSerialisation against the serialiser buffer size
+ * @remark Each iteration serialises then deserialises a block of records, the serialiser is scoped to the first phase so it
+ *  does not re-serialise the data republished by the deserialiser
+ */
+static void BM_StreamRoundTrip( benchmark::State& state )
+{
+    const int64_t recordCount = state.range(0);
+    const sub0::Publish<Sample> publisher;
+    const Sink<Sample> subscriber;
+
+    Sample sample = { 0U, 0.0 };
+    size_t streamBytes = 0U;
+    for ( auto _ : state )
+    {
+        roundTripStream.clear();
+        {
+            const SampleSerializer serializer( static_cast<size_t>(state.range(1)) );
+            for ( int64_t iRecord = 0; iRecord < recordCount; ++iRecord )
+            {
+                publisher.publish( sample );
+                ++sample.timestamp;
+            }
+        }
+        streamBytes = roundTripStream.size();
+
+        SampleDeserializer deserializer;
+        while ( deserializer.update() )
+        {}
+    }
+
+    state.SetItemsProcessed( state.iterations() * recordCount );
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>(streamBytes) );
+}
+BENCHMARK(BM_StreamRoundTrip)->ArgsProduct({ {1, 64, 1024}, {0, 4096} });
+
+/** Decode throughput of a recorded stream held in memory using BufferDeserializer
+ */
+static void BM_BufferDeserialize( benchmark::State& state )
+{
+    const int64_t recordCount = state.range(0);
+    roundTripStream.clear();
+    {
+        const sub0::Publish<Sample> publisher;
+        const SampleSerializer serializer( 64U * 1024U );
+        Sample sample = { 0U, 0.0 };
+        for ( int64_t iRecord = 0; iRecord < recordCount; ++iRecord )
+        {
+            publisher.publish( sample );
+            ++sample.timestamp;
+        }
+    }
+    std::vector<char> recording( roundTripStream.size() );
+    roundTripStream.read( recording.data(), static_cast<sub0::IStream::StreamSize>(recording.size()) );
+
+    const Sink<Sample> subscriber;
+    SampleBufferDeserializer deserializer;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( deserializer.update(recording.data(), recording.size()) );
+    }
+
+    state.SetItemsProcessed( state.iterations() * recordCount );
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>(recording.size()) );
+}
+BENCHMARK(BM_BufferDeserialize)->Arg(1024)->Arg(65536);
+
+/** Deserializer buffer lookup against the count of registered Data types for each BufferRegister policy
+ */
+template< typename Register >
+static void BM_BufferRegisterFind( benchmark::State& state )
+{
+    typedef sub0::DefaultSerialisation::Header Header;
+    const uint32_t typeCount = static_cast<uint32_t>(state.range(0));
+
+    Register registry;
+    std::vector<char> buffers( typeCount );
+    Header header;
+    header.dataBytes = 1U;
+    for ( uint32_t iType = 0U; iType < typeCount; ++iType )
+    {
+        header.typeId = iType;
+        registry.set( header, sub0::Buffer{ &buffers[iType], 1U, 0U, nullptr } );
+    }
+
+    uint32_t typeId = 0U;
+    for ( auto _ : state )
+    {
+        header.typeId = typeId;
+        benchmark::DoNotOptimize( registry.find(header) );
+        typeId = (typeId + 7U) % typeCount;
+    }
+}
+BENCHMARK_TEMPLATE(BM_BufferRegisterFind, sub0::BufferRegister<sub0::DefaultSerialisation::Header, 1024U>)->RangeMultiplier(4)->Range(4, 1000);
+BENCHMARK_TEMPLATE(BM_BufferRegisterFind, sub0::DenseBufferRegister<sub0::DefaultSerialisation::Header, 1024U>)->RangeMultiplier(4)->Range(4, 1000);
+BENCHMARK_TEMPLATE(BM_BufferRegisterFind, sub0::HashBufferRegister<sub0::DefaultSerialisation::Header, 2048U>)->RangeMultiplier(4)->Range(4, 1000);
+
+/** Round trip latency of data published to an AsyncSubscribe drained on another thread, which replies in kind
+ * @remark Reported time is for the round trip, one-way delivery latency is half
+ */
+static void BM_CrossThreadRoundTrip( benchmark::State& state )
+{
+    const sub0::Publish<Ping> publisher;
+    Reply reply;
+    Echo echo; //< Subscribed here so the worker thread only drains
+    std::atomic<bool> running( true );
+
+    std::thread worker( [&running, &echo]()
+    {
+        while ( running.load(std::memory_order_relaxed) )
+        {
+            if ( echo.drain() == 0U )
+                std::this_thread::yield();
+        }
+    } );
+
+    Ping ping = { 0U };
+    for ( auto _ : state )
+    {
+        ++ping.sequence;
+        publisher.publish( ping );
+        while ( reply.sequence != ping.sequence )
+        {
+            if ( reply.drain() == 0U )
+                std::this_thread::yield();
+        }
+    }
+
+    running.store( false, std::memory_order_relaxed );
+    worker.join();
+}
+BENCHMARK(BM_CrossThreadRoundTrip)->UseRealTime();
+
+/** Publish into a LatestSubscribe without (0) and with (1) another thread reading the latest value continuously
+ * @remark Publish cost is a single slot write however often or rarely the consumer reads
+ */
+static void BM_PublishLatest( benchmark::State& state )
+{
+    const sub0::Publish<Pose> publisher;
+    const sub0::LatestSubscribe<Pose> latest;
+    std::atomic<bool> running( state.range(0) != 0 );
+
+    std::thread reader( [&running, &latest]()
+    {
+        Pose pose;
+        while ( running.load(std::memory_order_relaxed) )
+            benchmark::DoNotOptimize( latest.read(pose) );
+    } );
+
+    Pose pose = {};
+    for ( auto _ : state )
+    {
+        ++pose.timestamp;
+        publisher.publish( pose );
+    }
+
+    running.store( false, std::memory_order_relaxed );
+    reader.join();
+    state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK(BM_PublishLatest)->Arg(0)->Arg(1)->UseRealTime();
+
+/** Allocation and release of a 64 byte message from the heap (0), Pool<Data> (1) and ThreadArena (2)
+ * @remark Arena memory is reclaimed in blocks of 64 messages as a consumer would per drain()
+ */
+static void BM_MessageAllocation( benchmark::State& state )
+{
+    typedef Payload<64> Message;
+    const int64_t source = state.range(0);
+    Message* messages[64];
+    for ( auto _ : state )
+    {
+        for ( int iMessage = 0; iMessage < 64; ++iMessage )
+        {
+            messages[iMessage] = (source == 0) ? new Message()
+                : (source == 1) ? sub0::Pool<Message>::instance().create()
+                : sub0::ThreadArena<>::create<Message>();
+            benchmark::DoNotOptimize( messages[iMessage] );
+        }
+        if ( source == 0 )
+        {
+            for ( int iMessage = 0; iMessage < 64; ++iMessage )
+                delete messages[iMessage];
+        }
+        else if ( source == 1 )
+        {
+            for ( int iMessage = 0; iMessage < 64; ++iMessage )
+                sub0::Pool<Message>::instance().destroy( messages[iMessage] );
+        }
+        else
+        {
+            sub0::ThreadArena<>::reset();
+        }
+    }
+
+    state.SetItemsProcessed( state.iterations() * 64 );
+}
+BENCHMARK(BM_MessageAllocation)->Arg(0)->Arg(1)->Arg(2);
+
+/** Publish Frame for each benchmark iteration
+ */
+static void publishFrames( benchmark::State& state )
+{
+    const sub0::Publish<Frame> publisher;
+    Frame frame = { 0U };
+    for ( auto _ : state )
+    {
+        publisher.publish( frame );
+        ++frame.sequence;
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+/** Publish of Frame to 8 heavyweight subscribers serially (0) and fanned out over a 4 worker ParallelExecutor (1)
+ * @remark Parallel publish latency approaches that of the slowest handler given free cores, on fewer cores it adds the task overhead
+ * @note The executor is held in automatic storage as its cache line aligned queues are not honoured by C++11 new
+ */
+static void BM_PublishParallelFanOut( benchmark::State& state )
+{
+    const int cSubscribers = 8;
+    if ( state.range(0) == 0 )
+    {
+        std::vector< std::unique_ptr<FrameSink> > serial;
+        for ( int iSubscriber = 0; iSubscriber < cSubscribers; ++iSubscriber )
+            serial.emplace_back( new FrameSink() );
+        publishFrames( state );
+    }
+    else
+    {
+        sub0::ParallelExecutor<4U> executor;
+        sub0::ParallelDelivery<Frame> delivery( executor );
+        std::vector< std::unique_ptr<ParallelFrameSink> > parallel;
+        for ( int iSubscriber = 0; iSubscriber < cSubscribers; ++iSubscriber )
+            parallel.emplace_back( new ParallelFrameSink( delivery ) );
+        publishFrames( state );
+    }
+}
+BENCHMARK(BM_PublishParallelFanOut)->Arg(0)->Arg(1)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -2,19 +2,15 @@
 
 #include "sub0pub/sub0pub.hpp"
 
+#if defined(_WIN32)
 #if Sub0Pub_CrossModule_Publisher_EXPORTS
-#define DLLEXPORT __declspec(dllexport)   
-#define DLLEXTERN
+#define DLLEXPORT __declspec(dllexport)
 #else
 #define DLLEXPORT __declspec(dllimport)
-#define DLLEXTERN extern
+#endif
+#else
+#define DLLEXPORT __attribute__((visibility("default")))
 #endif
 
-
-// @note Exporting the broker is critical for the instance to become shared across DLL module boundaries
-DLLEXTERN template class DLLEXPORT sub0::Broker<float>;
-DLLEXTERN template class DLLEXPORT sub0::Broker<int>;
-
-#include "sub0pub/sub0pub.hpp"
-
+// @note Brokers are shared across module boundaries by SUB0PUB_SHARED_BROKERS, only the example function is exported
 DLLEXPORT void doPublisher();
\ No newline at end of file
@@ -0,0 +1,1182 @@
+/** Sub0Pub asynchronous delivery extensions
+ * @remark Subscriptions that queue published data for processing on the subscriber's own thread or a delivery worker thread
+ *
+ *  This file is part of Sub0Pub. Original project source available at https://github.com/Crog/Sub0Pub/blob/master/sub0pub.hpp
+ *
+ *  MIT License
+ *
+ * Copyright (c) 2018 Craig Hutchinson <craig-sub0pub@crog.uk>
+ *
+ *  See sub0pub.hpp for full license text.
+ */
+#ifndef CROG_SUB0PUB_ASYNC_HPP
+#define CROG_SUB0PUB_ASYNC_HPP
+
+#include "sub0pub.hpp"
+
+#include <condition_variable> //< std::condition_variable
+
+#if !SUB0PUB_THREADS
+#error "sub0pub/async.hpp requires SUB0PUB_THREADS"
+#endif
+
+/** Sub0Pub top-level namespace
+*/
+namespace sub0
+{
+    /** Behaviour when publishing into a full mailbox
+     */
+    enum class Overflow
+    {
+          DropOldest ///< Discard the oldest queued data to make room
+        , DropNewest ///< Discard the data being published
+        , Block ///< Publisher waits until the subscriber has drained space @warning Deadlocks if the subscriber drains on the publishing thread
+    };
+
+    namespace detail
+    {
+        /** Bounded lock-free ring of Data with a single producer, or several producers through tryPushShared()
+         * @remark Slots carry a sequence number and readers claim a slot before copying it out, so the producer may also
+         *  pop to discard the oldest entry without racing the consumer on the slot data.
+         * @tparam Data  Queued data type @note Must be default constructible and copy assignable
+         * @tparam cCapacity  Slot count @note Must be a power of two
+         */
+        template< typename Data, uint32_t cCapacity >
+        class MailboxRing
+        {
+            static_assert( (cCapacity >= 2U) && ((cCapacity & (cCapacity - 1U)) == 0U), "Mailbox capacity must be a power of two" );
+            static const uint32_t cMask = cCapacity - 1U;
+
+        public:
+            MailboxRing()
+                : pushPosition_(0U)
+                , popPosition_(0U)
+                , slots_()
+            {
+                for ( uint32_t iSlot = 0U; iSlot < cCapacity; ++iSlot )
+                {
+                    slots_[iSlot].sequence.store( iSlot, std::memory_order_relaxed );
+                }
+            }
+
+            /** Append data if a slot is free
+             * @warning Producer side, only one thread may push at a time
+             * @return False if the ring is full
+             */
+            bool tryPush( const Data& data )
+            {
+                const uint32_t position = pushPosition_.load(std::memory_order_relaxed);
+                Slot& slot = slots_[position & cMask];
+                if ( slot.sequence.load(std::memory_order_acquire) != position )
+                    return false; //< Slot still held by the previous lap
+
+                slot.data = data;
+                slot.sequence.store( position + 1U, std::memory_order_release );
+                pushPosition_.store( position + 1U, std::memory_order_relaxed );
+                return true;
+            }
+
+            /** Append data if a slot is free, safe with concurrent tryPushShared() from other threads
+             * @remark Producers claim the push position before writing the slot, tryPop() of a claimed slot still being
+             *  written returns false until the write completes.
+             * @warning Do not mix with tryPush() on the same ring
+             * @return False if the ring is full
+             */
+            bool tryPushShared( const Data& data )
+            {
+                uint32_t position = pushPosition_.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    Slot& slot = slots_[position & cMask];
+                    const int32_t free = static_cast<int32_t>( slot.sequence.load(std::memory_order_acquire) - position );
+                    if ( free < 0 )
+                        return false; //< Slot still held by the previous lap
+
+                    if ( free > 0 )
+                    {
+                        position = pushPosition_.load(std::memory_order_relaxed); //< Another producer claimed position
+                    }
+                    else if ( pushPosition_.compare_exchange_weak( position, position + 1U, std::memory_order_relaxed ) )
+                    {
+                        slot.data = data;
+                        slot.sequence.store( position + 1U, std::memory_order_release );
+                        return true;
+                    }
+                }
+            }
+
+            /** Remove the oldest data
+             * @remark Safe to call from both the consumer and the producer
+             * @param[out] data  Receives the removed data
+             * @return False if the ring is empty or the oldest slot is still being written
+             */
+            bool tryPop( Data& data )
+            {
+                uint32_t position = popPosition_.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    Slot& slot = slots_[position & cMask];
+                    const int32_t ready = static_cast<int32_t>( slot.sequence.load(std::memory_order_acquire) - (position + 1U) );
+                    if ( ready < 0 )
+                        return false; //< Empty
+
+                    if ( ready > 0 )
+                    {
+                        position = popPosition_.load(std::memory_order_relaxed); //< Another reader claimed position
+                    }
+                    else if ( popPosition_.compare_exchange_weak( position, position + 1U, std::memory_order_relaxed ) )
+                    {
+                        data = slot.data;
+                        slot.sequence.store( position + cCapacity, std::memory_order_release );
+                        return true;
+                    }
+                }
+            }
+
+            /** @return True when no data is queued @note Approximate while other threads push or pop
+             */
+            bool empty() const
+            { return popPosition_.load(std::memory_order_relaxed) == pushPosition_.load(std::memory_order_relaxed); }
+
+        private:
+            /** Ring slot padded to a cache line so producer and consumer do not falsely share
+             */
+            struct alignas(64) Slot
+            {
+                Slot() : sequence(0U), data() {}
+                std::atomic<uint32_t> sequence; ///< Slot lap state, equal to the push position when free and push position+1 when filled
+                Data data;
+            };
+
+            alignas(64) std::atomic<uint32_t> pushPosition_; ///< Next position to write
+            alignas(64) std::atomic<uint32_t> popPosition_; ///< Next position to read
+            Slot slots_[cCapacity];
+        };
+
+        /** Queue data with MailboxRing::tryPushShared or, for a single producer, MailboxRing::tryPush
+         */
+        template< typename Data, uint32_t cCapacity >
+        inline bool tryPush( MailboxRing<Data, cCapacity>& mailbox, const Data& data, std::true_type /*cShared*/ )
+        { return mailbox.tryPushShared( data ); }
+
+        template< typename Data, uint32_t cCapacity >
+        inline bool tryPush( MailboxRing<Data, cCapacity>& mailbox, const Data& data, std::false_type /*cShared*/ )
+        { return mailbox.tryPush( data ); }
+
+        /** Queue data into a mailbox applying the cOverflow policy when full
+         * @tparam cOverflow  Behaviour when the mailbox is full
+         * @tparam cShared  Several threads may push at once
+         * @param mailbox  Mailbox to queue into
+         * @param data  Data to queue
+         * @param dropCount  Incremented for each discarded data
+         */
+        template< Overflow cOverflow, bool cShared = false, typename Data, uint32_t cCapacity >
+        inline void push( MailboxRing<Data, cCapacity>& mailbox, const Data& data, std::atomic<uint32_t>& dropCount )
+        {
+            const std::integral_constant<bool, cShared> shared;
+            if ( tryPush( mailbox, data, shared ) )
+                return;
+
+            switch ( cOverflow )
+            {
+            case Overflow::DropNewest:
+                dropCount.fetch_add( 1U, std::memory_order_relaxed );
+                break;
+
+            case Overflow::DropOldest:
+                {
+                    bool dropped = false;
+                    Data discard;
+                    while ( !tryPush( mailbox, data, shared ) )
+                    {
+                        if ( !dropped && mailbox.tryPop(discard) )
+                        {
+                            dropped = true; //< Only discard once, a failed push after that waits for the consumer to release its claimed slot
+                            dropCount.fetch_add( 1U, std::memory_order_relaxed );
+                        }
+                        else
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+                break;
+
+            case Overflow::Block:
+                while ( !tryPush( mailbox, data, shared ) )
+                {
+                    std::this_thread::yield();
+                }
+                break;
+            }
+        }
+    } // END: detail
+
+    /** Subscription which queues published data into a bounded lock-free mailbox drained on the subscriber's thread
+     * @remark Publishing copies the data into the mailbox so a slow receive() does not stall the publisher.
+     *  The subscriber calls drain() from its own thread which invokes receive() for each queued data. The mailbox starts with the
+     *  cached last value when BrokerTraits<Data>::cCacheLast.
+     * @warning The mailbox has a single producer, publishes of Data must not happen from more than one thread at a time
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     * @tparam  cCapacity  Mailbox slot count @note Must be a power of two
+     * @tparam  cOverflow  Behaviour when publishing into a full mailbox
+     */
+    template< typename Data, uint32_t cCapacity = 64U, Overflow cOverflow = Overflow::DropNewest >
+    class AsyncSubscribe
+    {
+    public:
+        /** Registers the subscriber within the broker framework
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        AsyncSubscribe(
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscribed_(true)
+        , dropCount_(0U)
+        , mailbox_()
+        , broker_( subscription()
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { replay(); }
+
+        /** Registers the subscriber within the broker framework with a dispatch priority
+         * @param[in] priority  Order in which data is queued relative to other subscribers of Data, higher first
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        explicit AsyncSubscribe( const Priority priority
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscribed_(true)
+        , dropCount_(0U)
+        , mailbox_()
+        , broker_( subscription( priority )
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { replay(); }
+
+        virtual ~AsyncSubscribe()
+        {  unsubscribe(); }
+
+        /** Receive published Data
+         * @remark Called from drain() on the subscriber's thread
+         */
+        virtual void receive( const Data& data ) = 0;
+
+        /** Select data to be queued
+         * @remark Called on the publishing thread before queuing
+         */
+        virtual bool filter( const Data& /*data*/ )
+        {  return true; }
+
+        /** Deliver queued data to receive() on the calling thread
+         * @warning Only one thread may drain at a time
+         * @param[in] maxCount  Maximum count of data to deliver
+         * @return Count of data delivered
+         */
+        uint32_t drain( const uint32_t maxCount = UINT32_MAX )
+        {
+            uint32_t count = 0U;
+            Data data;
+            while ( (count < maxCount) && mailbox_.tryPop(data) )
+            {
+                receive( data );
+                ++count;
+            }
+            return count;
+        }
+
+        /** @return True when no data is waiting to be drained
+         */
+        bool empty() const
+        { return mailbox_.empty(); }
+
+        /** @return Count of published data discarded due to Overflow::DropOldest or Overflow::DropNewest
+         */
+        uint32_t dropCount() const
+        { return dropCount_.load(std::memory_order_relaxed); }
+
+    protected:
+        /** Remove the subscription ahead of destruction
+         * @remark Call first in the most-derived destructor when publishing from another thread, the base destructor then does nothing
+         */
+        void unsubscribe()
+        {
+            if ( subscribed_ )
+            {
+                broker_.unsubscribe( subscription() );
+                subscribed_ = false;
+            }
+        }
+
+    private:
+        AsyncSubscribe( const AsyncSubscribe& ); ///< Non-copyable, the broker holds 'this'
+        AsyncSubscribe& operator=( const AsyncSubscribe& ); ///< Non-copyable, the broker holds 'this'
+
+        Subscription<Data> subscription( const Priority priority = Priority() )
+        { return Subscription<Data>( &AsyncSubscribe::dispatch, static_cast<void*>(this), 0/*nullptr*/, priority.value ); }
+
+        static void dispatch( void* context, const Data& data )
+        {
+            AsyncSubscribe* const subscriber = static_cast<AsyncSubscribe*>(context);
+            if ( subscriber->filter(data) )
+            {
+                subscriber->push( data );
+            }
+            else
+            {
+                subscriber->broker_.onFilterReject();
+            }
+        }
+
+        /** Queue data applying the cOverflow policy when full
+         */
+        void push( const Data& data )
+        { detail::push<cOverflow>( mailbox_, data, dropCount_ ); }
+
+        /** Queue the cached last Data when BrokerTraits<Data>::cCacheLast, unless a publish since registering queued a newer one
+         * @remark Queuing needs no derived state so runs from the base constructor, filter() is not applied
+         */
+        void replay()
+        { broker_.replay( Subscription<Data>( &AsyncSubscribe::dispatchReplay, static_cast<void*>(this) ), broker_.lastVersion() ); }
+
+        static void dispatchReplay( void* context, const Data& data )
+        { static_cast<AsyncSubscribe*>(context)->push( data ); }
+
+    private:
+        bool subscribed_; ///< Subscription is registered in the broker
+        std::atomic<uint32_t> dropCount_; ///< Count of discarded data
+        detail::MailboxRing<Data, cCapacity> mailbox_; ///< Queued data awaiting drain()
+        Broker<Data> broker_; ///< MonoState broker instance to manage publish-subscribe connections
+    };
+
+    /** Conflating subscription holding only the latest published Data for consumers that sample state e.g. pose or configuration
+     * @remark Publishing overwrites a single slot under a sequence lock so its cost is one copy however rarely the consumer reads,
+     *  a batch publish writes only its last element. read() copies the slot from any thread without blocking the publisher and
+     *  retries when a publish overlapped the copy, so never returns a torn value. The slot starts with the cached last value
+     *  when BrokerTraits<Data>::cCacheLast, unless a publish reached the slot first.
+     * @note Concurrent publishes from several threads are serialised on the slot
+     * @tparam  Data  Type that will be received from publishers of corresponding type @note Must be trivially copyable
+     */
+    template< typename Data >
+    class LatestSubscribe
+    {
+    public:
+        /** Registers the subscriber within the broker framework
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        LatestSubscribe(
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscribed_(true)
+        , slot_()
+        , broker_( subscription()
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { seed(); }
+
+        /** Registers the subscriber within the broker framework with a dispatch priority
+         * @param[in] priority  Order in which the slot is updated relative to other subscribers of Data, higher first
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        explicit LatestSubscribe( const Priority priority
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscribed_(true)
+        , slot_()
+        , broker_( subscription( priority )
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { seed(); }
+
+        ~LatestSubscribe()
+        {  unsubscribe(); }
+
+        /** Copy the latest published data
+         * @remark Lock-free and callable from any thread
+         * @param[out] data  Latest data, unchanged when nothing has been published
+         * @return False when nothing has been published since subscribing
+         */
+        bool read( Data& data ) const
+        { return slot_.read( data ); }
+
+        /** @return Count of publishes received, for change detection between read() calls @note Wraps at 2^31
+         */
+        uint32_t version() const
+        { return slot_.version(); }
+
+    protected:
+        /** Remove the subscription ahead of destruction
+         * @remark Call first in the most-derived destructor when publishing from another thread, the base destructor then does nothing
+         */
+        void unsubscribe()
+        {
+            if ( subscribed_ )
+            {
+                broker_.unsubscribe( subscription() );
+                subscribed_ = false;
+            }
+        }
+
+    private:
+        LatestSubscribe( const LatestSubscribe& ); ///< Non-copyable, the broker holds 'this'
+        LatestSubscribe& operator=( const LatestSubscribe& ); ///< Non-copyable, the broker holds 'this'
+
+        Subscription<Data> subscription( const Priority priority = Priority() )
+        { return Subscription<Data>( &LatestSubscribe::dispatch, static_cast<void*>(this), &LatestSubscribe::dispatchBatch, priority.value ); }
+
+        static void dispatch( void* context, const Data& data )
+        { static_cast<LatestSubscribe*>(context)->slot_.write( data ); }
+
+        static void dispatchBatch( void* context, const Data* data, const size_t count )
+        { static_cast<LatestSubscribe*>(context)->slot_.write( data[count - 1U] ); } //< @note Broker does not deliver empty batches
+
+        /** Start the slot with the cached last value once subscribed
+         * @remark Replayed after registering so no publish is missed, the cached value only fills a slot no publish has written
+         *  as it may be older than one delivered meanwhile
+         */
+        void seed()
+        { broker_.replay( Subscription<Data>( &LatestSubscribe::dispatchSeed, static_cast<void*>(this) ) ); }
+
+        static void dispatchSeed( void* context, const Data& data )
+        { static_cast<LatestSubscribe*>(context)->slot_.seed( data ); }
+
+    private:
+        bool subscribed_; ///< Subscription is registered in the broker
+        alignas(64) detail::SeqLockSlot<Data> slot_; ///< Latest data
+        Broker<Data> broker_; ///< MonoState broker instance to manage publish-subscribe connections
+    };
+
+    template< typename Data >
+    class DeferredSubscribe;
+
+    namespace detail
+    {
+        /** Subscribers of a DeferredDelivery worker in priority order
+         * @tparam Data  Delivered data type
+         */
+        template< typename Data >
+        class DeferredSubscriptions
+        {
+        protected:
+            DeferredSubscriptions()
+                : subscriptions_()
+            {}
+
+            /** Deliver data to each deferred subscriber
+             */
+            void deliver( const Data& data )
+            {
+                const typename Table::Reader subscriptions( subscriptions_ );
+                for ( const Subscription<Data>* iSubscription = subscriptions.begin(); iSubscription != subscriptions.end(); ++iSubscription )
+                {
+                    iSubscription->receive( iSubscription->context, data );
+                }
+            }
+
+        private:
+            friend class DeferredSubscribe<Data>;
+            typedef ConcurrentSubscriptionTable< Subscription<Data> > Table;
+
+            Table subscriptions_; ///< Subscribed from any thread, read lock-free by the worker
+        };
+    } // END: detail
+
+    /** Worker thread delivering Data to DeferredSubscribe<Data> subscribers once all direct subscribers have received it
+     * @remark Split delivery: latency-critical handlers subscribe to the broker directly e.g. with Priority::cCritical and
+     *  others subscribe as DeferredSubscribe<Data> of a DeferredDelivery<Data>. The DeferredDelivery subscribes at
+     *  Priority::cDeferred so each publish runs the direct subscribers first then makes a single copy of the Data into the
+     *  worker mailbox. The worker thread delivers queued data to the deferred subscribers in priority order.
+     *  With BrokerTraits<Data>::cConcurrent the mailbox accepts publishes from several threads at once.
+     * @note A deferred subscriber publishing Data from the worker never waits on the full mailbox only the worker drains,
+     *  Overflow::Block discards that data as Overflow::DropNewest
+     * @warning Without cConcurrent the mailbox has a single producer, publishes of Data, including from deferred subscribers,
+     *  must not happen from more than one thread at a time
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     * @tparam  cCapacity  Mailbox slot count @note Must be a power of two
+     * @tparam  cOverflow  Behaviour when publishing into a full mailbox
+     */
+    template< typename Data, uint32_t cCapacity = 256U, Overflow cOverflow = Overflow::Block >
+    class DeferredDelivery : public detail::DeferredSubscriptions<Data>
+    {
+    public:
+        /** Registers with the broker framework and starts the worker thread
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        DeferredDelivery(
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : dropCount_(0U)
+        , running_(true)
+        , sleeping_(false)
+        , mailbox_()
+        , mutex_()
+        , wake_()
+        , broker_( subscription()
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        , worker_( &DeferredDelivery::run, this )
+        {}
+
+        /** Unsubscribes then stops the worker, data still queued is not delivered
+         */
+        ~DeferredDelivery()
+        {
+            broker_.unsubscribe( subscription() );
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                running_.store( false, std::memory_order_relaxed );
+            }
+            wake_.notify_one();
+            worker_.join();
+        }
+
+        /** @return Count of published data discarded due to Overflow::DropOldest, Overflow::DropNewest or a re-entrant publish
+         */
+        uint32_t dropCount() const
+        { return dropCount_.load(std::memory_order_relaxed); }
+
+    private:
+        DeferredDelivery( const DeferredDelivery& ); ///< Non-copyable, the broker holds 'this'
+        DeferredDelivery& operator=( const DeferredDelivery& ); ///< Non-copyable, the broker holds 'this'
+
+        Subscription<Data> subscription()
+        { return Subscription<Data>( &DeferredDelivery::dispatch, static_cast<void*>(this), 0/*nullptr*/, Priority::cDeferred ); }
+
+        /** Queue data and wake the worker if it is waiting
+         */
+        static void dispatch( void* context, const Data& data )
+        {
+            DeferredDelivery* const delivery = static_cast<DeferredDelivery*>(context);
+            if ( (cOverflow == Overflow::Block) && (worker() == delivery) )
+                detail::push<Overflow::DropNewest, cShared>( delivery->mailbox_, data, delivery->dropCount_ ); //< Re-entrant publish, blocking would wait on itself
+            else
+                detail::push<cOverflow, cShared>( delivery->mailbox_, data, delivery->dropCount_ );
+
+            std::atomic_thread_fence( std::memory_order_seq_cst ); //< Pairs with run(), either the worker sees the data or we see it sleeping
+            if ( delivery->sleeping_.load(std::memory_order_relaxed) )
+            {
+                std::lock_guard<std::mutex> lock( delivery->mutex_ );
+                delivery->wake_.notify_one();
+            }
+        }
+
+        /** Worker thread delivering queued data until destruction
+         */
+        void run()
+        {
+            worker() = this;
+            Data data;
+            while ( running_.load(std::memory_order_relaxed) )
+            {
+                if ( mailbox_.tryPop(data) )
+                {
+                    this->deliver( data );
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock( mutex_ );
+                sleeping_.store( true, std::memory_order_relaxed );
+                std::atomic_thread_fence( std::memory_order_seq_cst );
+                while ( mailbox_.empty() && running_.load(std::memory_order_relaxed) )
+                {
+                    wake_.wait( lock );
+                }
+                sleeping_.store( false, std::memory_order_relaxed );
+            }
+        }
+
+        /** @return DeferredDelivery whose worker is the calling thread, nullptr on other threads
+         */
+        static DeferredDelivery*& worker()
+        {
+            static thread_local DeferredDelivery* delivery = 0/*nullptr*/;
+            return delivery;
+        }
+
+    private:
+        static const bool cShared = BrokerTraits<Data>::cConcurrent; ///< Publishers may push from several threads at once
+
+        std::atomic<uint32_t> dropCount_; ///< Count of discarded data
+        std::atomic<bool> running_; ///< Worker runs until cleared by the destructor
+        std::atomic<bool> sleeping_; ///< Worker waits on wake_ for data
+        detail::MailboxRing<Data, cCapacity> mailbox_; ///< Queued data awaiting delivery
+        std::mutex mutex_; ///< Guards wake_ waits
+        std::condition_variable wake_; ///< Signalled when data is queued to a sleeping worker
+        Broker<Data> broker_; ///< MonoState broker instance to manage publish-subscribe connections
+        std::thread worker_; ///< Delivers to the deferred subscribers @note Declared last so starts once all other members are constructed
+    };
+
+    /** Subscription receiving Data on a DeferredDelivery worker thread
+     * @remark Receives after all direct subscribers of the broker, in priority order among the deferred subscribers of the worker
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     */
+    template< typename Data >
+    class DeferredSubscribe
+    {
+    public:
+        /** Registers the subscriber with a worker
+         * @param[in] delivery  Worker delivering the Data @note Must outlive the subscriber
+         * @param[in] priority  Delivery order among the deferred subscribers of 'delivery', higher first
+         */
+        explicit DeferredSubscribe( detail::DeferredSubscriptions<Data>& delivery, const Priority priority = Priority() )
+            : subscribed_(true)
+            , delivery_(delivery)
+        {
+            delivery_.subscriptions_.insert( subscription(priority) );
+        }
+
+        virtual ~DeferredSubscribe()
+        {  unsubscribe(); }
+
+        /** Receive published Data
+         * @remark Called on the DeferredDelivery worker thread
+         */
+        virtual void receive( const Data& data ) = 0;
+
+        /** Select data to be received
+         * @remark Called on the DeferredDelivery worker thread
+         */
+        virtual bool filter( const Data& /*data*/ )
+        {  return true; }
+
+    protected:
+        /** Remove the subscription ahead of destruction
+         * @remark Call first in the most-derived destructor, the worker may otherwise deliver to a partially destroyed subscriber
+         */
+        void unsubscribe()
+        {
+            if ( subscribed_ )
+            {
+                delivery_.subscriptions_.remove( subscription() );
+                subscribed_ = false;
+            }
+        }
+
+    private:
+        DeferredSubscribe( const DeferredSubscribe& ); ///< Non-copyable, the worker holds 'this'
+        DeferredSubscribe& operator=( const DeferredSubscribe& ); ///< Non-copyable, the worker holds 'this'
+
+        Subscription<Data> subscription( const Priority priority = Priority() )
+        { return Subscription<Data>( &DeferredSubscribe::dispatch, static_cast<void*>(this), 0/*nullptr*/, priority.value ); }
+
+        static void dispatch( void* context, const Data& data )
+        {
+            DeferredSubscribe* const subscriber = static_cast<DeferredSubscribe*>(context);
+            if ( subscriber->filter(data) )
+            {
+                subscriber->receive(data);
+            }
+            else
+            {
+                detail::Stats<Data>::onFilterReject( detail::ChannelBinding<Data, void>::state() ); //< @note Delivered from the default channel
+            }
+        }
+
+    private:
+        bool subscribed_; ///< Subscription is registered with the worker
+        detail::DeferredSubscriptions<Data>& delivery_; ///< Worker delivering to this subscriber
+    };
+
+    /** Worker of a ParallelExecutor that a ParallelSubscribe receives on
+     * @remark Subscribers with an affinity always receive on the same worker thread e.g. for handlers with thread-local state
+     *  or that are not thread-safe. Without an affinity any worker, or the publishing thread, may run the handler.
+     */
+    struct Affinity
+    {
+        static const int32_t cAnyWorker = -1; ///< Receive on whichever thread takes the task
+
+        explicit Affinity( const int32_t affinityWorker = cAnyWorker )
+            : worker(affinityWorker)
+        {}
+
+        int32_t worker; ///< Worker index, taken modulo the worker count, or cAnyWorker
+    };
+
+    template< typename Data >
+    class ParallelSubscribe;
+
+    namespace detail
+    {
+        /** Delivery of published data to one subscription, run on a ParallelExecutor worker
+         */
+        struct ParallelTask
+        {
+            /** Function invoked by the worker
+             * @param entry  ParallelTask::entry
+             * @param data  First of 'count' published data
+             * @param count  Count of published data
+             */
+            typedef void (*Run)( const void* entry, const void* data, size_t count );
+
+            Run run; ///< Delivers data to entry
+            const void* entry; ///< Subscription receiving the data
+            const void* data; ///< Published data, valid until pending reaches zero
+            size_t count; ///< Count of published data
+            std::atomic<uint32_t>* pending; ///< Decremented once run, the publisher waits for zero
+        };
+
+        /** Worker threads taking tasks from their own queues first then stealing from the queues of other workers
+         * @remark Each worker has a pinned queue only it runs, for subscribers with an Affinity, and a shared queue that idle
+         *  workers and waiting publishers steal from. Publishers spread unpinned tasks round-robin then help run them while
+         *  waiting, so a publish takes about as long as its slowest handler rather than the sum of them all.
+         */
+        class WorkStealingPool
+        {
+        public:
+            static const uint32_t cQueueCapacity = 256U; ///< Tasks per queue before a submit runs an unpinned task inline or waits for a pinned queue
+            static const uint32_t cSpinCount = 64U; ///< Empty polls before an idle worker sleeps
+
+            /** @return Count of worker threads
+             */
+            uint32_t workerCount() const
+            { return workerCount_; }
+
+            /** Queue a task
+             * @remark An unpinned task runs on the calling thread when its queue is full. A pinned task must run on its worker so
+             *  the calling thread instead runs other tasks it may take until the pinned queue has room.
+             * @param task  Task to run
+             * @param affinity  Worker that must run the task, or Affinity::cAnyWorker
+             */
+            void submit( const ParallelTask& task, const int32_t affinity )
+            {
+                if ( affinity == Affinity::cAnyWorker )
+                {
+                    Worker& worker = workers_[ nextWorker_.fetch_add( 1U, std::memory_order_relaxed ) % workerCount_ ];
+                    if ( !worker.shared.tryPushShared( task ) )
+                        execute( task );
+                    return;
+                }
+
+                Worker& worker = workers_[ static_cast<uint32_t>(affinity) % workerCount_ ];
+                Worker* const own = currentWorker();
+                while ( !worker.pinned.tryPushShared( task ) )
+                {
+                    notify(); //< The pinned worker may be sleeping on tasks submitted earlier in this publish
+                    if ( !tryRun( ownedBy(own) ? own : 0/*nullptr*/ ) )
+                        std::this_thread::yield();
+                }
+            }
+
+            /** Wake sleeping workers once a publish has submitted its tasks
+             */
+            void notify()
+            {
+                std::atomic_thread_fence( std::memory_order_seq_cst ); //< Pairs with run(), either the worker sees the tasks or we see it sleeping
+                if ( sleepers_.load(std::memory_order_relaxed) != 0U )
+                {
+                    std::lock_guard<std::mutex> lock( mutex_ );
+                    wake_.notify_all();
+                }
+            }
+
+            /** Run queued tasks on the calling thread until 'pending' reaches zero
+             * @remark A worker thread also runs its pinned tasks so a handler publishing on the pool does not deadlock
+             */
+            void wait( const std::atomic<uint32_t>& pending )
+            {
+                Worker* const own = currentWorker();
+                while ( pending.load(std::memory_order_acquire) != 0U )
+                {
+                    if ( !tryRun( ownedBy(own) ? own : 0/*nullptr*/ ) )
+                        std::this_thread::yield();
+                }
+            }
+
+        protected:
+            /** Task queues of a worker thread
+             */
+            struct Worker
+            {
+                MailboxRing<ParallelTask, cQueueCapacity> pinned; ///< Tasks only this worker runs
+                MailboxRing<ParallelTask, cQueueCapacity> shared; ///< Tasks any thread may steal
+            };
+
+            /** @param workers  Queues of 'workerCount' workers, owned by the derived executor
+             */
+            WorkStealingPool( Worker* const workers, const uint32_t workerCount )
+                : workers_(workers)
+                , workerCount_(workerCount)
+                , nextWorker_(0U)
+                , sleepers_(0U)
+                , running_(true)
+                , mutex_()
+                , wake_()
+            {}
+
+            /** Worker thread running tasks until stop()
+             */
+            void run( const uint32_t index )
+            {
+                Worker* const own = &workers_[index];
+                currentWorker() = own;
+                uint32_t idleCount = 0U;
+                while ( running_.load(std::memory_order_relaxed) )
+                {
+                    if ( tryRun( own ) )
+                    {
+                        idleCount = 0U;
+                        continue;
+                    }
+
+                    if ( ++idleCount < cSpinCount )
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> lock( mutex_ );
+                    sleepers_.fetch_add( 1U, std::memory_order_relaxed );
+                    std::atomic_thread_fence( std::memory_order_seq_cst );
+                    while ( idle( *own ) && running_.load(std::memory_order_relaxed) )
+                    {
+                        wake_.wait( lock );
+                    }
+                    sleepers_.fetch_sub( 1U, std::memory_order_relaxed );
+                    idleCount = 0U;
+                }
+            }
+
+            /** Signal the workers to return from run()
+             */
+            void stop()
+            {
+                {
+                    std::lock_guard<std::mutex> lock( mutex_ );
+                    running_.store( false, std::memory_order_relaxed );
+                }
+                wake_.notify_all();
+            }
+
+        private:
+            /** Run one task, own queues first then stealing from the shared queues of the other workers
+             * @param own  Worker of the calling thread, or nullptr from a publishing thread which may not run pinned tasks
+             * @return False if no task was available
+             */
+            bool tryRun( Worker* const own )
+            {
+                ParallelTask task;
+                if ( own && (own->pinned.tryPop(task) || own->shared.tryPop(task)) )
+                {
+                    execute( task );
+                    return true;
+                }
+
+                const uint32_t first = own ? static_cast<uint32_t>(own - workers_) + 1U : 0U;
+                for ( uint32_t iWorker = 0U; iWorker < workerCount_; ++iWorker )
+                {
+                    Worker& victim = workers_[ (first + iWorker) % workerCount_ ];
+                    if ( (&victim != own) && victim.shared.tryPop(task) )
+                    {
+                        execute( task );
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /** @return True when no task is queued for 'own' to run @note Approximate while tasks are submitted
+             */
+            bool idle( const Worker& own ) const
+            {
+                if ( !own.pinned.empty() )
+                    return false;
+                for ( uint32_t iWorker = 0U; iWorker < workerCount_; ++iWorker )
+                {
+                    if ( !workers_[iWorker].shared.empty() )
+                        return false;
+                }
+                return true;
+            }
+
+            /** @return True if 'worker' is a worker of this pool
+             */
+            bool ownedBy( const Worker* const worker ) const
+            { return (worker >= workers_) && (worker < (workers_ + workerCount_)); }
+
+            static void execute( const ParallelTask& task )
+            {
+                task.run( task.entry, task.data, task.count );
+                task.pending->fetch_sub( 1U, std::memory_order_release );
+            }
+
+            /** @return Worker run by the calling thread in any pool, or nullptr
+             */
+            static Worker*& currentWorker()
+            {
+                static thread_local Worker* worker = 0/*nullptr*/;
+                return worker;
+            }
+
+        private:
+            Worker* const workers_; ///< Queues of each worker
+            const uint32_t workerCount_; ///< Count of workers
+            std::atomic<uint32_t> nextWorker_; ///< Round-robin target of the next unpinned task
+            std::atomic<uint32_t> sleepers_; ///< Count of workers waiting on wake_
+            std::atomic<bool> running_; ///< Workers run until cleared by stop()
+            std::mutex mutex_; ///< Guards wake_ waits
+            std::condition_variable wake_; ///< Signalled when tasks are submitted to sleeping workers
+        };
+
+        /** Entry of the subscription table of a ParallelDelivery
+         */
+        template< typename Data >
+        struct ParallelSubscription : Subscription<Data>
+        {
+            ParallelSubscription()
+                : Subscription<Data>()
+                , affinity(Affinity::cAnyWorker)
+            {}
+
+            ParallelSubscription( const Subscription<Data>& subscription, const Affinity subscriptionAffinity )
+                : Subscription<Data>(subscription)
+                , affinity(subscriptionAffinity.worker)
+            {}
+
+            int32_t affinity; ///< Worker that receives, or Affinity::cAnyWorker
+        };
+
+        /** Subscribers of a ParallelDelivery in priority order
+         * @tparam Data  Delivered data type
+         */
+        template< typename Data >
+        class ParallelSubscriptions
+        {
+        protected:
+            ParallelSubscriptions()
+                : subscriptions_()
+            {}
+
+            /** Deliver data to each subscriber on the pool and wait until all have received
+             */
+            void deliver( WorkStealingPool& pool, const Data* const data, const size_t count )
+            {
+                const typename Table::Reader subscriptions( subscriptions_ );
+                std::atomic<uint32_t> pending( static_cast<uint32_t>(subscriptions.end() - subscriptions.begin()) );
+                for ( const ParallelSubscription<Data>* iSubscription = subscriptions.begin(); iSubscription != subscriptions.end(); ++iSubscription )
+                {
+                    const ParallelTask task = { &ParallelSubscriptions::run, iSubscription, data, count, &pending };
+                    pool.submit( task, iSubscription->affinity );
+                }
+                pool.notify();
+                pool.wait( pending ); //< @note The reader keeps the entries valid until every task has run
+            }
+
+        private:
+            friend class ParallelSubscribe<Data>;
+            typedef ConcurrentSubscriptionTable< ParallelSubscription<Data> > Table;
+
+            static void run( const void* const entry, const void* const data, const size_t count )
+            {
+                const ParallelSubscription<Data>& subscription = *static_cast<const ParallelSubscription<Data>*>(entry);
+                const Data* const first = static_cast<const Data*>(data);
+                for ( const Data* iData = first; iData != (first + count); ++iData )
+                {
+                    subscription.receive( subscription.context, *iData );
+                }
+            }
+
+            Table subscriptions_; ///< Subscribed from any thread, read lock-free by the publisher
+        };
+    } // END: detail
+
+    /** Pool of worker threads delivering to ParallelSubscribe subscribers of any Data type
+     * @remark Workers take tasks from their own queues then steal from the others, see detail::WorkStealingPool.
+     *  Idle workers spin briefly then sleep until a publish submits tasks.
+     * @warning Destroy every ParallelDelivery using the executor first
+     * @warning Task queues are cache line aligned, which operator new does not honour before C++17. Hold the executor in
+     *  static or automatic storage, or a member of such an object, rather than allocating it with new.
+     * @tparam  cWorkers  Count of worker threads
+     */
+    template< uint32_t cWorkers = 4U >
+    class ParallelExecutor : public detail::WorkStealingPool
+    {
+        static_assert( cWorkers > 0U, "ParallelExecutor requires a worker" );
+
+    public:
+        /** Starts the worker threads
+         */
+        ParallelExecutor()
+            : detail::WorkStealingPool( workers_, cWorkers )
+            , workers_()
+            , threads_()
+        {
+            for ( uint32_t iWorker = 0U; iWorker < cWorkers; ++iWorker )
+            {
+                threads_[iWorker] = std::thread( &ParallelExecutor::run, this, iWorker );
+            }
+        }
+
+        /** Stops the worker threads, tasks still queued are not run
+         */
+        ~ParallelExecutor()
+        {
+            stop();
+            for ( uint32_t iWorker = 0U; iWorker < cWorkers; ++iWorker )
+            {
+                threads_[iWorker].join();
+            }
+        }
+
+    private:
+        ParallelExecutor( const ParallelExecutor& ); ///< Non-copyable, the workers hold 'this'
+        ParallelExecutor& operator=( const ParallelExecutor& ); ///< Non-copyable, the workers hold 'this'
+
+    private:
+        Worker workers_[cWorkers]; ///< Task queues of each worker
+        std::thread threads_[cWorkers]; ///< Worker threads
+    };
+
+    /** Fan-out of each publish of Data across the workers of a ParallelExecutor
+     * @remark Broker<Data>::publish calls receive() of every subscriber in turn so publish latency is the sum of the handler
+     *  costs. Heavyweight handlers instead subscribe as ParallelSubscribe<Data> of a ParallelDelivery<Data> which submits one
+     *  task per subscriber and returns once all have received, so publish latency is about that of the slowest handler.
+     *  The publishing thread runs tasks itself while waiting. Data is not copied, subscribers receive the published reference.
+     * @note Subscribers of a delivery run concurrently with each other, a batch publish is one task per subscriber
+     * @warning A thread waiting for a publish runs other queued tasks, a subscriber must not hold a lock while publishing
+     *  that another subscriber of the executor takes
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     */
+    template< typename Data >
+    class ParallelDelivery : public detail::ParallelSubscriptions<Data>
+    {
+    public:
+        /** Registers with the broker framework
+         * @param[in] executor  Workers delivering the Data @note Must outlive the delivery
+         * @param[in] priority  Order in which the parallel subscribers receive relative to other subscribers of Data, higher first
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        explicit ParallelDelivery( detail::WorkStealingPool& executor, const Priority priority = Priority()
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : executor_(executor)
+        , broker_( subscription( priority )
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        {}
+
+        ~ParallelDelivery()
+        { broker_.unsubscribe( subscription() ); }
+
+    private:
+        ParallelDelivery( const ParallelDelivery& ); ///< Non-copyable, the broker holds 'this'
+        ParallelDelivery& operator=( const ParallelDelivery& ); ///< Non-copyable, the broker holds 'this'
+
+        Subscription<Data> subscription( const Priority priority = Priority() )
+        { return Subscription<Data>( &ParallelDelivery::dispatch, static_cast<void*>(this), &ParallelDelivery::dispatchBatch, priority.value ); }
+
+        static void dispatch( void* context, const Data& data )
+        {
+            ParallelDelivery* const delivery = static_cast<ParallelDelivery*>(context);
+            delivery->deliver( delivery->executor_, &data, 1U );
+        }
+
+        static void dispatchBatch( void* context, const Data* data, size_t count )
+        {
+            ParallelDelivery* const delivery = static_cast<ParallelDelivery*>(context);
+            delivery->deliver( delivery->executor_, data, count );
+        }
+
+    private:
+        detail::WorkStealingPool& executor_; ///< Workers running the deliveries
+        Broker<Data> broker_; ///< MonoState broker instance to manage publish-subscribe connections
+    };
+
+    /** Subscription receiving Data on a ParallelExecutor worker concurrently with the other subscribers of its ParallelDelivery
+     * @remark receive() runs on a worker thread, or the publishing thread when unpinned, and completes before publish returns
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     */
+    template< typename Data >
+    class ParallelSubscribe
+    {
+    public:
+        /** Registers the subscriber with a delivery
+         * @param[in] delivery  Fan-out delivering the Data @note Must outlive the subscriber
+         * @param[in] affinity  Worker that runs receive(), by default any thread
+         * @param[in] priority  Order in which tasks are submitted among the subscribers of 'delivery', higher first
+         */
+        explicit ParallelSubscribe( detail::ParallelSubscriptions<Data>& delivery, const Affinity affinity = Affinity(), const Priority priority = Priority() )
+            : subscribed_(true)
+            , delivery_(delivery)
+        {
+            delivery_.subscriptions_.insert( detail::ParallelSubscription<Data>( subscription(priority), affinity ) );
+        }
+
+        virtual ~ParallelSubscribe()
+        {  unsubscribe(); }
+
+        /** Receive published Data
+         * @remark Called on a worker thread, concurrently with other subscribers of the delivery
+         */
+        virtual void receive( const Data& data ) = 0;
+
+        /** Select data to be received
+         * @remark Called on the thread that calls receive()
+         */
+        virtual bool filter( const Data& /*data*/ )
+        {  return true; }
+
+    protected:
+        /** Remove the subscription ahead of destruction
+         * @remark Call first in the most-derived destructor, a publish may otherwise deliver to a partially destroyed subscriber
+         */
+        void unsubscribe()
+        {
+            if ( subscribed_ )
+            {
+                delivery_.subscriptions_.remove( detail::ParallelSubscription<Data>( subscription(), Affinity() ) );
+                subscribed_ = false;
+            }
+        }
+
+    private:
+        ParallelSubscribe( const ParallelSubscribe& ); ///< Non-copyable, the delivery holds 'this'
+        ParallelSubscribe& operator=( const ParallelSubscribe& ); ///< Non-copyable, the delivery holds 'this'
+
+        Subscription<Data> subscription( const Priority priority = Priority() )
+        { return Subscription<Data>( &ParallelSubscribe::dispatch, static_cast<void*>(this), 0/*nullptr*/, priority.value ); }
+
+        static void dispatch( void* context, const Data& data )
+        {
+            ParallelSubscribe* const subscriber = static_cast<ParallelSubscribe*>(context);
+            if ( subscriber->filter(data) )
+            {
+                subscriber->receive(data);
+            }
+            else
+            {
+                detail::Stats<Data>::onFilterReject( detail::ChannelBinding<Data, void>::state() ); //< @note Delivered from the default channel
+            }
+        }
+
+    private:
+        bool subscribed_; ///< Subscription is registered with the delivery
+        detail::ParallelSubscriptions<Data>& delivery_; ///< Fan-out delivering to this subscriber
+    };
+
+} // END: sub0
+
+#endif
@@ -0,0 +1,270 @@
+/** Sub0Pub zero-copy loaned message extensions
+ * @remark Publishers write Data in-place into a broker-owned slot which subscribers share by reference count
+ *
+ *  This file is part of Sub0Pub. Original project source available at https://github.com/Crog/Sub0Pub/blob/master/sub0pub.hpp
+ *
+ *  MIT License
+ *
+ * Copyright (c) 2018 Craig Hutchinson <craig-sub0pub@crog.uk>
+ *
+ *  See sub0pub.hpp for full license text.
+ */
+#ifndef CROG_SUB0PUB_LOAN_HPP
+#define CROG_SUB0PUB_LOAN_HPP
+
+#include "sub0pub.hpp"
+#include "pool.hpp"
+
+#include <atomic> //< std::atomic
+#include <utility> //< std::move
+
+/** Sub0Pub top-level namespace
+*/
+namespace sub0
+{
+    template< typename Data >
+    class Loan;
+
+    template< typename Data >
+    class SharedLoan;
+
+    namespace detail
+    {
+        /** Pool block holding loaned Data and its reference count
+         * @note Data is default constructed for each loan. Pool blocks are cache-line aligned so reference counting by one
+         *  thread does not contend with the writer of a neighbouring slot.
+         */
+        template< typename Data >
+        struct LoanSlot
+        {
+            /** Pool of loan slots per Data type, capacity set by BrokerTraits<Data>::cMaxLoans
+             */
+            typedef Pool< LoanSlot, BrokerTraits<Data>::cMaxLoans > Pool_t;
+
+            LoanSlot() : references(1U) {} //< @note Data is default initialised, trivial Data is not cleared
+
+            /** @return Slot with the single reference of a new loan or nullptr when all slots are loaned
+             */
+            static LoanSlot* create()
+            { return Pool_t::instance().create(); }
+
+            void acquire()
+            { references.fetch_add( 1U, std::memory_order_relaxed ); }
+
+            void release()
+            {
+                if ( references.fetch_sub( 1U, std::memory_order_acq_rel ) == 1U )
+                    Pool_t::instance().destroy( this ); //< @note Last reference, the slot is destroyed
+            }
+
+            std::atomic<uint32_t> references; ///< Count of Loan/SharedLoan handles
+            Data data; ///< Loaned payload
+        };
+    } // END: detail
+
+    /** Writable handle to a pool slot loaned to a publisher
+     * @remark Obtained from LoanPublish<Data>::loan(), filled in place and then passed to LoanPublish<Data>::publish() which
+     *  shares the slot with subscribers. Dropping an unpublished loan returns the slot to the pool.
+     * @tparam Data  Loaned data type
+     */
+    template< typename Data >
+    class Loan
+    {
+    public:
+        Loan()
+            : slot_(nullptr)
+        {}
+
+        explicit Loan( detail::LoanSlot<Data>* const slot )
+            : slot_(slot)
+        {}
+
+        Loan( Loan&& other )
+            : slot_(other.slot_)
+        { other.slot_ = nullptr; }
+
+        Loan& operator=( Loan&& other )
+        {
+            if ( this != &other )
+            {
+                reset();
+                slot_ = other.slot_;
+                other.slot_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~Loan()
+        { reset(); }
+
+        /** Return the slot to the pool without publishing
+         */
+        void reset()
+        {
+            if ( slot_ )
+            {
+                slot_->release();
+                slot_ = nullptr;
+            }
+        }
+
+        /** @return True when a slot is held, false when the pool was exhausted
+         */
+        explicit operator bool() const
+        { return slot_ != nullptr; }
+
+        Data& operator*() const
+        { return slot_->data; }
+
+        Data* operator->() const
+        { return &slot_->data; }
+
+    private:
+        Loan( const Loan& ); ///< Non-copyable, a loan has a single writer
+        Loan& operator=( const Loan& ); ///< Non-copyable, a loan has a single writer
+
+        friend class SharedLoan<Data>;
+
+    private:
+        detail::LoanSlot<Data>* slot_; ///< Loaned slot or nullptr
+    };
+
+    /** Read-only reference counted handle to a published loan slot
+     * @remark Received by Subscribe< SharedLoan<Data> > subscribers, copying the handle retains the slot beyond receive()
+     * @tparam Data  Loaned data type
+     */
+    template< typename Data >
+    class SharedLoan
+    {
+    public:
+        SharedLoan()
+            : slot_(nullptr)
+        {}
+
+        /** Take over the reference of a filled loan
+         */
+        explicit SharedLoan( Loan<Data>&& loan )
+            : slot_(loan.slot_)
+        { loan.slot_ = nullptr; }
+
+        SharedLoan( const SharedLoan& other )
+            : slot_(other.slot_)
+        {
+            if ( slot_ )
+                slot_->acquire();
+        }
+
+        SharedLoan& operator=( const SharedLoan& other )
+        {
+            SharedLoan copy( other );
+            std::swap( slot_, copy.slot_ );
+            return *this;
+        }
+
+        ~SharedLoan()
+        { reset(); }
+
+        /** Release this reference to the slot
+         */
+        void reset()
+        {
+            if ( slot_ )
+            {
+                slot_->release();
+                slot_ = nullptr;
+            }
+        }
+
+        explicit operator bool() const
+        { return slot_ != nullptr; }
+
+        const Data& operator*() const
+        { return slot_->data; }
+
+        const Data* operator->() const
+        { return &slot_->data; }
+
+    private:
+        detail::LoanSlot<Data>* slot_; ///< Shared slot or nullptr
+    };
+
+    /** Subscription receiving reference counted handles to loaned Data
+     * @tparam Data  Loaned data type
+     */
+    template< typename Data >
+    using LoanSubscribe = Subscribe< SharedLoan<Data> >;
+
+    /** Publisher of Data written in place into broker-owned pool slots
+     * @remark Publishing a loan delivers a SharedLoan<Data> handle to Subscribe< SharedLoan<Data> > subscribers and a reference
+     *  to the slot Data to Subscribe<Data> subscribers, no copy of the Data is made on either path.
+     * @tparam Data  Loaned data type, pool size set by BrokerTraits<Data>::cMaxLoans
+     */
+    template< typename Data >
+    class LoanPublish : public Publish<Data>
+                      , public Publish< SharedLoan<Data> >
+    {
+    public:
+        /** Registers the publisher within the broker framework
+         * @param[in] typeName Optional unique data name given to data for inter-process signaling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        LoanPublish(
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+            : Publish<Data>(
+#if SUB0PUB_TYPEIDNAME
+                typeId, typeName
+#endif
+              )
+            , Publish< SharedLoan<Data> >()
+        {}
+
+        /** Borrow a slot from the pool to write Data into
+         * @note Data is default constructed, trivial Data holds stale content and must be fully written before publish
+         * @return Loan of a slot, false when all slots are held by loans or subscribers
+         */
+        Loan<Data> loan() const
+        { return Loan<Data>( detail::LoanSlot<Data>::create() ); }
+
+        /** @return Usage counters of the loan pool of Data, failures count loan() calls that found every slot held
+         */
+        static AllocationCounters poolCounters()
+        { return detail::LoanSlot<Data>::Pool_t::instance().counters(); }
+
+        /** Commit a filled loan and publish it to subscribers
+         * @param[in] loan  Loan from loan(), released to the pool once no subscriber retains it
+         */
+        void publish( Loan<Data>&& loan ) const
+        {
+            assert( loan );
+            const SharedLoan<Data> shared( std::move(loan) );
+            Publish< SharedLoan<Data> >::publish( shared );
+            Publish<Data>::publish( *shared );
+        }
+    };
+
+    /** Publish loan, used when inheriting from multiple publisher base types
+     * @see publish(From&,const Data&)
+     * @param[in] from  Producer object inheriting from one or more LoanPublish<> objects
+     * @param[in] loan  Filled loan published using the base LoanPublish<Data> object of From
+     */
+    template<typename From, typename Data>
+    inline void publish( From& from, Loan<Data>&& loan )
+    {
+        const LoanPublish<Data>& publisher = from;
+        publisher.publish( std::move(loan) );
+    }
+
+    /** @see publish(From&,Loan<Data>&&)
+    */
+    template<typename From, typename Data>
+    inline void publish( From* const from, Loan<Data>&& loan )
+    {
+        assert(from != nullptr);
+        publish( *from, std::move(loan) );
+    }
+
+} // END: sub0
+
+#endif
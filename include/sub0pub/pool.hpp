@@ -0,0 +1,350 @@
+/** Sub0Pub message memory pools and arenas
+ * @remark Fixed-capacity storage for queued and buffered Data so delivery never calls the heap once warm. Pool<Data> holds
+ *  cache-line aligned blocks of one Data type shared by all threads, ThreadArena is a per-thread bump allocator reset by its
+ *  owner e.g. once per processing cycle. Both keep AllocationCounters, a failure is counted and returned as nullptr rather
+ *  than falling back to the heap.
+ *
+ *  This file is part of Sub0Pub. Original project source available at https://github.com/Crog/Sub0Pub/blob/master/sub0pub.hpp
+ *
+ *  MIT License
+ *
+ * Copyright (c) 2018 Craig Hutchinson <craig-sub0pub@crog.uk>
+ *
+ *  See sub0pub.hpp for full license text.
+ */
+#ifndef CROG_SUB0PUB_POOL_HPP
+#define CROG_SUB0PUB_POOL_HPP
+
+#include "sub0pub.hpp"
+
+#include <atomic> //< std::atomic
+#include <cstddef> //< std::max_align_t
+#include <new> //< placement new
+#include <utility> //< std::forward, std::move
+
+/** Sub0Pub top-level namespace
+*/
+namespace sub0
+{
+    /** Usage counters of a Pool<Data>, the LoanPublish<Data> pool or ThreadArena
+     */
+    struct AllocationCounters
+    {
+        uint64_t allocations; ///< Successful allocations
+        uint64_t releases; ///< Allocations returned, for ThreadArena the allocations dropped by reset()
+        uint64_t failures; ///< Allocations refused as the capacity was exhausted
+        uint64_t highWater; ///< Greatest count in use at once, blocks for pools and bytes for ThreadArena
+        uint64_t capacity; ///< Count available, blocks for pools and bytes for ThreadArena
+    };
+
+    /** Fixed pool of cache-line aligned blocks per Data type
+     * @remark Blocks are held in static storage and linked into a lock-free free list on first use of instance(), so neither
+     *  warm-up nor allocation call the heap. Also backs the LoanPublish<Data> slots with cBlocks of BrokerTraits<Data>::cMaxLoans.
+     * @tparam Data  Data type allocated from the pool
+     * @tparam cBlocks  Count of blocks, by default BrokerTraits<Data>::cMaxPooled
+     */
+    template< typename Data, uint32_t cBlocks = BrokerTraits<Data>::cMaxPooled >
+    class Pool
+    {
+    public:
+        static const uint32_t cCapacity = cBlocks; ///< Count of blocks
+
+        /** @return MonoState pool instance for the Data type
+         */
+        static Pool& instance()
+        {
+            static Pool pool;
+            return pool;
+        }
+
+        /** Construct Data in a free block
+         * @remark Lock-free and safe to call from multiple threads
+         * @param[in] args  Data constructor arguments
+         * @return Constructed Data or nullptr when every block is allocated
+         */
+        template< typename... Args >
+        Data* create( Args&&... args )
+        {
+            Block* const block = pop();
+            if ( block == nullptr )
+                return nullptr;
+            return new (&block->storage) Data( std::forward<Args>(args)... );
+        }
+
+        /** Destroy Data from create() and return its block to the pool
+         * @param[in] data  Data from create() of this pool, nullptr is ignored
+         */
+        void destroy( Data* const data )
+        {
+            if ( data == nullptr )
+                return;
+            data->~Data();
+            push( reinterpret_cast<Block*>(data) );
+        }
+
+        /** @return Usage counters of the pool
+         * @note Allocations are derived from releases and the blocks in use so may lag a concurrent destroy() by one
+         */
+        AllocationCounters counters() const
+        {
+            AllocationCounters counters;
+            counters.releases = releases_.load( std::memory_order_relaxed );
+            counters.allocations = counters.releases + (cCapacity - freeCount( head_.load( std::memory_order_acquire ) ));
+            counters.failures = failures_.load( std::memory_order_relaxed );
+            counters.highWater = highWater_.load( std::memory_order_relaxed );
+            counters.capacity = cCapacity;
+            return counters;
+        }
+
+    private:
+        static const uint32_t cNil = 0xFFFFU; ///< Free list end
+        static_assert( (cCapacity > 0U) && (cCapacity < cNil), "BrokerTraits::cMaxPooled and cMaxLoans must be in the range [1,65534]" );
+
+        /** Block of Data storage, aligned to a cache line so neighbouring blocks written by different threads do not share one
+         */
+        struct alignas(64) Block
+        {
+            typename std::aligned_storage<sizeof(Data), alignof(Data)>::type storage; ///< @note First member so Data* converts to Block*
+            std::atomic<uint32_t> next; ///< Index of the next free block, cNil at the end
+        };
+
+        Pool()
+            : head_( makeHead( 0U, cCapacity, 0U ) )
+            , releases_( 0U )
+            , failures_( 0U )
+            , highWater_( 0U )
+        {
+            for ( uint32_t iBlock = 0U; iBlock < cCapacity; ++iBlock )
+                blocks_[iBlock].next.store( (iBlock + 1U < cCapacity) ? (iBlock + 1U) : cNil, std::memory_order_relaxed );
+        }
+
+        Pool( const Pool& ); ///< Non-copyable
+        Pool& operator=( const Pool& ); ///< Non-copyable
+
+        /** Free list head word holding the tag, count of free blocks and index of the first free block
+         * @remark The tag is incremented on every change so a block popped and pushed back between the load and the exchange of
+         *  another thread fails the exchange (ABA). Counting free blocks in the same word keeps usage exact without further
+         *  atomic operations on allocate.
+         */
+        static uint64_t makeHead( const uint64_t tag, const uint32_t freeBlocks, const uint32_t index )
+        { return (tag << 32U) | (static_cast<uint64_t>(freeBlocks) << 16U) | index; }
+
+        static uint64_t tag( const uint64_t head )
+        { return head >> 32U; }
+
+        static uint32_t freeCount( const uint64_t head )
+        { return static_cast<uint32_t>( head >> 16U ) & 0xFFFFU; }
+
+        static uint32_t firstFree( const uint64_t head )
+        { return static_cast<uint32_t>( head ) & 0xFFFFU; }
+
+        /** Unlink the head of the free list
+         */
+        Block* pop()
+        {
+            uint64_t head = head_.load( std::memory_order_acquire );
+            for ( ;; )
+            {
+                const uint32_t index = firstFree( head );
+                if ( index == cNil )
+                {
+                    failures_.fetch_add( 1U, std::memory_order_relaxed );
+                    return nullptr;
+                }
+
+                const uint64_t next = makeHead( tag(head) + 1U, freeCount(head) - 1U, blocks_[index].next.load( std::memory_order_relaxed ) );
+                if ( head_.compare_exchange_weak( head, next, std::memory_order_acquire, std::memory_order_acquire ) )
+                {
+                    const uint64_t inUse = cCapacity - freeCount(next);
+                    uint64_t highWater = highWater_.load( std::memory_order_relaxed );
+                    while ( (inUse > highWater) && !highWater_.compare_exchange_weak( highWater, inUse, std::memory_order_relaxed ) )
+                    {}
+                    return &blocks_[index];
+                }
+            }
+        }
+
+        /** Link a block as the head of the free list
+         */
+        void push( Block* const block )
+        {
+            const uint32_t index = static_cast<uint32_t>( block - blocks_ );
+            assert( index < cCapacity );
+            uint64_t head = head_.load( std::memory_order_relaxed );
+            uint64_t next;
+            do
+            {
+                block->next.store( firstFree(head), std::memory_order_relaxed );
+                next = makeHead( tag(head) + 1U, freeCount(head) + 1U, index );
+            } while ( !head_.compare_exchange_weak( head, next, std::memory_order_release, std::memory_order_relaxed ) );
+            releases_.fetch_add( 1U, std::memory_order_relaxed );
+        }
+
+    private:
+        alignas(64) std::atomic<uint64_t> head_; ///< Free list head @see makeHead()
+        alignas(64) std::atomic<uint64_t> releases_; ///< Blocks returned by destroy()
+        std::atomic<uint64_t> failures_; ///< create() calls finding no free block
+        std::atomic<uint64_t> highWater_; ///< Greatest count of blocks allocated at once
+        Block blocks_[cCapacity];
+    };
+
+    /** Owning handle to Data allocated from Pool<Data>
+     * @remark Move-only, the Data is destroyed and its block returned to the pool with the handle e.g. when a queued message
+     *  has been processed
+     * @tparam Data  Pooled data type
+     */
+    template< typename Data >
+    class Pooled
+    {
+    public:
+        Pooled()
+            : data_(nullptr)
+        {}
+
+        explicit Pooled( Data* const data )
+            : data_(data)
+        {}
+
+        Pooled( Pooled&& other )
+            : data_(other.data_)
+        { other.data_ = nullptr; }
+
+        Pooled& operator=( Pooled&& other )
+        {
+            if ( this != &other )
+            {
+                reset();
+                data_ = other.data_;
+                other.data_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~Pooled()
+        { reset(); }
+
+        /** Destroy the Data and return its block to the pool
+         */
+        void reset()
+        {
+            Pool<Data>::instance().destroy( data_ );
+            data_ = nullptr;
+        }
+
+        /** @return True when Data is held, false when the pool was exhausted
+         */
+        explicit operator bool() const
+        { return data_ != nullptr; }
+
+        Data& operator*() const
+        { return *data_; }
+
+        Data* operator->() const
+        { return data_; }
+
+        Data* get() const
+        { return data_; }
+
+    private:
+        Pooled( const Pooled& ); ///< Non-copyable, single owner
+        Pooled& operator=( const Pooled& ); ///< Non-copyable, single owner
+
+    private:
+        Data* data_; ///< Pooled data or nullptr
+    };
+
+    /** Construct Data from the pool of its type
+     * @param[in] args  Data constructor arguments
+     * @return Owning handle, false when the pool was exhausted
+     */
+    template< typename Data, typename... Args >
+    inline Pooled<Data> makePooled( Args&&... args )
+    { return Pooled<Data>( Pool<Data>::instance().create( std::forward<Args>(args)... ) ); }
+
+    /** Per-thread bump allocator of cBytes in thread-local storage
+     * @remark Allocation is a pointer increment with no atomic or heap access. Memory is reclaimed all at once by reset() from
+     *  the owning thread, so suits per-message scratch that lives until the end of a processing cycle e.g. a drain() call.
+     * @note Each thread that uses the arena reserves cBytes of thread-local storage
+     * @tparam cBytes  Arena size per thread
+     */
+    template< size_t cBytes = 65536U >
+    class ThreadArena
+    {
+    public:
+        /** Allocate from the arena of the calling thread
+         * @param[in] bytes  Size of the allocation
+         * @param[in] alignment  Alignment of the allocation @note Must be a power of two
+         * @return Allocation valid until reset() by this thread, nullptr when the arena is exhausted
+         */
+        static void* allocate( const size_t bytes, const size_t alignment = alignof(std::max_align_t) )
+        {
+            Local& local = instance();
+            const size_t offset = (local.used + alignment - 1U) & ~(alignment - 1U);
+            if ( (offset > cBytes) || (bytes > cBytes - offset) )
+            {
+                ++local.counters.failures;
+                return nullptr;
+            }
+
+            local.used = offset + bytes;
+            ++local.counters.allocations;
+            ++local.live;
+            if ( local.used > local.counters.highWater )
+                local.counters.highWater = local.used;
+            return local.bytes + offset;
+        }
+
+        /** Construct a Data in the arena of the calling thread
+         * @param[in] args  Data constructor arguments
+         * @return Constructed Data valid until reset() by this thread, nullptr when the arena is exhausted
+         */
+        template< typename Data, typename... Args >
+        static Data* create( Args&&... args )
+        {
+            static_assert( std::is_trivially_destructible<Data>::value, "ThreadArena does not call destructors on reset()" );
+            void* const storage = allocate( sizeof(Data), alignof(Data) );
+            return storage ? new (storage) Data( std::forward<Args>(args)... ) : nullptr;
+        }
+
+        /** Release every allocation of the calling thread
+         */
+        static void reset()
+        {
+            Local& local = instance();
+            local.counters.releases += local.live;
+            local.live = 0U;
+            local.used = 0U;
+        }
+
+        /** @return Usage counters of the arena of the calling thread
+         */
+        static AllocationCounters counters()
+        { return instance().counters; }
+
+    private:
+        struct alignas(64) Local
+        {
+            Local()
+                : used(0U)
+                , live(0U)
+            {
+                counters.allocations = counters.releases = counters.failures = counters.highWater = 0U;
+                counters.capacity = cBytes;
+            }
+
+            char bytes[cBytes]; ///< Arena storage @note Not zero initialised
+            size_t used; ///< Bytes allocated since reset()
+            uint64_t live; ///< Allocations since reset()
+            AllocationCounters counters; ///< Usage counters of this thread
+        };
+
+        static Local& instance()
+        {
+            static thread_local Local local;
+            return local;
+        }
+    };
+
+} // END: sub0
+
+#endif
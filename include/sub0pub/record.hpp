@@ -0,0 +1,718 @@
+/** Sub0Pub recording and replay of message streams
+ * @remark Recorder appends timestamped records to an OStream, ending the log with per-type and per-timestamp index
+ *  blocks. Player memory maps the log and republishes the records through Broker<Data>, supporting seek by time,
+ *  filtering by type id and replay at recorded speed, a multiple of it, or as fast as possible.
+ *
+ *  Log layout, all fields native byte order and every block 8-byte aligned:
+ *  @code
+ *   FileHeader | Record... | RecordOffsets... | TypeIndex[typeCount] | TimeIndex[timeCount] | Trailer
+ *   Record = timestamp(uint64) + Protocol::Header, padded to 8 | payload, padded to 8
+ *   RecordOffsets = uint64[TypeIndex::count] file offsets of the records of one type, ascending
+ *  @endcode
+ *  A log without a valid Trailer (e.g. recorder terminated early) is indexed by scanning its records on open.
+ *
+ *  This file is part of Sub0Pub. Original project source available at https://github.com/Crog/Sub0Pub/blob/master/sub0pub.hpp
+ *
+ *  MIT License
+ *
+ * Copyright (c) 2018 Craig Hutchinson <craig-sub0pub@crog.uk>
+ *
+ *  See sub0pub.hpp for full license text.
+ */
+#ifndef CROG_SUB0PUB_RECORD_HPP
+#define CROG_SUB0PUB_RECORD_HPP
+
+#include "sub0pub.hpp"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "sub0pub/record.hpp requires POSIX (open and mmap)"
+#endif
+
+#include <chrono> //< std::chrono::system_clock, std::chrono::steady_clock
+#include <thread> //< std::this_thread::sleep_until
+#include <vector> //< std::vector
+
+#include <fcntl.h> //< open, O_RDONLY
+#include <sys/mman.h> //< mmap, munmap
+#include <sys/stat.h> //< fstat
+#include <unistd.h> //< close
+
+/** Sub0Pub top-level namespace
+*/
+namespace sub0
+{
+    /** Recorded log block layouts shared by Recorder and Player
+     */
+    namespace record
+    {
+        static const uint32_t cMagic = utility::FourCC<'S', '0', 'R', 'C'>::value; ///< Identifies a Sub0Pub recording
+        static const uint32_t cVersion = 2U; ///< Log layout version @note Version 2 added TypeIndex::offsets
+        static const uint32_t cAlignment = 8U; ///< Alignment of blocks, records and payloads
+
+        /** @return 'size' rounded up to cAlignment
+         */
+        constexpr uint64_t aligned( const uint64_t size )
+        { return ((size + cAlignment - 1U) / cAlignment) * cAlignment; }
+
+        struct FileHeader
+        {
+            uint32_t magic; ///< cMagic
+            uint32_t version; ///< cVersion
+            uint32_t headerBytes; ///< sizeof(Protocol::Header) used by the recorder
+            uint32_t reserved;
+        };
+
+        /** Per-type index entry
+         */
+        struct TypeIndex
+        {
+            uint32_t typeId;
+            uint32_t dataBytes;
+            uint64_t count; ///< Count of records of the type
+            uint64_t firstTimestamp; ///< Timestamp of the first record of the type
+            uint64_t lastTimestamp; ///< Timestamp of the last record of the type
+            uint64_t offsets; ///< File offset of uint64[count] record offsets of the type
+        };
+
+        /** Per-timestamp index entry, one for every Recorder index interval records
+         */
+        struct TimeIndex
+        {
+            uint64_t timestamp; ///< Timestamp of the record at offset
+            uint64_t offset; ///< File offset of the record
+        };
+
+        struct Trailer
+        {
+            uint64_t typeIndexOffset; ///< File offset of TypeIndex[typeCount]
+            uint64_t typeCount;
+            uint64_t timeIndexOffset; ///< File offset of TimeIndex[timeCount]
+            uint64_t timeCount;
+            uint64_t recordsEnd; ///< File offset following the last record
+            uint32_t magic; ///< cMagic, written last to mark the indexes complete
+            uint32_t version; ///< cVersion
+        };
+
+        /** @return Nanoseconds since the system clock epoch
+         */
+        inline uint64_t now()
+        {
+            return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::system_clock::now().time_since_epoch() ).count() );
+        }
+
+        /** Report recording failure
+         */
+        inline void failure( const char* const failureMessage )
+        {
+#if __cpp_exceptions
+            throw std::runtime_error(failureMessage);
+#else
+            assert((void*)0 == failureMessage);
+#endif
+        }
+    } // END: record
+
+    /** Records forwarded data with timestamps into an indexed log
+     * @remark Use with ForwardSubscribe<Data,Target> in the same way as StreamSerializer. Each record reaches the stream as a
+     *  single write, the index blocks are written by close() or on destruction.
+     * @note Data must be trivially copyable and its type registered with SUB0_TYPENAME or SUB0_TYPEID
+     * @tparam  Protocol  Provides the record Header type @see sub0::DefaultSerialisation
+     */
+    template< typename Protocol = DefaultSerialisation >
+    class Recorder
+    {
+    public:
+        typedef typename Protocol::Header Header_t;
+
+        /** Writes the log file header
+         * @param[in] stream  Append-only stream receiving the log e.g. a file opened for binary write
+         * @param[in] indexInterval  Count of records between time index entries
+         */
+        explicit Recorder( OStream& stream, const uint32_t indexInterval = 1024U )
+            : stream_(stream)
+            , indexInterval_( indexInterval ? indexInterval : 1U )
+            , offset_(0U)
+            , recordCount_(0U)
+            , closed_(false)
+            , record_()
+            , typeIndex_()
+            , typeOffsets_()
+            , timeIndex_()
+        {
+            const record::FileHeader header = { record::cMagic, record::cVersion, static_cast<uint32_t>(sizeof(Header_t)), 0U };
+            write( reinterpret_cast<const char*>(&header), sizeof(header) );
+        }
+
+        /** Write indexes when not already closed
+         * @note A failed final write cannot be reported from the destructor, call close() first to observe it
+         */
+        ~Recorder()
+        {
+#if __cpp_exceptions
+            try
+            {
+                close();
+            }
+            catch ( const std::exception& )
+            {} //< Destructors are noexcept, the log is left without indexes and Player rebuilds them by scanning
+#else
+            close();
+#endif
+        }
+
+        /** Receives forwarded data from a subscriber and records it with the current time
+         * @param[in] data  Forwarded data
+         */
+        template<typename Data>
+        void forward( const Data& data )
+        {
+            record( data, record::now() );
+        }
+
+        /** Record data with a supplied timestamp
+         * @param[in] data  Data to record
+         * @param[in] timestamp  Nanosecond timestamp @note Timestamps are expected to be non-decreasing for seek()
+         */
+        template<typename Data>
+        void record( const Data& data, const uint64_t timestamp )
+        {
+            static_assert( std::is_trivially_copyable<Data>::value, "Records are copied as raw bytes" );
+
+            const Header_t header( data );
+            const size_t payloadOffset = static_cast<size_t>( record::aligned(sizeof(timestamp) + sizeof(header)) );
+            record_.assign( payloadOffset + static_cast<size_t>(record::aligned(sizeof(data))), 0 );
+            std::memcpy( record_.data(), &timestamp, sizeof(timestamp) );
+            std::memcpy( record_.data() + sizeof(timestamp), &header, sizeof(header) );
+            std::memcpy( record_.data() + payloadOffset, &data, sizeof(data) );
+
+            if ( (recordCount_ % indexInterval_) == 0U )
+            {
+                const record::TimeIndex entry = { timestamp, offset_ };
+                timeIndex_.push_back( entry );
+            }
+            indexType( header, timestamp, offset_ );
+            ++recordCount_;
+
+            write( record_.data(), record_.size() );
+        }
+
+        /** Write the index blocks and trailer, further records are not indexed
+         * @remark Reports a stream write failure through record::failure()
+         */
+        void close()
+        {
+            if ( closed_ )
+                return;
+            closed_ = true;
+
+            record::Trailer trailer = {};
+            trailer.recordsEnd = offset_;
+            for ( size_t iType = 0U; iType < typeIndex_.size(); ++iType )
+            {
+                typeIndex_[iType].offsets = offset_;
+                write( reinterpret_cast<const char*>(typeOffsets_[iType].data()), typeOffsets_[iType].size() * sizeof(uint64_t) );
+            }
+            trailer.typeIndexOffset = offset_;
+            trailer.typeCount = typeIndex_.size();
+            write( reinterpret_cast<const char*>(typeIndex_.data()), typeIndex_.size() * sizeof(record::TypeIndex) );
+            trailer.timeIndexOffset = offset_;
+            trailer.timeCount = timeIndex_.size();
+            write( reinterpret_cast<const char*>(timeIndex_.data()), timeIndex_.size() * sizeof(record::TimeIndex) );
+            trailer.magic = record::cMagic;
+            trailer.version = record::cVersion;
+            write( reinterpret_cast<const char*>(&trailer), sizeof(trailer) );
+            stream_.flush();
+        }
+
+        /** @return Count of records written
+         */
+        uint64_t recordCount() const
+        { return recordCount_; }
+
+    private:
+        Recorder( const Recorder& ); ///< Non-copyable
+        Recorder& operator=( const Recorder& ); ///< Non-copyable
+
+        void indexType( const Header_t& header, const uint64_t timestamp, const uint64_t offset )
+        {
+            for ( size_t iType = 0U; iType < typeIndex_.size(); ++iType )
+            {
+                if ( (typeIndex_[iType].typeId == header.typeId) && (typeIndex_[iType].dataBytes == header.dataBytes) )
+                {
+                    ++typeIndex_[iType].count;
+                    typeIndex_[iType].lastTimestamp = timestamp;
+                    typeOffsets_[iType].push_back( offset );
+                    return;
+                }
+            }
+            const record::TypeIndex entry = { header.typeId, header.dataBytes, 1U, timestamp, timestamp, 0U };
+            typeIndex_.push_back( entry );
+            typeOffsets_.push_back( std::vector<uint64_t>( 1U, offset ) );
+        }
+
+        void write( const char* const buffer, const size_t bufferCount )
+        {
+            if ( bufferCount == 0U )
+                return;
+            if ( !utility::writeBytes( stream_, buffer, bufferCount ) )
+                record::failure( "Sub0Pub - Recorder stream write failed" );
+            offset_ += bufferCount;
+        }
+
+    private:
+        OStream& stream_; ///< Stream the log is appended to
+        const uint32_t indexInterval_; ///< Records between time index entries
+        uint64_t offset_; ///< Bytes written to stream_
+        uint64_t recordCount_; ///< Records written
+        bool closed_; ///< Indexes have been written
+        std::vector<char> record_; ///< Record being assembled
+        std::vector<record::TypeIndex> typeIndex_; ///< Entry per recorded type
+        std::vector< std::vector<uint64_t> > typeOffsets_; ///< Record offsets per typeIndex_ entry
+        std::vector<record::TimeIndex> timeIndex_; ///< Entry per indexInterval_ records
+    };
+
+    /** Replays a Recorder log, publishing its records through Broker<Data>
+     * @remark The log is memory mapped and payloads are published in place. Register publishers with
+     *  DirectPublish<Data,Target> where Target derives from Player in the same way as BufferDeserializer.
+     *  Every record is bounds checked before it is read, replay stops at a record overrunning the log @see isCorrupt()
+     *  With a filter set play() walks the per-type record offsets of the filtered types, other records are not read
+     * @tparam  Protocol  Provides the record Header type @see sub0::DefaultSerialisation
+     * @tparam  cMaxPublishers  Count of Data types that can be registered
+     */
+    template< typename Protocol = DefaultSerialisation, uint32_t cMaxPublishers = 64U >
+    class Player
+    {
+    public:
+        typedef typename Protocol::Header Header_t;
+
+        /** Map the log and load, or rebuild, its indexes
+         * @param[in] path  Log file written by Recorder
+         */
+        explicit Player( const char* const path )
+            : publishers_()
+            , map_(nullptr)
+            , mapSize_(0U)
+            , recordsEnd_(0U)
+            , position_(0U)
+            , corrupt_(false)
+            , speed_(1.0)
+            , paced_(false)
+            , paceClock_()
+            , paceTimestamp_(0U)
+            , filter_()
+            , typeIndex_()
+            , typeOffsets_()
+            , scannedOffsets_()
+            , timeIndex_()
+        {
+            const int fd = ::open( path, O_RDONLY );
+            struct stat status;
+            if ( (fd < 0) || (::fstat(fd, &status) != 0) )
+            {
+                if ( fd >= 0 )
+                    ::close( fd );
+                record::failure( "Sub0Pub - Player could not open log" );
+                return;
+            }
+
+            mapSize_ = static_cast<size_t>( status.st_size );
+            if ( mapSize_ >= sizeof(record::FileHeader) )
+            {
+                void* const map = ::mmap( nullptr, mapSize_, PROT_READ, MAP_PRIVATE, fd, 0 );
+                map_ = (map != MAP_FAILED) ? static_cast<const char*>(map) : nullptr;
+            }
+            ::close( fd );
+
+            const record::FileHeader* const header = map_ ? reinterpret_cast<const record::FileHeader*>(map_) : nullptr;
+            if ( !header || (header->magic != record::cMagic) || (header->version != record::cVersion) || (header->headerBytes != sizeof(Header_t)) )
+            {
+                unmap(); //< The destructor does not run when the constructor throws
+                record::failure( "Sub0Pub - Player log header invalid or incompatible" );
+                return;
+            }
+
+            position_ = sizeof(record::FileHeader);
+            if ( !loadIndex() )
+                scanIndex();
+        }
+
+        ~Player()
+        {
+            unmap();
+        }
+
+        /** Register the publisher for records with header
+         * @remark Called by sub0::DirectPublish<Data>
+         */
+        void setDirectPublisher( const Header_t& header, const detail::PublishRecord publish, const void* const context )
+        {
+            publishers_.set( header, publish, context );
+        }
+
+        /** Replay only records of the type id, may be called for several types
+         * @param[in] typeId  Type id to replay e.g. sub0::typeId<Data>()
+         */
+        void filter( const uint32_t typeId )
+        {
+            filter_.push_back( typeId );
+        }
+
+        /** Replay records of all types
+         */
+        void clearFilter()
+        {
+            filter_.clear();
+        }
+
+        /** Set replay speed relative to the recording
+         * @param[in] speed  1.0 replays in real time, N replays N times faster, zero or less replays as fast as possible
+         */
+        void setSpeed( const double speed )
+        {
+            speed_ = speed;
+            paced_ = false;
+        }
+
+        /** Position replay at the first record with a timestamp at or after 'timestamp'
+         * @remark Binary searches the time index then scans at most one index interval of record headers
+         */
+        void seek( const uint64_t timestamp )
+        {
+            position_ = sizeof(record::FileHeader);
+            const std::vector<record::TimeIndex>::const_iterator iIndex = std::upper_bound( timeIndex_.begin(), timeIndex_.end(), timestamp,
+                []( const uint64_t lhs, const record::TimeIndex& rhs ) { return lhs < rhs.timestamp; } );
+            if ( (iIndex != timeIndex_.begin()) && ((iIndex - 1)->offset >= position_) && ((iIndex - 1)->offset < recordsEnd_) )
+                position_ = (iIndex - 1)->offset;
+
+            while ( position_ < recordsEnd_ )
+            {
+                const uint64_t size = recordSizeAt( position_ );
+                if ( size == 0U )
+                {
+                    corrupt();
+                    break;
+                }
+                if ( timestampAt(position_) >= timestamp )
+                    break;
+                position_ += size;
+            }
+            paced_ = false;
+        }
+
+        /** Publish the next records that pass the filter
+         * @remark Blocks between records to honour the replay speed
+         * @param[in] maxCount  Maximum count of records to publish
+         * @return Count of records published, less than maxCount at the end of the log
+         */
+        uint64_t play( const uint64_t maxCount = UINT64_MAX )
+        {
+            if ( !filter_.empty() )
+                return playFiltered( maxCount );
+
+            uint64_t count = 0U;
+            while ( (count < maxCount) && (position_ < recordsEnd_) )
+            {
+                const uint64_t size = recordSizeAt( position_ );
+                if ( size == 0U )
+                {
+                    corrupt();
+                    break;
+                }
+
+                const char* const recordStart = map_ + position_;
+                uint64_t timestamp;
+                Header_t header;
+                std::memcpy( &timestamp, recordStart, sizeof(timestamp) );
+                std::memcpy( &header, recordStart + sizeof(timestamp), sizeof(header) );
+                position_ += size;
+
+                const typename detail::DirectPublishers<Header_t, cMaxPublishers>::Publisher* const publisher = publishers_.find( header );
+                if ( !publisher )
+                    continue; //< No publisher registered for the type
+
+                pace( timestamp );
+                publisher->publish( publisher->context, recordStart + payloadOffset() );
+                ++count;
+            }
+            return count;
+        }
+
+        /** @return True when all records have been replayed
+         */
+        bool isEof() const
+        { return position_ >= recordsEnd_; }
+
+        /** @return True when replay stopped at a record overrunning the log
+         */
+        bool isCorrupt() const
+        { return corrupt_; }
+
+        /** @return Per-type index with record counts and time range of each type
+         */
+        const std::vector<record::TypeIndex>& types() const
+        { return typeIndex_; }
+
+        /** @return Timestamp of the first record, zero for an empty log
+         */
+        uint64_t beginTimestamp() const
+        { return timeIndex_.empty() ? 0U : timeIndex_.front().timestamp; }
+
+        /** @return Timestamp of the last record, zero for an empty log
+         */
+        uint64_t endTimestamp() const
+        {
+            uint64_t timestamp = 0U;
+            for ( std::vector<record::TypeIndex>::const_iterator iType = typeIndex_.begin(); iType != typeIndex_.end(); ++iType )
+            {
+                timestamp = std::max( timestamp, iType->lastTimestamp );
+            }
+            return timestamp;
+        }
+
+    private:
+        Player( const Player& ); ///< Non-copyable
+        Player& operator=( const Player& ); ///< Non-copyable
+
+        static constexpr uint64_t payloadOffset()
+        { return record::aligned( sizeof(uint64_t) + sizeof(Header_t) ); }
+
+        static uint64_t recordSize( const Header_t& header )
+        { return payloadOffset() + record::aligned( header.dataBytes ); }
+
+        uint64_t timestampAt( const uint64_t offset ) const
+        {
+            uint64_t timestamp;
+            std::memcpy( &timestamp, map_ + offset, sizeof(timestamp) );
+            return timestamp;
+        }
+
+        /** @return Bytes of the record at offset, zero if the record overruns recordsEnd_
+         */
+        uint64_t recordSizeAt( const uint64_t offset ) const
+        {
+            if ( (recordsEnd_ - offset) < payloadOffset() )
+                return 0U;
+
+            Header_t header;
+            std::memcpy( &header, map_ + offset + sizeof(uint64_t), sizeof(header) );
+            const uint64_t size = recordSize( header );
+            return (size <= (recordsEnd_ - offset)) ? size : 0U;
+        }
+
+        /** Stop replay at a corrupt record
+         */
+        void corrupt()
+        {
+            corrupt_ = true;
+            position_ = recordsEnd_;
+        }
+
+        bool accepted( const uint32_t typeId ) const
+        {
+            return std::find( filter_.begin(), filter_.end(), typeId ) != filter_.end();
+        }
+
+        /** Record offsets of one typeIndex_ entry
+         */
+        struct TypeOffsets
+        {
+            const uint64_t* begin; ///< First offset, in the mapped log or scannedOffsets_
+            const uint64_t* end; ///< Following the last offset
+        };
+
+        /** play() with a filter, merging the offset lists of the filtered types in file order
+         */
+        uint64_t playFiltered( const uint64_t maxCount )
+        {
+            std::vector<TypeOffsets> cursors;
+            for ( size_t iType = 0U; iType < typeIndex_.size(); ++iType )
+            {
+                if ( accepted( typeIndex_[iType].typeId ) )
+                {
+                    const TypeOffsets cursor = { std::lower_bound( typeOffsets_[iType].begin, typeOffsets_[iType].end, position_ ), typeOffsets_[iType].end };
+                    cursors.push_back( cursor );
+                }
+            }
+
+            uint64_t count = 0U;
+            while ( (count < maxCount) && (position_ < recordsEnd_) )
+            {
+                TypeOffsets* next = nullptr;
+                for ( typename std::vector<TypeOffsets>::iterator iCursor = cursors.begin(); iCursor != cursors.end(); ++iCursor )
+                {
+                    if ( (iCursor->begin != iCursor->end) && (!next || (*iCursor->begin < *next->begin)) )
+                        next = &*iCursor;
+                }
+                if ( !next )
+                {
+                    position_ = recordsEnd_; //< No further records of the filtered types
+                    break;
+                }
+
+                const uint64_t offset = *next->begin++;
+                if ( offset < position_ )
+                    continue; //< Out of order offset in a damaged index
+                const uint64_t size = (offset < recordsEnd_) ? recordSizeAt( offset ) : 0U;
+                if ( size == 0U )
+                {
+                    corrupt();
+                    break;
+                }
+
+                const char* const recordStart = map_ + offset;
+                uint64_t timestamp;
+                Header_t header;
+                std::memcpy( &timestamp, recordStart, sizeof(timestamp) );
+                std::memcpy( &header, recordStart + sizeof(timestamp), sizeof(header) );
+                position_ = offset + size;
+                if ( !accepted(header.typeId) )
+                {
+                    corrupt(); //< Index does not match the records
+                    break;
+                }
+
+                const typename detail::DirectPublishers<Header_t, cMaxPublishers>::Publisher* const publisher = publishers_.find( header );
+                if ( !publisher )
+                    continue; //< No publisher registered for the type
+
+                pace( timestamp );
+                publisher->publish( publisher->context, recordStart + payloadOffset() );
+                ++count;
+            }
+            return count;
+        }
+
+        void unmap()
+        {
+            if ( map_ )
+                ::munmap( const_cast<char*>(map_), mapSize_ );
+            map_ = nullptr;
+        }
+
+        /** Sleep until the record is due at the replay speed, the first record after a seek or speed change is due now
+         */
+        void pace( const uint64_t timestamp )
+        {
+            if ( speed_ <= 0.0 )
+                return;
+
+            if ( !paced_ || (timestamp < paceTimestamp_) )
+            {
+                paced_ = true;
+                paceClock_ = std::chrono::steady_clock::now();
+                paceTimestamp_ = timestamp;
+                return;
+            }
+
+            const std::chrono::nanoseconds delay( static_cast<int64_t>( static_cast<double>(timestamp - paceTimestamp_) / speed_ ) );
+            std::this_thread::sleep_until( paceClock_ + delay );
+        }
+
+        /** Load the index blocks referenced by a valid trailer
+         * @return False if the log has no valid trailer
+         */
+        bool loadIndex()
+        {
+            if ( mapSize_ < (sizeof(record::FileHeader) + sizeof(record::Trailer)) )
+                return false;
+
+            record::Trailer trailer;
+            std::memcpy( &trailer, map_ + mapSize_ - sizeof(trailer), sizeof(trailer) );
+            if ( (trailer.magic != record::cMagic) || (trailer.version != record::cVersion)
+              || (trailer.typeIndexOffset > mapSize_) || (trailer.typeCount > ((mapSize_ - trailer.typeIndexOffset) / sizeof(record::TypeIndex)))
+              || (trailer.timeIndexOffset > mapSize_) || (trailer.timeCount > ((mapSize_ - trailer.timeIndexOffset) / sizeof(record::TimeIndex)))
+              || (trailer.recordsEnd < sizeof(record::FileHeader)) || (trailer.recordsEnd > trailer.typeIndexOffset) )
+                return false;
+
+            const record::TypeIndex* const types = reinterpret_cast<const record::TypeIndex*>( map_ + trailer.typeIndexOffset );
+            for ( const record::TypeIndex* iType = types; iType != (types + trailer.typeCount); ++iType )
+            {
+                if ( (iType->offsets % record::cAlignment) || (iType->offsets > mapSize_) || (iType->count > ((mapSize_ - iType->offsets) / sizeof(uint64_t))) )
+                    return false;
+            }
+            typeIndex_.assign( types, types + trailer.typeCount );
+            for ( std::vector<record::TypeIndex>::const_iterator iType = typeIndex_.begin(); iType != typeIndex_.end(); ++iType )
+            {
+                const uint64_t* const offsets = reinterpret_cast<const uint64_t*>( map_ + iType->offsets );
+                const TypeOffsets entry = { offsets, offsets + iType->count };
+                typeOffsets_.push_back( entry );
+            }
+            const record::TimeIndex* const times = reinterpret_cast<const record::TimeIndex*>( map_ + trailer.timeIndexOffset );
+            timeIndex_.assign( times, times + trailer.timeCount );
+            recordsEnd_ = trailer.recordsEnd;
+            return true;
+        }
+
+        /** Rebuild indexes by walking the records, stopping at the first incomplete record
+         */
+        void scanIndex()
+        {
+            static const uint64_t cIndexInterval = 1024U; ///< Records between rebuilt time index entries
+            uint64_t offset = sizeof(record::FileHeader);
+            uint64_t recordCount = 0U;
+            while ( (mapSize_ - offset) >= payloadOffset() )
+            {
+                uint64_t timestamp;
+                Header_t header;
+                std::memcpy( &timestamp, map_ + offset, sizeof(timestamp) );
+                std::memcpy( &header, map_ + offset + sizeof(timestamp), sizeof(header) );
+                const uint64_t size = recordSize( header );
+                if ( (mapSize_ - offset) < size )
+                    break;
+
+                if ( (recordCount++ % cIndexInterval) == 0U )
+                {
+                    const record::TimeIndex entry = { timestamp, offset };
+                    timeIndex_.push_back( entry );
+                }
+
+                std::vector<record::TypeIndex>::iterator iType = typeIndex_.begin();
+                while ( (iType != typeIndex_.end()) && !((iType->typeId == header.typeId) && (iType->dataBytes == header.dataBytes)) )
+                {
+                    ++iType;
+                }
+                if ( iType == typeIndex_.end() )
+                {
+                    const record::TypeIndex entry = { header.typeId, header.dataBytes, 1U, timestamp, timestamp, 0U };
+                    typeIndex_.push_back( entry );
+                    scannedOffsets_.push_back( std::vector<uint64_t>( 1U, offset ) );
+                }
+                else
+                {
+                    ++iType->count;
+                    iType->lastTimestamp = timestamp;
+                    scannedOffsets_[ static_cast<size_t>(iType - typeIndex_.begin()) ].push_back( offset );
+                }
+
+                offset += size;
+            }
+            recordsEnd_ = offset;
+
+            for ( std::vector< std::vector<uint64_t> >::const_iterator iOffsets = scannedOffsets_.begin(); iOffsets != scannedOffsets_.end(); ++iOffsets )
+            {
+                const TypeOffsets entry = { iOffsets->data(), iOffsets->data() + iOffsets->size() };
+                typeOffsets_.push_back( entry );
+            }
+        }
+
+    private:
+        detail::DirectPublishers<Header_t, cMaxPublishers> publishers_; ///< Publisher per registered record header
+        const char* map_; ///< Mapped log
+        size_t mapSize_; ///< Bytes mapped
+        uint64_t recordsEnd_; ///< Offset following the last record
+        uint64_t position_; ///< Offset of the next record to replay
+        bool corrupt_; ///< Replay stopped at a record overrunning recordsEnd_
+        double speed_; ///< Replay speed multiplier, zero or less for maximum speed
+        bool paced_; ///< paceClock_ and paceTimestamp_ are anchored
+        std::chrono::steady_clock::time_point paceClock_; ///< Time the anchor record was replayed
+        uint64_t paceTimestamp_; ///< Timestamp of the anchor record
+        std::vector<uint32_t> filter_; ///< Replayed type ids, empty for all
+        std::vector<record::TypeIndex> typeIndex_; ///< Entry per recorded type
+        std::vector<TypeOffsets> typeOffsets_; ///< Record offsets per typeIndex_ entry
+        std::vector< std::vector<uint64_t> > scannedOffsets_; ///< Storage of typeOffsets_ rebuilt by scanIndex()
+        std::vector<record::TimeIndex> timeIndex_; ///< Sparse timestamp to record offset index
+    };
+
+} // END: sub0
+
+#endif
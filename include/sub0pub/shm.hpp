@@ -0,0 +1,653 @@
+/** Sub0Pub shared-memory inter-process transport
+ * @remark Single-producer single-consumer byte ring in a shared memory segment with futex wake-ups. Usable as an OStream/IStream
+ *  pair for StreamSerializer/StreamDeserializer, or in direct mode where records are written in place by ShmSerializer and
+ *  published from the segment memory by ShmDeserializer without passing through a stream.
+ *
+ *  This file is part of Sub0Pub. Original project source available at https://github.com/Crog/Sub0Pub/blob/master/sub0pub.hpp
+ *
+ *  MIT License
+ *
+ * Copyright (c) 2018 Craig Hutchinson <craig-sub0pub@crog.uk>
+ *
+ *  See sub0pub.hpp for full license text.
+ */
+#ifndef CROG_SUB0PUB_SHM_HPP
+#define CROG_SUB0PUB_SHM_HPP
+
+#include "sub0pub.hpp"
+
+#if !defined(__linux__)
+#error "sub0pub/shm.hpp requires Linux (memfd/shm_open, mmap and futex)"
+#endif
+
+#if SUB0PUB_STD
+#error "sub0pub/shm.hpp implements the sub0::OStream/IStream interface (SUB0PUB_STD=false)"
+#endif
+
+#include <atomic> //< std::atomic
+#include <climits> //< INT_MAX
+#include <ctime> //< timespec
+
+#include <fcntl.h> //< O_CREAT, O_RDWR
+#include <linux/futex.h> //< FUTEX_WAIT, FUTEX_WAKE
+#include <sys/mman.h> //< mmap, shm_open, memfd_create
+#include <sys/stat.h> //< fstat
+#include <sys/syscall.h> //< SYS_futex
+#include <unistd.h> //< ftruncate, close, sysconf
+
+/** Sub0Pub top-level namespace
+*/
+namespace sub0
+{
+    namespace detail
+    {
+        static_assert( (sizeof(std::atomic<uint32_t>) == sizeof(uint32_t)) && (ATOMIC_INT_LOCK_FREE == 2), "Futex words require lock-free 32-bit atomics" );
+
+        /** Block while word == expected, or until woken or timeout
+         * @param timeoutMs  Relative timeout in milliseconds, negative for none
+         */
+        inline void futexWait( std::atomic<uint32_t>& word, const uint32_t expected, const int32_t timeoutMs )
+        {
+            timespec timeout = { timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+            syscall( SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, (timeoutMs >= 0) ? &timeout : nullptr, nullptr, 0 );
+        }
+
+        /** Wake all processes waiting on word
+         */
+        inline void futexWake( std::atomic<uint32_t>& word )
+        {
+            syscall( SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0 );
+        }
+
+        /** Report shared memory setup failure
+         */
+        inline void shmFailure( const char* const failureMessage )
+        {
+#if __cpp_exceptions
+            throw std::runtime_error(failureMessage);
+#else
+            assert((void*)0 == failureMessage);
+#endif
+        }
+    } // END: detail
+
+    /** Single-producer single-consumer byte ring in shared memory
+     * @remark The data region is mapped twice back-to-back so any reservation up to capacity() is contiguous in memory,
+     *  records never need splitting at the wrap point. Waiting uses process-shared futexes on the ring positions and a
+     *  wake system call is only made when the other side is waiting. Capacity is a power of two so the free-running 32-bit
+     *  positions map to the same offset either side of their wrap.
+     * @note Fan-out to several processes uses one ring per consumer
+     */
+    class ShmRing
+    {
+        /** Segment control block on the first page of the segment
+         */
+        struct Control
+        {
+            uint32_t magic; ///< Identifies an initialised segment
+            uint32_t capacity; ///< Data region size in bytes
+            alignas(64) std::atomic<uint32_t> writePosition; ///< Total bytes committed by the producer, consumer futex word
+            std::atomic<uint32_t> readerWaiting; ///< Consumer is, or is about to, wait on writePosition
+            std::atomic<uint32_t> closed; ///< Producer has closed the ring
+            alignas(64) std::atomic<uint32_t> readPosition; ///< Total bytes consumed, producer futex word
+            std::atomic<uint32_t> writerWaiting; ///< Producer is, or is about to, wait on readPosition
+        };
+
+        static const uint32_t cMagic = utility::FourCC<'S', 'H', 'M', '0'>::value;
+
+    public:
+        /** Create a named segment with shm_open, or an anonymous memfd segment when name is nullptr
+         * @remark An anonymous segment is shared by passing fd() to the peer process i.e. via fork() or SCM_RIGHTS
+         * @param[in] name  shm_open() name e.g. "/sub0pub-telemetry" or nullptr
+         * @param[in] capacity  Data region bytes, rounded up to a power of two count of pages @note At most 2^31
+         */
+        ShmRing( const char* const name, const uint32_t capacity )
+            : fd_(-1)
+            , ownsName_(false)
+            , control_(nullptr)
+            , data_(nullptr)
+            , capacity_(0U)
+            , mapping_(nullptr)
+            , mappingSize_(0U)
+            , name_()
+        {
+            fd_ = name ? ::shm_open( name, O_CREAT | O_EXCL | O_RDWR, 0600 ) : ::memfd_create( "sub0pub", 0 );
+            if ( fd_ < 0 )
+            {
+                fail( "Sub0Pub - shared memory segment creation failed" );
+                return;
+            }
+
+            if ( name )
+            {
+                ownsName_ = true;
+                std::strncpy( name_, name, sizeof(name_) - 1U );
+            }
+
+            const uint32_t dataSize = roundToCapacity( capacity );
+            if ( dataSize < capacity )
+            {
+                fail( "Sub0Pub - shared memory capacity exceeds 2^31 bytes" );
+                return;
+            }
+
+            if ( ::ftruncate( fd_, static_cast<off_t>(pageSize()) + dataSize ) != 0 )
+            {
+                fail( "Sub0Pub - shared memory segment resize failed" );
+                return;
+            }
+
+            if ( map( dataSize ) )
+            {
+                control_->capacity = dataSize;
+                control_->writePosition.store( 0U );
+                control_->readPosition.store( 0U );
+                control_->readerWaiting.store( 0U );
+                control_->writerWaiting.store( 0U );
+                control_->closed.store( 0U );
+                std::atomic_thread_fence( std::memory_order_release );
+                control_->magic = cMagic;
+            }
+        }
+
+        /** Open an existing named segment
+         * @param[in] name  shm_open() name used by the creator
+         */
+        explicit ShmRing( const char* const name )
+            : fd_( ::shm_open( name, O_RDWR, 0600 ) )
+            , ownsName_(false)
+            , control_(nullptr)
+            , data_(nullptr)
+            , capacity_(0U)
+            , mapping_(nullptr)
+            , mappingSize_(0U)
+            , name_()
+        {
+            attach();
+        }
+
+        /** Attach to a segment from a file descriptor e.g. an inherited memfd
+         * @param[in] fd  Descriptor, ownership is taken
+         */
+        explicit ShmRing( const int fd )
+            : fd_(fd)
+            , ownsName_(false)
+            , control_(nullptr)
+            , data_(nullptr)
+            , capacity_(0U)
+            , mapping_(nullptr)
+            , mappingSize_(0U)
+            , name_()
+        {
+            attach();
+        }
+
+        ~ShmRing()
+        {
+            release();
+        }
+
+        /** @return True when the segment is mapped and ready for use
+         */
+        bool isOpen() const
+        { return control_ != nullptr; }
+
+        /** @return Segment file descriptor for sharing anonymous segments
+         */
+        int fd() const
+        { return fd_; }
+
+        /** @return Data region size in bytes, the largest possible reservation
+         */
+        uint32_t capacity() const
+        { return capacity_; }
+
+        /// @name Producer
+        /// @{
+
+        /** Reserve contiguous space for writing
+         * @param[in] size  Bytes required, at most capacity()
+         * @param[in] timeoutMs  Milliseconds to wait for the consumer to free space, negative to wait indefinitely
+         * @return Pointer to write 'size' bytes to before commit(), nullptr on timeout
+         */
+        char* reserve( const uint32_t size, const int32_t timeoutMs = -1 )
+        {
+            assert( size <= capacity() );
+            const uint32_t write = control_->writePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const uint32_t read = control_->readPosition.load(std::memory_order_acquire);
+                if ( (capacity() - (write - read)) >= size )
+                    return data_ + (write & (capacity_ - 1U));
+
+                if ( timeoutMs == 0 )
+                    return nullptr;
+
+                control_->writerWaiting.store( 1U );
+                if ( control_->readPosition.load() == read )
+                {
+                    detail::futexWait( control_->readPosition, read, timeoutMs );
+                    if ( (timeoutMs > 0) && (control_->readPosition.load() == read) )
+                    {
+                        control_->writerWaiting.store( 0U, std::memory_order_relaxed );
+                        return nullptr;
+                    }
+                }
+                control_->writerWaiting.store( 0U, std::memory_order_relaxed );
+            }
+        }
+
+        /** Make reserved bytes visible to the consumer
+         * @param[in] size  Bytes written at the reserve() pointer
+         */
+        void commit( const uint32_t size )
+        {
+            control_->writePosition.store( control_->writePosition.load(std::memory_order_relaxed) + size );
+            if ( control_->readerWaiting.load() )
+                detail::futexWake( control_->writePosition );
+        }
+
+        /** Signal end of stream to the consumer
+         */
+        void close()
+        {
+            control_->closed.store( 1U );
+            if ( control_->readerWaiting.load() )
+                detail::futexWake( control_->writePosition );
+        }
+        /// @}
+
+        /// @name Consumer
+        /// @{
+
+        /** Access committed bytes
+         * @param[out] available  Count of contiguous bytes readable at the returned pointer
+         * @return Pointer to the oldest unconsumed byte
+         */
+        const char* peek( uint32_t& available ) const
+        {
+            const uint32_t read = control_->readPosition.load(std::memory_order_relaxed);
+            available = control_->writePosition.load(std::memory_order_acquire) - read;
+            return data_ + (read & (capacity_ - 1U));
+        }
+
+        /** Release bytes back to the producer
+         * @param[in] size  Bytes consumed from the peek() pointer
+         */
+        void consume( const uint32_t size )
+        {
+            control_->readPosition.store( control_->readPosition.load(std::memory_order_relaxed) + size );
+            if ( control_->writerWaiting.load() )
+                detail::futexWake( control_->readPosition );
+        }
+
+        /** Block until data is available, the ring is closed or timeout
+         * @param[in] timeoutMs  Milliseconds to wait, negative to wait indefinitely
+         * @return True if data is available
+         */
+        bool wait( const int32_t timeoutMs = -1 )
+        {
+            const uint32_t read = control_->readPosition.load(std::memory_order_relaxed);
+            if ( control_->writePosition.load(std::memory_order_acquire) != read )
+                return true;
+
+            control_->readerWaiting.store( 1U );
+            if ( (control_->writePosition.load() == read) && !control_->closed.load() )
+            {
+                detail::futexWait( control_->writePosition, read, timeoutMs );
+            }
+            control_->readerWaiting.store( 0U, std::memory_order_relaxed );
+            return control_->writePosition.load(std::memory_order_acquire) != read;
+        }
+
+        /** @return True when the producer has closed the ring
+         */
+        bool isClosed() const
+        { return control_->closed.load(std::memory_order_acquire) != 0U; }
+        /// @}
+
+    private:
+        ShmRing( const ShmRing& ); ///< Non-copyable
+        ShmRing& operator=( const ShmRing& ); ///< Non-copyable
+
+        static uint32_t pageSize()
+        { return static_cast<uint32_t>( ::sysconf(_SC_PAGESIZE) ); }
+
+        /** @return Smallest power of two count of pages holding size bytes, or 2^31 when size is larger
+         */
+        static uint32_t roundToCapacity( const uint32_t size )
+        {
+            uint32_t capacity = pageSize();
+            while ( (capacity < size) && (capacity <= (UINT32_MAX / 2U)) )
+                capacity *= 2U;
+            return capacity;
+        }
+
+        /** Unmap, close and unlink the segment leaving the ring closed
+         */
+        void release()
+        {
+            if ( mapping_ )
+                ::munmap( mapping_, mappingSize_ );
+            if ( fd_ >= 0 )
+                ::close( fd_ );
+            if ( ownsName_ )
+                ::shm_unlink( name_ );
+            mapping_ = nullptr;
+            mappingSize_ = 0U;
+            fd_ = -1;
+            ownsName_ = false;
+            control_ = nullptr;
+            data_ = nullptr;
+            capacity_ = 0U;
+        }
+
+        /** Release partially created segment before reporting setup failure
+         * @note The destructor does not run when the constructor throws
+         */
+        void fail( const char* const failureMessage )
+        {
+            release();
+            detail::shmFailure( failureMessage );
+        }
+
+        /** Map existing segment, the data region size must be a power of two matching the capacity stored by the creator
+         */
+        void attach()
+        {
+            struct stat status;
+            if ( (fd_ < 0) || (::fstat( fd_, &status ) != 0) || (status.st_size <= static_cast<off_t>(pageSize())) )
+            {
+                fail( "Sub0Pub - shared memory segment open failed" );
+                return;
+            }
+
+            const off_t dataSize = status.st_size - static_cast<off_t>(pageSize());
+            if ( (dataSize > static_cast<off_t>(UINT32_MAX / 2U + 1U)) || (dataSize & (dataSize - 1)) )
+            {
+                fail( "Sub0Pub - shared memory segment size invalid" );
+                return;
+            }
+
+            if ( map( static_cast<uint32_t>(dataSize) ) && ((control_->magic != cMagic) || (control_->capacity != capacity_)) )
+            {
+                fail( "Sub0Pub - shared memory segment not initialised" );
+            }
+        }
+
+        /** Map control page followed by the data region twice
+         */
+        bool map( const uint32_t dataSize )
+        {
+            mappingSize_ = pageSize() + (2U * static_cast<size_t>(dataSize));
+            mapping_ = ::mmap( nullptr, mappingSize_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+            if ( mapping_ == MAP_FAILED )
+            {
+                mapping_ = nullptr;
+                fail( "Sub0Pub - shared memory address reservation failed" );
+                return false;
+            }
+
+            char* const base = static_cast<char*>(mapping_);
+            if ( (::mmap( base, pageSize() + dataSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd_, 0 ) == MAP_FAILED)
+              || (::mmap( base + pageSize() + dataSize, dataSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd_, pageSize() ) == MAP_FAILED) )
+            {
+                fail( "Sub0Pub - shared memory mapping failed" );
+                return false;
+            }
+
+            control_ = reinterpret_cast<Control*>(base);
+            data_ = base + pageSize();
+            capacity_ = dataSize;
+            return true;
+        }
+
+    private:
+        int fd_; ///< Segment descriptor
+        bool ownsName_; ///< Unlink name_ on destruction
+        Control* control_; ///< Control block in the segment, nullptr when not open
+        char* data_; ///< Start of the doubly mapped data region
+        uint32_t capacity_; ///< Data region size, a power of two @note Held locally, the control block is writable by the peer
+        void* mapping_; ///< Address range of the whole mapping
+        size_t mappingSize_; ///< Bytes of mapping_
+        char name_[64]; ///< shm_open name when owned
+    };
+
+    /** Output stream writing into a ShmRing for use with StreamSerializer
+     * @remark write() blocks until all bytes are in the ring
+     */
+    class ShmOStream : public OStream
+    {
+    public:
+        explicit ShmOStream( ShmRing& ring )
+            : ring_(ring)
+        {}
+
+        virtual StreamSize write( const char* const buffer, const StreamSize bufferCount )
+        {
+            StreamSize written = 0U;
+            while ( written < bufferCount )
+            {
+                const uint32_t chunk = static_cast<uint32_t>( std::min<StreamSize>( bufferCount - written, ring_.capacity() ) );
+                std::memcpy( ring_.reserve( chunk ), buffer + written, chunk );
+                ring_.commit( chunk );
+                written += chunk;
+            }
+            return written;
+        }
+
+        /** Data is visible to the consumer on write(), nothing is buffered
+         */
+        virtual void flush()
+        {}
+
+    private:
+        ShmRing& ring_;
+    };
+
+    /** Input stream reading from a ShmRing for use with StreamDeserializer
+     * @remark read() and ignore() do not block, use ShmRing::wait() to sleep until data arrives
+     */
+    class ShmIStream : public IStream
+    {
+    public:
+        explicit ShmIStream( ShmRing& ring )
+            : ring_(ring)
+        {}
+
+        virtual StreamSize read( char* const buffer, const StreamSize bufferCount )
+        {
+            uint32_t available = 0U;
+            const char* const data = ring_.peek( available );
+            const uint32_t count = static_cast<uint32_t>( std::min<StreamSize>( bufferCount, available ) );
+            std::memcpy( buffer, data, count );
+            ring_.consume( count );
+            return count;
+        }
+
+        virtual StreamSize ignore( const StreamSize bufferCount )
+        {
+            uint32_t available = 0U;
+            ring_.peek( available );
+            const uint32_t count = static_cast<uint32_t>( std::min<StreamSize>( bufferCount, available ) );
+            ring_.consume( count );
+            return count;
+        }
+
+        virtual StreamSize ignore( const StreamSize bufferCount, const char delimiter )
+        {
+            uint32_t available = 0U;
+            const char* const data = ring_.peek( available );
+            const uint32_t limit = static_cast<uint32_t>( std::min<StreamSize>( bufferCount, available ) );
+            const char* const found = static_cast<const char*>( std::memchr( data, delimiter, limit ) );
+            const uint32_t count = found ? static_cast<uint32_t>(found - data) + 1U : limit;
+            ring_.consume( count );
+            return count;
+        }
+
+        virtual bool isEof()
+        {
+            uint32_t available = 0U;
+            ring_.peek( available );
+            return (available == 0U) && ring_.isClosed();
+        }
+
+    private:
+        ShmRing& ring_;
+    };
+
+    /** Direct mode serialiser writing each forwarded Data as one record in place in a ShmRing
+     * @remark Record layout is Protocol::Header followed by the Data bytes padded to cRecordAlignment, costing a single memcpy
+     *  of the payload and no stream calls. Use with ForwardSubscribe<Data,Target> in the same way as StreamSerializer.
+     * @note Data must be trivially copyable, records are consumed by ShmDeserializer
+     * @tparam  Protocol  Provides the record Header type @see sub0::DefaultSerialisation
+     */
+    template< typename Protocol = DefaultSerialisation >
+    class ShmSerializer
+    {
+    public:
+        typedef typename Protocol::Header Header_t;
+        static const uint32_t cRecordAlignment = 8U; ///< Alignment of each record and its payload in the ring
+
+        /** @param[in] ring  Ring records are written into
+         */
+        explicit ShmSerializer( ShmRing& ring )
+            : ring_(ring)
+        {}
+
+        /** Receives forwarded data from a subscriber and writes it as a record
+         * @param[in] data  Forwarded data
+         */
+        template<typename Data>
+        void forward( const Data& data )
+        {
+            static_assert( std::is_trivially_copyable<Data>::value, "Shared memory records are copied as raw bytes" );
+            static_assert( alignof(Data) <= cRecordAlignment, "Data alignment exceeds shared memory record alignment" );
+
+            const uint32_t size = recordSize( sizeof(Data) );
+            char* const record = ring_.reserve( size );
+            const Header_t header( data );
+            std::memcpy( record, &header, sizeof(header) );
+            std::memcpy( record + headerSize(), &data, sizeof(data) );
+            ring_.commit( size );
+        }
+
+        /** Signal end of stream to the consumer
+         */
+        void close()
+        { ring_.close(); }
+
+        /** @return Offset of payload from record start
+         */
+        static uint32_t headerSize()
+        { return recordSize(0U); }
+
+        /** @return Bytes of a record with 'dataBytes' payload
+         */
+        static uint32_t recordSize( const uint32_t dataBytes )
+        { return ((static_cast<uint32_t>(sizeof(Header_t)) + cRecordAlignment - 1U) / cRecordAlignment) * cRecordAlignment
+                + (((dataBytes + cRecordAlignment - 1U) / cRecordAlignment) * cRecordAlignment); }
+
+    private:
+        ShmRing& ring_; ///< Ring records are written into
+    };
+
+    /** Direct mode deserialiser publishing records in place from ShmRing memory
+     * @remark Subscribers receive a reference into the shared segment, valid for the duration of receive().
+     *  Headers come from another process so are validated before use, a record that does not fit the committed bytes or
+     *  the ring discards everything committed and decoding resumes at the next record the producer commits.
+     * @tparam  Protocol  Provides the record Header type @see sub0::DefaultSerialisation
+     * @tparam  cMaxPublishers  Count of Data types that can be registered
+     */
+    template< typename Protocol = DefaultSerialisation, uint32_t cMaxPublishers = 64U >
+    class ShmDeserializer
+    {
+    public:
+        typedef typename Protocol::Header Header_t;
+
+        /** @param[in] ring  Ring records are read from
+         */
+        explicit ShmDeserializer( ShmRing& ring )
+            : ring_(ring)
+            , publishers_()
+            , skipCount_(0U)
+            , corruptCount_(0U)
+        {}
+
+        /** Register the publisher for records with header
+         * @remark Called by sub0::ShmPublish<Data>
+         */
+        void setDirectPublisher( const Header_t& header, const detail::PublishRecord publish, const void* const context )
+        {
+            publishers_.set( header, publish, context );
+        }
+
+        /** Publish all complete records in the ring
+         * @return True when records were published, false if none were available
+         */
+        bool update()
+        {
+            uint32_t available = 0U;
+            const char* record = ring_.peek( available );
+            uint32_t consumed = 0U;
+            while ( (available - consumed) >= sizeof(Header_t) )
+            {
+                Header_t header;
+                std::memcpy( &header, record, sizeof(header) );
+                if ( (header.dataBytes > ring_.capacity())
+                  || (ShmSerializer<Protocol>::recordSize( header.dataBytes ) > (available - consumed)) )
+                {
+                    ++corruptCount_; //< Records are committed whole, the header is corrupt
+                    consumed = available;
+                    break;
+                }
+                const uint32_t size = ShmSerializer<Protocol>::recordSize( header.dataBytes );
+
+                const typename detail::DirectPublishers<Header_t, cMaxPublishers>::Publisher* const publisher = publishers_.find( header );
+                if ( publisher )
+                    publisher->publish( publisher->context, record + ShmSerializer<Protocol>::headerSize() );
+                else
+                    ++skipCount_; //< Unregistered type, record skipped
+
+                record += size;
+                consumed += size;
+            }
+
+            ring_.consume( consumed );
+            return consumed != 0U;
+        }
+
+        /** Block until records are available
+         * @see ShmRing::wait()
+         */
+        bool wait( const int32_t timeoutMs = -1 )
+        { return ring_.wait( timeoutMs ); }
+
+        /** @return Count of records skipped as no publisher was registered for their header
+         * @note Registered publishers match the header type and size so a payload is never read past its record
+         */
+        uint32_t skipCount() const
+        { return skipCount_; }
+
+        /** @return Count of corrupt headers, each discarding the bytes committed when it was read
+         */
+        uint32_t corruptCount() const
+        { return corruptCount_; }
+
+    private:
+        ShmRing& ring_; ///< Ring records are read from
+        detail::DirectPublishers<Header_t, cMaxPublishers> publishers_; ///< Publisher per registered record header
+        uint32_t skipCount_; ///< Records with no registered publisher
+        uint32_t corruptCount_; ///< Headers describing records larger than committed
+    };
+
+    /** Register publication of Data records from a ShmDeserializer data provider
+     * @remark Records in the ring are aligned so subscribers always receive a reference into shared memory
+     * @see DirectPublish
+     */
+    template<typename Data, typename DataProvider >
+    using ShmPublish = DirectPublish<Data, DataProvider>;
+
+} // END: sub0
+
+#endif
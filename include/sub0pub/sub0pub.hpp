@@ -24,10 +24,14 @@
 
 #include <algorithm>
 #include <cassert> //< assert
+#include <cstddef> //< std::max_align_t
 #include <cstring> //< std::strcmp
+#include <limits> //< std::numeric_limits
+#include <stdexcept> //< std::runtime_error
 #include <array> //< std::array @todo Should we not use this one occurrence for C++98 compatibility?
 //#include <typeinfo> //< typeid()
 #include <type_traits> //< std::is_same
+#include <utility> //< std::swap, std::forward
 
  /// @todo 0 vs nullptr C++11 only
 #if 1 /// @todo cstdint not always available ... C++11/C99 only 
@@ -37,11 +41,12 @@
     typedef unsigned int uint32_t;
 #endif
 
-/** Logging output for event tracing
- * Define SUB0PUB_TRACE=true to enable message logging to std::cout for event trace, SUB0PUB_TRACE=false
+/** Binary event tracing
+ * Define SUB0PUB_TRACE=true to write broker events to the SUB0PUB_TRACE_SINK, SUB0PUB_TRACE=false to disable
+ * @see sub0::trace
  */
 #ifndef SUB0PUB_TRACE
-#define SUB0PUB_TRACE false ///< Disable Trace logging to std::cout by default
+#define SUB0PUB_TRACE false ///< Disable event tracing by default
 #endif
 
 /** Assertion based error handling 
@@ -59,6 +64,38 @@
 #define SUB0PUB_TYPEIDNAME false ///< Types given unique/user-defined type index and string name for diagnostics and IPC
 #endif
 
+#ifndef SUB0PUB_THREADS
+#define SUB0PUB_THREADS false ///< Thread-safe broker modes, async.hpp, stats and shared brokers available (requires <atomic>, <mutex> and <thread>)
+#endif
+
+#ifndef SUB0PUB_STATS
+#define SUB0PUB_STATS false ///< Per-broker publish/delivery counters and subscriber receive time histograms @see sub0::stats
+#endif
+
+#if SUB0PUB_STATS && !SUB0PUB_THREADS
+#error "SUB0PUB_STATS requires SUB0PUB_THREADS"
+#endif
+
+#ifndef SUB0PUB_SHARED_BROKERS
+#define SUB0PUB_SHARED_BROKERS false ///< Broker states shared across shared library boundaries through a process-wide registry
+#endif
+
+#ifndef SUB0PUB_REGISTRY_CAPACITY
+#define SUB0PUB_REGISTRY_CAPACITY 1024U ///< Maximum count of Data types in the process with SUB0PUB_SHARED_BROKERS
+#endif
+
+#if SUB0PUB_SHARED_BROKERS && !SUB0PUB_THREADS
+#error "SUB0PUB_SHARED_BROKERS requires SUB0PUB_THREADS"
+#endif
+
+#ifndef SUB0PUB_TRACE_SINK
+#if SUB0PUB_TRACE && SUB0PUB_THREADS
+#define SUB0PUB_TRACE_SINK ::sub0::trace::RingSink ///< Trace records kept in a lock-free ring per thread
+#else
+#define SUB0PUB_TRACE_SINK ::sub0::trace::NullSink ///< Trace records discarded, define a sink with static write( const sub0::trace::Record& )
+#endif
+#endif
+
 #ifndef SUB0_EXPERIMENTAL
 #define SUB0_EXPERIMENTAL false ///< Experimental functionality that may be later removed/dropped
 #endif
@@ -78,13 +115,47 @@
 #if SUB0PUB_STD
 #include <ostream> //< std::ostream
 #include <istream> //< std::istream
+#include <functional> //< std::hash
 #endif
 
-/// @todo Trace interface - currently std::cout only!!
-#if SUB0PUB_TRACE
-#include <iostream>
+#if SUB0PUB_TRACE || SUB0PUB_STD || SUB0PUB_STATS
+#include <cstdarg> //< va_list
+#include <cstdio> //< std::vsnprintf
+#include <chrono> //< std::chrono::steady_clock
+#include <vector> //< std::vector
 #endif
 
+#if SUB0PUB_THREADS
+#include <atomic> //< std::atomic
+#include <mutex> //< std::mutex
+#include <thread> //< std::this_thread::yield
+#endif
+
+#if SUB0PUB_SHARED_BROKERS
+#include <cstdio> //< std::snprintf, std::fopen
+#include <cstdlib> //< std::strtoull
+#include <new> //< placement new
+#include <vector> //< std::vector
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX //< Keep std::min and std::max usable
+#define SUB0PUB_UNDEF_NOMINMAX
+#endif
+#include <windows.h> //< CreateFileMappingA, MapViewOfFile
+#ifdef SUB0PUB_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef SUB0PUB_UNDEF_NOMINMAX
+#endif
+#elif defined(__linux__)
+#include <sys/mman.h> //< memfd_create, mmap
+#include <unistd.h> //< ftruncate, close
+#else
+#error "SUB0PUB_SHARED_BROKERS requires Linux or Windows"
+#endif
+#endif
+
+
+
 /** Sub0Pub top-level namespace
 */
 namespace sub0
@@ -103,18 +174,15 @@ namespace sub0
         };
 
         /** Hash a string using djb2 hash
+         * @remark Evaluated at compile time for string literals used in constant expressions e.g. SUB0_TYPENAME
          * @param[in] str  Null-terminated string to calculate hash of
-         * @todo Implement as compile time with name
+         * @param[in] hash  Hash of the characters preceding 'str'
          * @return djb2 hash value for input 'str'
          */
-        inline uint32_t hash( const char* str)
+        constexpr uint32_t hash( const char* str, const uint32_t hash = 5381U )
         {
-            uint32_t hash = 5381U;
-            for ( ; str[0U] != '\0'; ++str )
-            {
-                hash = ((hash << 5) + hash) + str[0U]; /* hash * 33 + c */
-            }
-            return hash;
+            return (str[0U] == '\0') ? hash 
+                : utility::hash( str + 1U, ((hash << 5) + hash) + static_cast<uint32_t>(str[0U]) ); /* hash * 33 + c */
         }
 
 #if SUB0PUB_STD
@@ -133,6 +201,18 @@ namespace sub0
             const Type_t defaulted;
             return stream.write(reinterpret_cast<const char*>(&defaulted), sizeof(defaulted)).good();
         }
+
+        inline bool writeBytes(OStream& stream, const char* const buffer, const size_t bufferCount)
+        {
+            return stream.write(buffer, static_cast<std::streamsize>(bufferCount)).good();
+        }
+
+        /** @return Count of bytes accepted by the stream @note std::ostream reports no partial count, a failed write counts zero
+         */
+        inline size_t writeSome(OStream& stream, const char* const buffer, const size_t bufferCount)
+        {
+            return writeBytes( stream, buffer, bufferCount ) ? bufferCount : 0U;
+        }
 #else
         /**
         * @note char* to unify interface against std::ostream
@@ -191,14 +271,166 @@ namespace sub0
             const Type_t defaulted;
             return stream.write(reinterpret_cast<const char*>(&defaulted), sizeof(defaulted)) == sizeof(defaulted);
         }
+
+        inline bool writeBytes(OStream& stream, const char* const buffer, const size_t bufferCount)
+        {
+            return stream.write(buffer, static_cast<OStream::StreamSize>(bufferCount)) == bufferCount;
+        }
+
+        /** @return Count of bytes accepted by the stream
+         */
+        inline size_t writeSome(OStream& stream, const char* const buffer, const size_t bufferCount)
+        {
+            return std::min<size_t>( stream.write(buffer, static_cast<OStream::StreamSize>(bufferCount)), bufferCount );
+        }
 #endif
 
         template<>
-        inline bool write<void>(OStream& stream)
+        inline bool write<void>(OStream&)
         {
             return true;
         }
 
+        /** Copy value into buffer
+         * @return Position in buffer following value
+         */
+        template< typename Type_t >
+        inline char* put(char* const buffer, const Type_t& value)
+        {
+            std::memcpy(buffer, &value, sizeof(value));
+            return buffer + sizeof(value);
+        }
+
+        template< typename Type_t >
+        inline char* put(char* const buffer)
+        {
+            const Type_t defaulted;
+            return put(buffer, defaulted);
+        }
+
+        template<>
+        inline char* put<void>(char* const buffer)
+        {
+            return buffer;
+        }
+
+#if SUB0PUB_TRACE || SUB0PUB_STD || SUB0PUB_STATS
+        /** Write printf formatted text to stream
+         * @note Output is truncated to 255 characters per call
+         */
+        inline void print( OStream& stream, const char* const format, ... )
+        {
+            char line[256];
+            va_list arguments;
+            va_start( arguments, format );
+            const int count = std::vsnprintf( line, sizeof(line), format, arguments );
+            va_end( arguments );
+            if ( count > 0 )
+                writeBytes( stream, line, std::min<size_t>( static_cast<size_t>(count), sizeof(line) - 1U ) );
+        }
+#endif
+
+        /** Growable byte array of serialised records, in place of std::vector<char> so the core needs no container headers
+         * @note Capacity is retained by clear() and grows geometrically by resize()
+         */
+        class ByteBuffer
+        {
+        public:
+            explicit ByteBuffer( const size_t size = 0U )
+                : data_( size ? new char[size] : 0/*nullptr*/ )
+                , size_(size)
+                , capacity_(size)
+            {}
+
+            ByteBuffer( const ByteBuffer& other )
+                : data_( other.size_ ? new char[other.size_] : 0/*nullptr*/ )
+                , size_(other.size_)
+                , capacity_(other.size_)
+            {
+                if ( size_ )
+                    std::memcpy( data_, other.data_, size_ );
+            }
+
+            ~ByteBuffer()
+            { delete[] data_; }
+
+            ByteBuffer& operator=( ByteBuffer other )
+            {
+                std::swap( data_, other.data_ );
+                std::swap( size_, other.size_ );
+                std::swap( capacity_, other.capacity_ );
+                return *this;
+            }
+
+            char* data()
+            { return data_; }
+
+            const char* data() const
+            { return data_; }
+
+            size_t size() const
+            { return size_; }
+
+            bool empty() const
+            { return size_ == 0U; }
+
+            void clear()
+            { size_ = 0U; }
+
+            /** Remove the first 'count' bytes, moving the remainder to the front
+             */
+            void erase( const size_t count )
+            {
+                const size_t removed = std::min( count, size_ );
+                if ( removed < size_ )
+                    std::memmove( data_, data_ + removed, size_ - removed );
+                size_ -= removed;
+            }
+
+            /** Allocate at least 'capacity' bytes, preserving the content
+             */
+            void reserve( const size_t capacity )
+            {
+                if ( capacity <= capacity_ )
+                    return;
+
+                char* const data = new char[capacity];
+                if ( size_ )
+                    std::memcpy( data, data_, size_ );
+                delete[] data_;
+                data_ = data;
+                capacity_ = capacity;
+            }
+
+            /** Set the byte count, bytes appended are uninitialised
+             */
+            void resize( const size_t size )
+            {
+                if ( size > capacity_ )
+                    reserve( std::max( size, capacity_ * 2U ) );
+                size_ = size;
+            }
+
+        private:
+            char* data_; ///< Allocated bytes, nullptr when capacity_ is zero
+            size_t size_; ///< Bytes in use
+            size_t capacity_; ///< Bytes allocated
+        };
+
+        /** sizeof(Type_t) where void has no size
+         */
+        template< typename Type_t >
+        struct SizeOf
+        {
+            static const size_t value = sizeof(Type_t);
+        };
+
+        template<>
+        struct SizeOf<void>
+        {
+            static const size_t value = 0U;
+        };
+
     } // END: utility
     
     typedef utility::OStream OStream;
@@ -206,280 +438,3354 @@ namespace sub0
 
     /** Broker manages publisher-subscriber connection for a 'Data' type
      * @tparam Data  Data type which this instance manages connections for
+     * @tparam Channel  Channel of Data the connections are made on, void for the default channel @see RuntimeChannel
      */
-    template< typename Data >
+    template< typename Data, typename Channel = void >
     class Broker;
 
     /** Base type for publishing signals of 'Data' type
      * @tparam Data  Data type which this instance manages publishing for
+     * @tparam Channel  Channel of Data published on, void for the default channel
      */
-    template< typename Data >
+    template< typename Data, typename Channel = void >
     class Publish;
 
     /** Base type for subscription to receive signals of 'Data' type
      * @tparam Data  Data type which this instance manages subscriptions for
+     * @tparam Channel  Channel of Data subscribed to, void for the default channel
      */
-    template< typename Data >
+    template< typename Data, typename Channel = void >
     class Subscribe;
-    
-    /** Internal configured details for tracing and error handling
+
+    /** Default compile-time configuration of a Broker<Data>
+     * @remark Derive BrokerTraits<Data> specialisations from this type and override only the members that differ
      */
-    namespace detail
+    struct DefaultBrokerTraits
     {
-        /** Provides debug assertion/exception checks for Broker<>
-         * @tparam cMessageTrace   Enable logging for broker events
-         * @tparam cDoAssert         Enable assertion tests for invalid parameters
-         */
-        template< const bool cMessageTrace = false, const bool cDoAssert = true >
-        struct CheckT
-        {
-            /** Diagnose creation of new subscriber
-             * @param broker  Broker instance that manages the connection
-             * @param subscriber  Subscriber to be registered into the broker
-             * @param subscriptionCount  Count of existing registered subscriptions on the broker
-             * @param subscriptionCapacity  Count specifying subscriptionCount limit for the broker
-             */
-            template<typename Data>
-            inline static void onSubscription( const Broker<Data>& broker, Subscribe<Data>* subscriber, const uint32_t subscriptionCount, const uint32_t subscriptionCapacity )
-            {
-                if ( cDoAssert )
-                {
-                    assert( subscriber );
-                    assert( subscriptionCount < subscriptionCapacity );
-                }
-#if SUB0PUB_TRACE /// @todo iostream removal:
-                if ( cMessageTrace )
-                { 
-                    std::cout << "[Sub0Pub] New Subscription " << *subscriber << " for Broker<" << broker.typeName() << ">{" << broker << '}' << std::endl;
-                }
-#endif
-            }
+        static const uint32_t cMaxSubscriptions = 8U; ///< Fixed subscription table capacity, or the inline capacity before growing when cGrowable
+        static const bool cGrowable = false; ///< Grow subscription table on subscribe when full @note Table remains contiguous and publish never allocates
+        static const bool cConcurrent = false; ///< Lock-free publish from any thread with subscribe/unsubscribe swapping immutable table snapshots @note Requires SUB0PUB_THREADS, implies growable
+        static const uint32_t cMaxLoans = 4U; ///< Count of Data slots in the pool loaned by LoanPublish<Data> @see sub0pub/loan.hpp
+        static const uint32_t cMaxPooled = 64U; ///< Count of Data blocks in Pool<Data> @see sub0pub/pool.hpp
+        static const bool cCacheLast = false; ///< Keep the last published Data and replay it to new subscribers, Subscribe and DirectSubscribe register once fully constructed @see Subscribed @note Requires trivially copyable Data and not cConcurrent @see Broker::replay
+    };
 
-            /** Diagnose creation of new publisher
-             * @param publisher  Publisher to be registered into the broker
-             * @param broker  Broker instance that manages the connection
-             * @param publisherCount  Count of existing registered publishers on the broker
-             * @param publisherCapacity  Count specifying publisherCount limit for the broker
-             */
-            template<typename Data>
-            inline static void onPublication( Publish<Data>* publisher, const Broker<Data>& broker, const uint32_t publisherCount, const uint32_t publisherCapacity )
-            {
-                if ( cDoAssert )
-                {
-                    assert( publisher );
-                    assert( publisherCount < publisherCapacity );
-                }
-#if SUB0PUB_TRACE /// @todo iostream removal:
-                if ( cMessageTrace )
-                { 
-                    std::cout << "[Sub0Pub] New Publication " << *publisher << " for Broker<" << broker.typeName() << ">{" << broker << '}' << std::endl;
-                }
-#endif
-            }
+    /** Per-type compile-time configuration hook for Broker<Data>
+     * @remark Specialise for a Data type to change its subscription table e.g.
+     * @code
+     *  namespace sub0 { template<> struct BrokerTraits<Telemetry> : DefaultBrokerTraits { static const uint32_t cMaxSubscriptions = 64U; }; }
+     * @endcode
+     * @tparam Data  Data type which the traits configure the Broker<Data> for
+     */
+    template< typename Data >
+    struct BrokerTraits : DefaultBrokerTraits
+    {};
 
-            /** Diagnose data publish event
-             * @param publisher  Publisher that is sending the data
-             * @param data  The data to be published
-             */
-            template<typename Data>
-            inline static void onPublish( const Publish<Data>& publisher, const Data& data )
-            {
-#if SUB0PUB_TRACE /// @todo iostream removal: 
-                if ( cMessageTrace )
-                {
-                    (void)data; ///< @todo Data serialize
-                    std::cout << "[Sub0Pub] Published " << publisher
-                        << " {_data_todo_}"/** @todo Data serialize: << data*/ << '[' << Broker<Data>::typeName() << ']' << std::endl;
-                }
-#endif
-            }
+    /** Compile-time name and identifier of a Data type used for serialisation and diagnostics
+     * @remark Specialise with SUB0_TYPENAME(Data, "Name") or SUB0_TYPEID(Data, "Name", id) rather than directly
+     * @tparam Data  Data type which is named
+     */
+    template< typename Data >
+    struct TypeName
+    {
+        static const bool cRegistered = false; ///< Data has no registered name or id
 
-            /** Diagnose data receive event
-             * @param subscriber  Subscriber that is receiving the data
-             * @param data  The data that is received
-             */
-            template<typename Data>
-            static void 
-#if __GNUG__ /// @todo GCC 7.2(TBC) publish(const Data & data) bug on inlining this function and calling detail::Check::onReceive()?
-                __attribute__((noinline)) 
-#endif
-                onReceive( Subscribe<Data>* subscriber, const Data& data )
-            {
-                if ( cDoAssert )
-                {
-#if 0 ///< @temp
-                    while (!subscriber)
-                    {
-                        delay(1);
-                    }
-#endif
-                    if ( subscriber == nullptr )
-                    {
-                       // while (true) {};
-                       assert(subscriber );
-                    }
-                }
-#if SUB0PUB_TRACE /// @todo iostream removal: 
-                if ( cMessageTrace )
-                {
-                    (void)data; ///< @todo Data serialize
-                    std::cout << "[Sub0Pub] Received " << *subscriber
-                        << " {_data_todo_}"/** @todo Data serialize: << data*/ << '[' << Broker<Data>::typeName() << ']' << std::endl;
-                }
-#endif
-            }
-        };
+        static constexpr const char* name() { return 0/*nullptr*/; }
+        static constexpr uint32_t id() { return 0U; }
+    };
 
-        /** Runtime checker type with support for assert/exception/trace etc
+    namespace detail
+    {
+        /** Records the Data type registered with a type id
+         * @note Only specialised by SUB0_TYPEID, a second type with the same id is a redefinition compile error. The owner
+         *  member is defined by SUB0_TYPEID_OWNER so the same collision across translation units fails to link.
          */
-        typedef CheckT<SUB0PUB_TRACE,SUB0PUB_ASSERT> Check;
+        template< uint32_t cTypeId >
+        struct TypeIdOwner;
     } // END: detail
 
-#pragma warning(push)
-#pragma warning(disable:4355) ///< warning C4355: 'this' : used in base member initializer list
+    /** Register a compile-time name and identifier for a Data type
+     * @remark Use in the global namespace alongside the Data declaration so every translation unit sees the same id.
+     *  Two types registered with the same id (i.e. a name hash collision) fail to compile where both are visible, add
+     *  SUB0_TYPEID_OWNER to also detect them across translation units.
+     * @param  Data  Data type to register
+     * @param  Name  String literal name, unique across all communicating processes
+     * @param  Id  Non-zero type identifier used in serialised headers
+     */
+#define SUB0_TYPEID(Data, Name, Id) \
+    namespace sub0 { \
+        template<> struct TypeName<Data> { \
+            static const bool cRegistered = true; \
+            static constexpr const char* name() { return Name; } \
+            static constexpr uint32_t id() { return Id; } \
+        }; \
+        namespace detail { \
+            static_assert( (Id) != 0U, "Sub0Pub type id 0 is reserved for unregistered types" ); \
+            template<> struct TypeIdOwner<(Id)> { typedef Data type; static const char* const owner; }; /* @note Redefinition here is a type id collision */ \
+        } \
+    }
 
-    /** Base type for an object that subscribes to some strong-typed Data
-     * @tparam  Data  Type that will be received from publishers of corresponding type
+    /** Define the owner of a registered type id as a strong symbol keyed on the id
+     * @remark Use once, in the global namespace of the source file owning Data. A second type registered with the same id
+     *  by another translation unit then fails to link with a multiple definition of sub0::detail::TypeIdOwner<Id>::owner.
+     * @note Symbols of separate shared libraries do not collide, only objects linked into one executable or library are checked
+     * @param  Data  Data type registered with SUB0_TYPEID or SUB0_TYPENAME
      */
-    template< typename Data >
-    class Subscribe
+#define SUB0_TYPEID_OWNER(Data) \
+    namespace sub0 { namespace detail { \
+        const char* const TypeIdOwner< ::sub0::TypeName<Data>::id() >::owner = ::sub0::TypeName<Data>::name(); \
+    } }
+
+    /** Register a compile-time name for a Data type with its identifier as the djb2 hash of the name
+     * @see SUB0_TYPEID
+     */
+#define SUB0_TYPENAME(Data, Name) \
+    SUB0_TYPEID(Data, Name, ::sub0::utility::hash(Name))
+
+#if SUB0PUB_STATS
+    namespace detail
     {
-    public:
-        /** Registers the subscriber within the broker framework
-         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
-         */
-        Subscribe( 
-#if SUB0PUB_TYPEIDNAME
-            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/ 
-#endif
-        )
-        : broker_( this
-#if SUB0PUB_TYPEIDNAME
-            , typeId, typeName 
+        struct ReceiveStats;
+    } // END: detail
 #endif
-        )
+
+    /** Dispatch priority of a subscription
+     * @remark Broker<Data>::publish delivers to subscriptions in descending priority and to subscriptions of equal priority in
+     *  the order they subscribed. Tables are kept sorted on subscribe so publish does no ordering work.
+     */
+    struct Priority
+    {
+        static const int32_t cCritical = 1000; ///< Latency-critical subscribers e.g. risk checks and control loops
+        static const int32_t cNormal = 0; ///< Default priority
+        static const int32_t cDeferred = INT32_MIN; ///< After every other subscriber e.g. handing off to a worker thread
+
+        explicit Priority( const int32_t priorityValue = cNormal )
+            : value(priorityValue)
         {}
 
-        virtual ~Subscribe()
-        {  broker_.unsubscribe(this); } ///< @todo Make implicit broker handle
-        
-        /** Receive published Data
-         * @remark Data is published from Publish<Data>::publish
-         */
-        virtual void receive( const Data& data ) = 0;
+        int32_t value; ///< Higher values receive first
+    };
 
-        virtual bool filter(const Data& data)
-        {  return true; }
+    /** Constructor tag binding a Broker to its channel without registering a subscription
+     * @remark Subscribers built in two phases register later through Broker::subscribe() @see Subscribed
+     */
+    struct Unsubscribed {};
 
-#if SUB0PUB_TYPEIDNAME
-        /** Get name identifier of the Data from the broker
-         * @return Broker null-terminated type name
-        */
-        const char* typeName() const
-        { return broker_.typeName(); }
+    /** Channel tag selecting a channel identified at runtime by ChannelId
+     * @remark Channels split the publishers and subscribers of a Data type into independent topics/instances, each with its own
+     *  subscription table so a publish only visits subscribers of its channel. Compile-time channels are any other tag type
+     *  e.g. `struct LeftCamera; Publish<Image, LeftCamera>`, runtime channels pass a ChannelId to the constructor
+     *  e.g. `Publish<Image, RuntimeChannel> camera( ChannelId(cameraIndex) )`. Channels share the type id and name of Data.
+     */
+    struct RuntimeChannel {};
 
-        /** Stream operator for diagnostics reporting
-         * @param stream  Stream to report into
-         * @param subscriber  Subscriber instance to be written into stream
-         * @return Reference to 'stream'
-         */
-        friend OStream& operator<< ( OStream& stream, const Subscribe<Data>& subscriber )
-        { return stream << subscriber.typeName() << '{' << (void*)&subscriber << '}'; }
-#endif
+    /** Identifier of a runtime channel @see RuntimeChannel
+     */
+    struct ChannelId
+    {
+        explicit ChannelId( const uint32_t channelValue )
+            : value(channelValue)
+        {}
 
-    private:
-        Broker<Data> broker_; ///< MonoState broker instance to manage publish-subscribe connections
+        uint32_t value; ///< Channel number, unique per Data type
     };
 
-    /** Base type for an object that publishes to some strong-typed Data
-     * @tparam  Data  Type that will be published by this object to subscribers of corresponding type
+    /** Subscription table entry binding a receive function to the subscriber context it is invoked with
+     * @remark Broker<Data>::publish makes a single indirect call through 'receive' per subscription
+     * @tparam Data  Data type received through the subscription
      */
     template< typename Data >
-    class Publish
+    struct Subscription
     {
-    public:
-        /** Registers the publisher within the broker framework
-         * @param[in] typeName Optional unique data name given to data for inter-process signaling. @warning If not supplied non-portable compiler generated names 'may' be used.
+        /** Function invoked on publish
+         * @param context  Subscription::context registered with the function
+         * @param data  Published data
          */
-        Publish(
-#if SUB0PUB_TYPEIDNAME
-            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+        typedef void (*Receive)( void* context, const Data& data );
+
+        /** Function invoked on batch publish
+         * @param context  Subscription::context registered with the function
+         * @param data  First of 'count' contiguous published data
+         * @param count  Count of published data
+         */
+        typedef void (*ReceiveBatch)( void* context, const Data* data, size_t count );
+
+        Subscription()
+            : receive(0/*nullptr*/)
+            , receiveBatch(0/*nullptr*/)
+            , context(0/*nullptr*/)
+            , priority(Priority::cNormal)
+#if SUB0PUB_STATS
+            , stats(0/*nullptr*/)
+#endif
+        {}
+
+        /** @param receiveBatchFunction  Optional batch receive, when nullptr batches are delivered through receiveFunction per element
+         * @param subscriptionPriority  Delivery order among subscriptions of Data, higher first @see Priority
+         */
+        Subscription( const Receive receiveFunction, void* const receiveContext, const ReceiveBatch receiveBatchFunction = 0/*nullptr*/
+            , const int32_t subscriptionPriority = Priority::cNormal )
+            : receive(receiveFunction)
+            , receiveBatch(receiveBatchFunction)
+            , context(receiveContext)
+            , priority(subscriptionPriority)
+#if SUB0PUB_STATS
+            , stats(0/*nullptr*/)
+#endif
+        {}
+
+        /** Subscriptions are identified by context only
+         */
+        bool operator == ( const Subscription& rhs ) const
+        { return context == rhs.context; }
+
+        /** Dispatch order of subscription tables
+         * @return True if lhs is delivered to before rhs
+         */
+        static bool precedes( const Subscription& lhs, const Subscription& rhs )
+        { return lhs.priority > rhs.priority; }
+
+        Receive receive; ///< Function invoked with context on publish
+        ReceiveBatch receiveBatch; ///< Function invoked with context on batch publish, or nullptr
+        void* context; ///< Subscriber object or user data passed to receive
+        int32_t priority; ///< Delivery order among subscriptions of Data, higher first
+#if SUB0PUB_STATS
+        detail::ReceiveStats* stats; ///< Receive time histogram assigned by the broker
+#endif
+    };
+
+    /** Binary event tracing of broker activity
+     * @remark With SUB0PUB_TRACE the detail::CheckT events are written as fixed-size trace::Record to the SUB0PUB_TRACE_SINK
+     *  policy, any type with a static write( const trace::Record& ). The default RingSink keeps the latest records of each
+     *  thread in memory for a few nanoseconds per event, RingSink::dump() writes them out for the offline Decoder.
+     */
+    namespace trace
+    {
+        /** Traced broker events
+         */
+        enum Event
+        {
+              cSubscription = 1 ///< Subscription registered, address is the subscription context
+            , cPublication = 2 ///< Publisher registered, address is the publisher
+            , cPublish = 3 ///< Data published, address is the publisher
+            , cPublishBatch = 4 ///< Batch of data published, address is the publisher
+            , cReceive = 5 ///< Data delivered to a subscription, address is the subscription context
+        };
+
+        /** Fixed-size binary trace record
+         */
+        struct Record
+        {
+            uint64_t timestamp; ///< clock() ticks
+            uint64_t address; ///< Publisher or subscription context of the event
+            uint32_t typeId; ///< Data type id, zero when unregistered
+            uint32_t payloadHash; ///< hashBytes() of the leading payload bytes, zero when no payload
+            uint32_t count; ///< Data count of a batch, subscription count of a subscription, otherwise one
+            uint16_t event; ///< Event
+            uint16_t thread; ///< Index of the recording thread's ring, assigned by the sink
+        };
+        static_assert( sizeof(Record) == 32U, "trace::Record is a fixed 32 byte binary layout" );
+
+        static const size_t cHashBytes = 64U; ///< Leading payload bytes included in Record::payloadHash
+
+#if SUB0PUB_TRACE || SUB0PUB_STD
+        /** @return Steady clock nanoseconds used to calibrate clock() ticks
+         */
+        inline uint64_t nanoseconds()
+        {
+            return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+        }
+
+        /** @return Cheapest monotonic timestamp, the TSC on x86 otherwise steady clock nanoseconds
+         */
+        inline uint64_t clock()
+        {
+#if defined(__GNUG__) && (defined(__x86_64__) || defined(__i386__))
+            return __builtin_ia32_rdtsc();
+#else
+            return nanoseconds();
+#endif
+        }
+#endif
+
+        /** FNV-1a hash of a byte range
+         */
+        inline uint32_t hashBytes( const void* const data, const size_t size )
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            uint32_t hash = 2166136261U;
+            for ( const unsigned char* const iEnd = bytes + size; bytes != iEnd; ++bytes )
+            {
+                hash = (hash ^ *bytes) * 16777619U;
+            }
+            return hash;
+        }
+
+        /** @return Hash of the leading cHashBytes of data
+         */
+        template< typename Data >
+        inline uint32_t payloadHash( const Data& data )
+        { return hashBytes( &data, std::min( sizeof(Data), cHashBytes ) ); }
+
+        /** Trace sink discarding all records
+         */
+        struct NullSink
+        {
+            static void write( const Record& )
+            {}
+        };
+
+#if SUB0PUB_TRACE || SUB0PUB_STD
+        /** Binary trace file layout written by RingSink::dump()
+         * @remark Header followed by Header::recordCount Record, oldest first per thread
+         */
+        struct Header
+        {
+            static const uint32_t cMagic = utility::FourCC<'S','0','T','R'>::value;
+            static const uint32_t cVersion = 1U;
+
+            uint32_t magic; ///< cMagic
+            uint32_t version; ///< cVersion
+            uint32_t recordBytes; ///< sizeof(Record)
+            uint32_t recordCount; ///< Count of records following the header
+            uint64_t startTicks; ///< clock() at startNs
+            uint64_t startNs; ///< nanoseconds() when tracing started
+            uint64_t endTicks; ///< clock() at endNs
+            uint64_t endNs; ///< nanoseconds() at dump
+        };
+
+#if SUB0PUB_THREADS
+        /** Lock-free trace sink recording into a ring per thread
+         * @remark Each thread claims a ring on its first event and is the only writer to it so a record costs a copy and a
+         *  release store. Rings hold the latest cCapacity records and are reused by new threads once their thread exits.
+         * @tparam cCapacity  Records held per thread, a power of two
+         */
+        template< uint32_t cCapacity = 4096U >
+        class RingSinkT
+        {
+            static_assert( (cCapacity != 0U) && ((cCapacity & (cCapacity - 1U)) == 0U), "RingSink capacity must be a power of two" );
+
+        public:
+            static void write( const Record& record )
+            {
+                Ring& ring = *handle().ring;
+                const uint64_t head = ring.head.load( std::memory_order_relaxed );
+                Record& slot = ring.records[head & (cCapacity - 1U)];
+                slot = record;
+                slot.thread = ring.index;
+                ring.head.store( head + 1U, std::memory_order_release );
+            }
+
+            /** Write the retained records of all threads as a Header and records for Decoder
+             * @note Records overwritten while dumping are dropped and a record being written may be torn, dump with tracing
+             *  threads idle for a complete trace
+             * @param stream  Stream to write into
+             * @return True on success, false on a stream write error
+             */
+            static bool dump( OStream& stream )
+            {
+                std::vector<Record> records;
+                for ( const Ring* ring = rings().load(std::memory_order_acquire); ring; ring = ring->next )
+                {
+                    const uint64_t end = ring->head.load( std::memory_order_acquire );
+                    const uint64_t begin = (end > cCapacity) ? (end - cCapacity) : 0U;
+                    const size_t first = records.size();
+                    for ( uint64_t iRecord = begin; iRecord != end; ++iRecord )
+                    {
+                        records.push_back( ring->records[iRecord & (cCapacity - 1U)] );
+                    }
+
+                    // Drop records the writer may have overwritten during the copy
+                    const uint64_t overwritten = ring->head.load( std::memory_order_acquire ) - end;
+                    const size_t dropped = static_cast<size_t>( std::min<uint64_t>( overwritten, end - begin ) );
+                    records.erase( records.begin() + first, records.begin() + first + dropped );
+                }
+
+                Header header = Header();
+                header.magic = Header::cMagic;
+                header.version = Header::cVersion;
+                header.recordBytes = sizeof(Record);
+                header.recordCount = static_cast<uint32_t>( records.size() );
+                header.startTicks = epoch().ticks;
+                header.startNs = epoch().ns;
+                header.endTicks = clock();
+                header.endNs = nanoseconds();
+                return utility::write( stream, header ) 
+                    && (records.empty() || utility::writeBytes( stream, reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record) ));
+            }
+
+        private:
+            struct Ring
+            {
+                explicit Ring( const uint16_t ringIndex )
+                    : head(0U)
+                    , inUse(true)
+                    , index(ringIndex)
+                    , next(0/*nullptr*/)
+                {}
+
+                std::atomic<uint64_t> head; ///< Count of records written
+                std::atomic<bool> inUse; ///< Claimed by a live thread
+                const uint16_t index; ///< Record::thread
+                Ring* next; ///< Next in rings()
+                Record records[cCapacity];
+            };
+
+            /** Thread's claim on a Ring, released for reuse on thread exit
+             */
+            struct Handle
+            {
+                Handle()
+                    : ring( claim() )
+                {}
+
+                ~Handle()
+                { ring->inUse.store( false, std::memory_order_release ); }
+
+                Ring* const ring;
+            };
+
+            struct Epoch
+            {
+                Epoch()
+                    : ticks( clock() )
+                    , ns( nanoseconds() )
+                {}
+
+                const uint64_t ticks;
+                const uint64_t ns;
+            };
+
+            static Handle& handle()
+            {
+                thread_local Handle threadHandle;
+                return threadHandle;
+            }
+
+            static Ring* claim()
+            {
+                (void)epoch(); //< Calibration start ahead of the first record
+                std::atomic<Ring*>& head = rings();
+                uint16_t count = 0U;
+                for ( Ring* ring = head.load(std::memory_order_acquire); ring; ring = ring->next, ++count )
+                {
+                    bool inUse = false;
+                    if ( ring->inUse.compare_exchange_strong( inUse, true, std::memory_order_acquire, std::memory_order_relaxed ) )
+                        return ring;
+                }
+
+                Ring* const ring = new Ring( count ); //< @note Index may repeat when threads race to add rings
+                Ring* next = head.load( std::memory_order_relaxed );
+                do
+                {
+                    ring->next = next;
+                } while ( !head.compare_exchange_weak( next, ring, std::memory_order_release, std::memory_order_relaxed ) );
+                return ring;
+            }
+
+            static std::atomic<Ring*>& rings()
+            {
+                static std::atomic<Ring*> head( 0/*nullptr*/ );
+                return head;
+            }
+
+            static const Epoch& epoch()
+            {
+                static const Epoch start;
+                return start;
+            }
+        };
+
+        typedef RingSinkT<> RingSink; ///< Default trace sink
+#endif
+
+        /** Offline reader of a RingSink::dump() trace
+         */
+        class Decoder
+        {
+        public:
+            Decoder()
+                : header_()
+                , records_()
+            {}
+
+            /** Parse a dumped trace
+             * @param data  Trace file content
+             * @param size  Bytes of 'data'
+             * @return False when data is not a complete trace of this version
+             */
+            bool parse( const char* const data, const size_t size )
+            {
+                records_.clear();
+                if ( size < sizeof(Header) )
+                    return false;
+
+                std::memcpy( &header_, data, sizeof(Header) );
+                if ( (header_.magic != Header::cMagic) || (header_.version != Header::cVersion) 
+                    || (header_.recordBytes != sizeof(Record)) || ((size - sizeof(Header)) / sizeof(Record) < header_.recordCount) )
+                    return false;
+
+                records_.resize( header_.recordCount );
+                if ( header_.recordCount )
+                    std::memcpy( records_.data(), data + sizeof(Header), header_.recordCount * sizeof(Record) );
+                std::stable_sort( records_.begin(), records_.end(), &Decoder::isEarlier ); //< Interleave threads
+                return true;
+            }
+
+            const Header& header() const
+            { return header_; }
+
+            /** @return Records of all threads in timestamp order
+             */
+            const std::vector<Record>& records() const
+            { return records_; }
+
+            /** @return Nanoseconds from the first record to a Record::timestamp
+             */
+            double nanoseconds( const uint64_t timestamp ) const
+            {
+                const double ticks = static_cast<double>( header_.endTicks - header_.startTicks );
+                const double scale = (ticks > 0.0) ? (static_cast<double>( header_.endNs - header_.startNs ) / ticks) : 1.0;
+                const uint64_t first = records_.empty() ? timestamp : records_.front().timestamp;
+                return static_cast<double>(timestamp - first) * scale;
+            }
+
+            /** @return Printable name of a Record::event
+             */
+            static const char* eventName( const uint16_t event )
+            {
+                switch ( event )
+                {
+                case cSubscription: return "subscription";
+                case cPublication: return "publication";
+                case cPublish: return "publish";
+                case cPublishBatch: return "publish-batch";
+                case cReceive: return "receive";
+                default: return "unknown";
+                }
+            }
+
+            /** Write records as text lines, one per record
+             * @param stream  Stream to write into
+             */
+            void print( OStream& stream ) const
+            {
+                for ( const Record& record : records_ )
+                {
+                    utility::print( stream, "%.0f ns thread=%u %s type=%u address=0x%llx hash=0x%08x count=%u\n"
+                        , nanoseconds(record.timestamp), static_cast<unsigned>(record.thread), eventName(record.event), record.typeId
+                        , static_cast<unsigned long long>(record.address), record.payloadHash, record.count );
+                }
+            }
+
+        private:
+            static bool isEarlier( const Record& lhs, const Record& rhs )
+            { return lhs.timestamp < rhs.timestamp; }
+
+        private:
+            Header header_; ///< Header of the parsed trace
+            std::vector<Record> records_; ///< Records in timestamp order
+        };
+#endif
+    } // END: trace
+
+    /** Internal configured details for tracing and error handling
+     */
+    namespace detail
+    {
+        /** Contiguous subscription table of compile-time fixed capacity
+         * @tparam Entry  Subscription entry type stored in the table
+         * @tparam cCapacity  Maximum count of entries
+         */
+        template< typename Entry, uint32_t cCapacity >
+        class FixedSubscriptionTable
+        {
+        public:
+            FixedSubscriptionTable()
+                : size_(0U)
+                , entries_()
+            {}
+
+            /** @return Count of entries the table can ever hold
+             */
+            static uint32_t maxSize()
+            { return cCapacity; }
+
+            uint32_t size() const
+            { return size_; }
+
+            const Entry* begin() const
+            { return entries_; }
+
+            const Entry* end() const
+            { return entries_ + size_; }
+
+            /** Scoped read access to the table entries for publish
+             */
+            class Reader
+            {
+            public:
+                explicit Reader( const FixedSubscriptionTable& table )
+                    : table_(table)
+                {}
+
+                const Entry* begin() const
+                { return table_.begin(); }
+
+                const Entry* end() const
+                { return table_.end(); }
+
+            private:
+                const FixedSubscriptionTable& table_;
+            };
+
+            /** Insert entry after all entries of equal or higher priority
+             * @return False if the table is full and the entry was not added
+             */
+            bool insert( const Entry& entry )
+            {
+                if ( size_ >= cCapacity )
+                    return false;
+
+                Entry* const iEnd = entries_ + size_;
+                Entry* const iPosition = std::upper_bound( entries_, iEnd, entry, &Entry::precedes );
+                std::copy_backward( iPosition, iEnd, iEnd + 1 );
+                *iPosition = entry;
+                ++size_;
+                return true;
+            }
+
+            /** Remove entry preserving the order of remaining entries
+             * @return False if entry was not found in the table
+             */
+            bool remove( const Entry& entry )
+            {
+                Entry* const iEnd = entries_ + size_;
+                Entry* const iPend = std::remove( entries_, iEnd, entry );
+                if ( iPend == iEnd )
+                    return false;
+
+                size_ = static_cast<uint32_t>(iPend - entries_);
+                return true;
+            }
+
+        private:
+            uint32_t size_; ///< Count of entries_ in use
+            Entry entries_[cCapacity]; ///< Subscription table
+        };
+
+        /** Contiguous subscription table that starts in inline storage and moves to a larger heap array when full
+         * @remark Allocation only occurs when inserting, iteration walks a single contiguous array. Storage outgrown while a
+         *  Reader is iterating e.g. subscribing from within receive() is retired and freed once the last Reader is destroyed.
+         * @tparam Entry  Subscription entry type stored in the table
+         * @tparam cInlineCapacity  Count of entries held before the first heap allocation
+         */
+        template< typename Entry, uint32_t cInlineCapacity >
+        class GrowableSubscriptionTable
+        {
+        public:
+            GrowableSubscriptionTable()
+                : size_(0U)
+                , capacity_(cInlineCapacity)
+                , readers_(0U)
+                , heap_(0/*nullptr*/)
+                , retired_(0/*nullptr*/)
+                , inline_()
+            {}
+
+            ~GrowableSubscriptionTable()
+            {
+                reclaim();
+                delete[] heap_;
+                heap_ = 0/*nullptr*/; //< @note Tolerate static Subscribe<> destruction after this table
+                size_ = 0U;
+                capacity_ = cInlineCapacity;
+            }
+
+            /** @return Count of entries the table can ever hold
+             */
+            static uint32_t maxSize()
+            { return UINT32_MAX; }
+
+            uint32_t size() const
+            { return size_; }
+
+            const Entry* begin() const
+            { return heap_ ? heap_ : inline_; }
+
+            const Entry* end() const
+            { return begin() + size_; }
+
+            /** Scoped read access to the table entries for publish
+             */
+            class Reader
+            {
+            public:
+                explicit Reader( const GrowableSubscriptionTable& table )
+                    : table_(table)
+                { ++table_.readers_; }
+
+                ~Reader()
+                {
+                    if ( --table_.readers_ == 0U )
+                        table_.reclaim();
+                }
+
+                const Entry* begin() const
+                { return table_.begin(); }
+
+                const Entry* end() const
+                { return table_.end(); }
+
+            private:
+                Reader( const Reader& ); ///< Non-copyable, counted in the table
+                Reader& operator=( const Reader& ); ///< Non-copyable, counted in the table
+
+                const GrowableSubscriptionTable& table_;
+            };
+
+            /** Insert entry after all entries of equal or higher priority, doubling storage when full
+             * @return False if the capacity cannot double and the entry was not added
+             */
+            bool insert( const Entry& entry )
+            {
+                if ( size_ >= capacity_ )
+                {
+                    if ( capacity_ > (UINT32_MAX / 2U) )
+                        return false;
+
+                    const uint32_t capacity = capacity_ * 2U;
+                    Entry* const heap = new Entry[capacity];
+                    std::copy( begin(), end(), heap );
+                    retire( heap_ );
+                    heap_ = heap;
+                    capacity_ = capacity;
+                }
+
+                Entry* const iEnd = data() + size_;
+                Entry* const iPosition = std::upper_bound( data(), iEnd, entry, &Entry::precedes );
+                std::copy_backward( iPosition, iEnd, iEnd + 1 );
+                *iPosition = entry;
+                ++size_;
+                return true;
+            }
+
+            /** Remove entry preserving the order of remaining entries
+             * @note Storage is retained for reuse
+             * @return False if entry was not found in the table
+             */
+            bool remove( const Entry& entry )
+            {
+                Entry* const iBegin = data();
+                Entry* const iEnd = iBegin + size_;
+                Entry* const iPend = std::remove( iBegin, iEnd, entry );
+                if ( iPend == iEnd )
+                    return false;
+
+                size_ = static_cast<uint32_t>(iPend - iBegin);
+                return true;
+            }
+
+        private:
+            GrowableSubscriptionTable( const GrowableSubscriptionTable& ); ///< Non-copyable
+            GrowableSubscriptionTable& operator=( const GrowableSubscriptionTable& ); ///< Non-copyable
+
+            Entry* data()
+            { return heap_ ? heap_ : inline_; }
+
+            /** Outgrown heap storage awaiting the end of iteration
+             */
+            struct Retired
+            {
+                Entry* entries;
+                Retired* next;
+            };
+
+            /** Free outgrown storage, or defer until no Reader may be iterating it
+             */
+            void retire( Entry* const entries )
+            {
+                if ( !entries )
+                    return;
+
+                if ( readers_ == 0U )
+                {
+                    delete[] entries;
+                }
+                else
+                {
+                    Retired* const retired = new Retired();
+                    retired->entries = entries;
+                    retired->next = retired_;
+                    retired_ = retired;
+                }
+            }
+
+            /** Free storage retired while iterating
+             */
+            void reclaim() const
+            {
+                while ( retired_ )
+                {
+                    Retired* const retired = retired_;
+                    retired_ = retired->next;
+                    delete[] retired->entries;
+                    delete retired;
+                }
+            }
+
+        private:
+            uint32_t size_; ///< Count of entries in use
+            uint32_t capacity_; ///< Count of entries storage can hold
+            mutable uint32_t readers_; ///< Count of Reader instances, nested when publishing from within receive()
+            Entry* heap_; ///< Heap storage once inline_ is outgrown @note Not a self-pointer to inline_ so zero-initialised state is valid
+            mutable Retired* retired_; ///< Storage outgrown while readers_ was non-zero
+            Entry inline_[cInlineCapacity]; ///< Initial storage
+        };
+
+#if SUB0PUB_THREADS
+        /** Epoch based grace-period detection for reclaiming memory read without locks
+         * @remark Readers increment the counter of the current epoch parity for the duration of the read. 
+         *  synchronize() flips the epoch twice, waiting for each parity to drain, after which no reader can hold 
+         *  a pointer that was unpublished before synchronize() was called.
+         */
+        class EpochDomain
+        {
+        public:
+            EpochDomain()
+                : epoch_(0U)
+                , readers_()
+            {}
+
+            /** Scoped read-side critical section, linked per thread so isReading() recognises the thread's own readers
+             * @note Sections on a thread nest and end in reverse order of beginning
+             */
+            class Section
+            {
+            public:
+                explicit Section( EpochDomain& domain )
+                    : domain_(domain)
+                    , parity_(domain.enter())
+                    , next_(top())
+                { top() = this; }
+
+                ~Section()
+                {
+                    top() = next_;
+                    domain_.leave( parity_ );
+                }
+
+            private:
+                Section( const Section& ); ///< Non-copyable
+                Section& operator=( const Section& ); ///< Non-copyable
+
+                friend class EpochDomain;
+
+                /** @return Innermost section of the calling thread
+                 */
+                static Section*& top()
+                {
+                    static thread_local Section* section = 0/*nullptr*/;
+                    return section;
+                }
+
+            private:
+                EpochDomain& domain_;
+                const uint32_t parity_; ///< Token returned by enter()
+                Section* const next_; ///< Enclosing section of the thread
+            };
+
+            /** @return True when the calling thread is within a Section of this domain e.g. from receive()
+             */
+            bool isReading() const
+            {
+                for ( const Section* iSection = Section::top(); iSection; iSection = iSection->next_ )
+                {
+                    if ( &iSection->domain_ == this )
+                        return true;
+                }
+                return false;
+            }
+
+            /** Begin read-side critical section
+             * @return Token to pass to leave()
+             */
+            uint32_t enter()
+            {
+                const uint32_t parity = epoch_.load() & 1U;
+                readers_[parity].count.fetch_add(1U);
+                return parity;
+            }
+
+            /** End read-side critical section
+             * @param parity  Token returned by enter()
+             */
+            void leave( const uint32_t parity )
+            { readers_[parity].count.fetch_sub(1U, std::memory_order_release); }
+
+            /** Block until all read-side critical sections that began before this call have ended
+             * @warning Must not be called from within a read-side critical section on the same thread i.e. from receive()
+             */
+            void synchronize()
+            {
+                for ( uint32_t iFlip = 0U; iFlip < 2U; ++iFlip )
+                {
+                    const uint32_t parity = epoch_.fetch_add(1U) & 1U;
+                    while ( readers_[parity].count.load() != 0U ) //< @note seq_cst orders against the snapshot swap, a concurrent enter() sees the new snapshot or is waited for
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+        private:
+            /** Reader count padded to avoid false sharing between the parities
+             * @note Padded rather than over-aligned so tables in heap allocated broker state are correctly aligned by new
+             */
+            struct Readers
+            {
+                Readers() : count(0U) {}
+                std::atomic<uint32_t> count;
+                char padding[64U - sizeof(std::atomic<uint32_t>)]; ///< Keeps the parities on separate cache lines
+            };
+
+            std::atomic<uint32_t> epoch_; ///< Current epoch, parity selects readers_ entry
+            Readers readers_[2U]; ///< Active reader count per epoch parity
+        };
+
+        /** Subscription table read lock-free by publishers from immutable snapshots
+         * @remark Subscribe and unsubscribe are serialised by a mutex, copy the current snapshot with the change applied
+         *  and swap it in. The previous snapshot is retired and, once the mutex is released, reclaimed after a grace period
+         *  so no publisher can still be reading it.
+         * @note Once remove() returns no publish will call the removed entry, so subscribers may be safely destroyed.
+         *  Called from within receive() i.e. while this thread reads the table, insert() and remove() do not wait: a grace
+         *  period cannot end while the caller is a reader. Snapshots retired then are reclaimed by a later insert() or remove()
+         *  outside receive(), and a publish in progress on another thread may still deliver to an entry removed from a handler.
+         *  Subscribe<Data> therefore registers only once the most-derived subscriber is constructed @see Subscribed.
+         *  FunctionSubscribe declared as the last member of its owner is registered once the owner's other members are constructed.
+         * @tparam Entry  Subscription entry type stored in the table @note Must be trivially copyable
+         */
+        template< typename Entry >
+        class ConcurrentSubscriptionTable
+        {
+            /** Immutable table contents followed in the same allocation by 'size' entries
+             */
+            struct alignas(Entry) Snapshot
+            {
+                uint32_t size;
+                Snapshot* retiredNext; ///< Older retired snapshot
+                uint64_t retiredAt; ///< Retire sequence, reclaimable after a grace period begun later
+
+                Entry* entries()
+                { return reinterpret_cast<Entry*>(this + 1); }
+
+                static Snapshot* create( const uint32_t size )
+                {
+                    Snapshot* const snapshot = static_cast<Snapshot*>( ::operator new( sizeof(Snapshot) + (size * sizeof(Entry)) ) );
+                    snapshot->size = size;
+                    return snapshot;
+                }
+
+                static void destroy( Snapshot* const snapshot )
+                { ::operator delete( snapshot ); }
+            };
+
+            static_assert( std::is_trivially_copyable<Entry>::value, "Concurrent subscription table entries are copied as raw memory" );
+            static_assert( (sizeof(Snapshot) % alignof(Entry)) == 0U, "Snapshot entries must be aligned" );
+
+        public:
+            ConcurrentSubscriptionTable()
+                : snapshot_(0/*nullptr*/)
+                , size_(0U)
+                , epoch_()
+                , writeMutex_()
+                , retired_(0/*nullptr*/)
+                , retireCount_(0U)
+            {}
+
+            ~ConcurrentSubscriptionTable()
+            {
+                Snapshot::destroy( snapshot_.exchange(0/*nullptr*/) );
+                destroy( retired_ );
+            }
+
+            /** @return Count of entries the table can ever hold
+             */
+            static uint32_t maxSize()
+            { return UINT32_MAX; }
+
+            /** @return Count of entries in the current snapshot
+             */
+            uint32_t size() const
+            { return size_.load(std::memory_order_relaxed); }
+
+            /** Scoped lock-free read access to the current snapshot for publish
+             * @remark The snapshot is guaranteed to stay valid until the Reader is destroyed
+             */
+            class Reader
+            {
+            public:
+                explicit Reader( const ConcurrentSubscriptionTable& table )
+                    : section_(const_cast<ConcurrentSubscriptionTable&>(table).epoch_)
+                    , begin_(0/*nullptr*/)
+                    , end_(0/*nullptr*/)
+                {
+                    Snapshot* const snapshot = table.snapshot_.load();
+                    if ( snapshot )
+                    {
+                        begin_ = snapshot->entries();
+                        end_ = begin_ + snapshot->size;
+                    }
+                }
+
+                const Entry* begin() const
+                { return begin_; }
+
+                const Entry* end() const
+                { return end_; }
+
+            private:
+                Reader( const Reader& ); ///< Non-copyable
+                Reader& operator=( const Reader& ); ///< Non-copyable
+
+            private:
+                const EpochDomain::Section section_; ///< Epoch read-side section held for the lifetime of the Reader
+                const Entry* begin_;
+                const Entry* end_;
+            };
+
+            /** Publish a snapshot with entry inserted after all entries of equal or higher priority
+             * @return Always true
+             */
+            bool insert( const Entry& entry )
+            {
+                std::unique_lock<std::mutex> lock(writeMutex_);
+                Snapshot* const previous = snapshot_.load(std::memory_order_relaxed);
+                const uint32_t previousSize = previous ? previous->size : 0U;
+
+                Snapshot* const next = Snapshot::create( previousSize + 1U );
+                if ( previous )
+                {
+                    const Entry* const iBegin = previous->entries();
+                    const Entry* const iEnd = iBegin + previousSize;
+                    const Entry* const iPosition = std::upper_bound( iBegin, iEnd, entry, &Entry::precedes );
+                    Entry* const iNext = std::copy( iBegin, iPosition, next->entries() );
+                    *iNext = entry;
+                    std::copy( iPosition, iEnd, iNext + 1 );
+                }
+                else
+                {
+                    next->entries()[0U] = entry;
+                }
+
+                replace( lock, previous, next );
+                return true;
+            }
+
+            /** Publish a snapshot with entry removed preserving the order of remaining entries
+             * @return False if entry was not found in the table
+             */
+            bool remove( const Entry& entry )
+            {
+                std::unique_lock<std::mutex> lock(writeMutex_);
+                Snapshot* const previous = snapshot_.load(std::memory_order_relaxed);
+                if ( !previous )
+                    return false;
+
+                const Entry* const iBegin = previous->entries();
+                const Entry* const iEnd = iBegin + previous->size;
+                const uint32_t removeCount = static_cast<uint32_t>( std::count( iBegin, iEnd, entry ) );
+                if ( removeCount == 0U )
+                    return false;
+
+                Snapshot* next = 0/*nullptr*/;
+                if ( previous->size > removeCount )
+                {
+                    next = Snapshot::create( previous->size - removeCount );
+                    std::remove_copy( iBegin, iEnd, next->entries(), entry );
+                }
+
+                replace( lock, previous, next );
+                return true;
+            }
+
+        private:
+            ConcurrentSubscriptionTable( const ConcurrentSubscriptionTable& ); ///< Non-copyable
+            ConcurrentSubscriptionTable& operator=( const ConcurrentSubscriptionTable& ); ///< Non-copyable
+
+            /** Swap in next snapshot and retire previous, then release the lock and reclaim after the grace period
+             * @remark The grace period is waited for without the lock so a handler on another thread may subscribe meanwhile
+             */
+            void replace( std::unique_lock<std::mutex>& lock, Snapshot* const previous, Snapshot* const next )
+            {
+                snapshot_.store( next );
+                size_.store( next ? next->size : 0U, std::memory_order_relaxed );
+                if ( !previous )
+                    return;
+
+                previous->retiredNext = retired_;
+                previous->retiredAt = ++retireCount_;
+                retired_ = previous;
+                const uint64_t retiredAt = retireCount_;
+                lock.unlock();
+
+                if ( epoch_.isReading() )
+                    return; //< Within receive(), reclaimed by a later insert() or remove()
+                epoch_.synchronize();
+
+                lock.lock();
+                Snapshot** iLink = &retired_;
+                while ( *iLink && ((*iLink)->retiredAt > retiredAt) )
+                {
+                    iLink = &(*iLink)->retiredNext; //< Retired by another writer since, its grace period is its own
+                }
+                Snapshot* const reclaimable = *iLink;
+                *iLink = 0/*nullptr*/;
+                lock.unlock();
+                destroy( reclaimable );
+            }
+
+            /** Destroy a list of retired snapshots
+             */
+            static void destroy( Snapshot* retired )
+            {
+                while ( retired )
+                {
+                    Snapshot* const next = retired->retiredNext;
+                    Snapshot::destroy( retired );
+                    retired = next;
+                }
+            }
+
+        private:
+            std::atomic<Snapshot*> snapshot_; ///< Current immutable table, nullptr when empty
+            std::atomic<uint32_t> size_; ///< Entry count of snapshot_ readable without entering the epoch
+            EpochDomain epoch_; ///< Readers of snapshot_
+            std::mutex writeMutex_; ///< Serialises insert/remove and guards retired_
+            Snapshot* retired_; ///< Unpublished snapshots awaiting reclamation, newest first
+            uint64_t retireCount_; ///< Snapshots retired, orders retired_
+        };
+#endif
+
+        /** Selects subscription table implementation from BrokerTraits
+         * @tparam Entry  Subscription entry type stored in the table
+         * @tparam Traits  BrokerTraits<Data> of the broker owning the table
+         */
+        template< typename Entry, typename Traits, bool cConcurrent = Traits::cConcurrent >
+        struct SubscriptionTable
+        {
+            static_assert( !cConcurrent, "BrokerTraits::cConcurrent requires SUB0PUB_THREADS" );
+
+            typedef typename std::conditional< Traits::cGrowable
+                , GrowableSubscriptionTable<Entry, Traits::cMaxSubscriptions>
+                , FixedSubscriptionTable<Entry, Traits::cMaxSubscriptions> >::type type;
+        };
+
+#if SUB0PUB_THREADS
+        template< typename Entry, typename Traits >
+        struct SubscriptionTable<Entry, Traits, true>
+        {
+            typedef ConcurrentSubscriptionTable<Entry> type;
+        };
+#endif
+
+        /** Provides debug assertion/exception checks for Broker<>
+         * @tparam cMessageTrace   Enable tracing of broker events
+         * @tparam cDoAssert         Enable assertion tests for invalid parameters
+         * @tparam TraceSink  Receiver of trace::Record for broker events, with static write( const trace::Record& )
+         */
+        template< const bool cMessageTrace = false, const bool cDoAssert = true, typename TraceSink = trace::NullSink >
+        struct CheckT
+        {
+            /** Diagnose creation of new subscriber
+             * @param broker  Broker instance that manages the connection
+             * @param subscription  Subscription to be registered into the broker
+             * @param subscriptionCount  Count of existing registered subscriptions on the broker
+             * @param subscriptionCapacity  Count specifying subscriptionCount limit for the broker @note A full table is reported by Broker in every build
+             */
+            template<typename Data, typename Channel>
+            inline static void onSubscription( const Broker<Data, Channel>& /*broker*/, const Subscription<Data>& subscription, const uint32_t subscriptionCount, const uint32_t /*subscriptionCapacity*/ )
+            {
+                if ( cDoAssert )
+                {
+                    assert( subscription.receive );
+                }
+                if ( cMessageTrace )
+                {
+                    write<Data>( trace::cSubscription, subscription.context, 0U, subscriptionCount + 1U );
+                }
+            }
+
+            /** Diagnose creation of new publisher
+             * @param publisher  Publisher to be registered into the broker
+             * @param broker  Broker instance that manages the connection
+             * @param publisherCount  Count of existing registered publishers on the broker
+             * @param publisherCapacity  Count specifying publisherCount limit for the broker
+             */
+            template<typename Data, typename Channel>
+            inline static void onPublication( Publish<Data, Channel>* publisher, const Broker<Data, Channel>& /*broker*/, const uint32_t publisherCount, const uint32_t publisherCapacity )
+            {
+                (void)publisherCapacity; //< Only read by assert, unused when NDEBUG
+                if ( cDoAssert )
+                {
+                    assert( publisher );
+                    assert( publisherCount < publisherCapacity );
+                }
+                if ( cMessageTrace )
+                {
+                    write<Data>( trace::cPublication, publisher, 0U, publisherCount + 1U );
+                }
+            }
+
+            /** Diagnose data publish event
+             * @param publisher  Publisher that is sending the data
+             * @param data  The data to be published
+             */
+            template<typename Data, typename Channel>
+            inline static void onPublish( const Publish<Data, Channel>& publisher, const Data& data )
+            {
+                if ( cMessageTrace )
+                {
+                    write<Data>( trace::cPublish, &publisher, trace::payloadHash(data), 1U );
+                }
+            }
+
+            /** Diagnose batch data publish event
+             * @param publisher  Publisher that is sending the data
+             * @param data  First of the data to be published
+             * @param count  Count of data to be published
+             */
+            template<typename Data, typename Channel>
+            inline static void onPublishBatch( const Publish<Data, Channel>& publisher, const Data* data, const size_t count )
+            {
+                if ( cDoAssert )
+                {
+                    assert( data || (count == 0U) );
+                }
+                if ( cMessageTrace )
+                {
+                    write<Data>( trace::cPublishBatch, &publisher, count ? trace::payloadHash(*data) : 0U, static_cast<uint32_t>(count) );
+                }
+            }
+
+            /** Diagnose data receive event
+             * @param subscription  Subscription that is receiving the data
+             * @param data  The data that is received
+             */
+            template<typename Data>
+            static void 
+#if __GNUG__ /// @todo GCC 7.2(TBC) publish(const Data & data) bug on inlining this function and calling detail::Check::onReceive()?
+                __attribute__((noinline)) 
+#endif
+                onReceive( const Subscription<Data>& subscription, const Data& data )
+            {
+                if ( cDoAssert )
+                {
+                    if ( subscription.receive == nullptr )
+                    {
+                       assert( subscription.receive );
+                    }
+                }
+                if ( cMessageTrace )
+                {
+                    write<Data>( trace::cReceive, subscription.context, trace::payloadHash(data), 1U );
+                }
+            }
+
+        private:
+            /** Write a trace record for a Data event to the TraceSink
+             */
+            template<typename Data>
+            inline static void write( const trace::Event event, const void* const address, const uint32_t payloadHash, const uint32_t count )
+            {
+                static_assert( !cMessageTrace || SUB0PUB_TRACE || SUB0PUB_STD, "Broker event tracing requires SUB0PUB_TRACE" );
+                trace::Record record;
+#if SUB0PUB_TRACE || SUB0PUB_STD
+                record.timestamp = trace::clock();
+#else
+                record.timestamp = 0U;
+#endif
+                record.address = reinterpret_cast<uintptr_t>(address);
+#if SUB0PUB_TYPEIDNAME
+                record.typeId = Broker<Data>::typeId();
+#else
+                record.typeId = TypeName<Data>::id();
+#endif
+                record.payloadHash = payloadHash;
+                record.count = count;
+                record.event = static_cast<uint16_t>(event);
+                record.thread = 0U;
+                TraceSink::write( record );
+            }
+        };
+
+        /** Runtime checker type with support for assert/exception/trace etc
+         */
+        typedef CheckT<SUB0PUB_TRACE,SUB0PUB_ASSERT,SUB0PUB_TRACE_SINK> Check;
+    } // END: detail
+
+#if SUB0PUB_STATS
+    /** Broker statistics snapshots and dumps
+     * @remark Enabled by SUB0PUB_STATS. Counters are kept per thread with relaxed atomics so the publish path never
+     *  contends, snapshot() sums them for every Broker<Data> that has been used.
+     */
+    namespace stats
+    {
+        static const uint32_t cHistogramBuckets = 32U; ///< Receive time buckets, bucket i counts times in [2^i, 2^(i+1)) ns and the last bucket every longer time
+        static const uint32_t cChannelBytes = 64U; ///< Bytes of a channel label including the terminator
+
+        /** Receive times of one subscriber
+         */
+        struct SubscriberSnapshot
+        {
+            const void* subscriber; ///< Subscription context, the subscriber object or user pointer
+            uint64_t receiveCount; ///< Count of timed receive calls
+            uint64_t receiveNs; ///< Total nanoseconds in receive calls
+            uint64_t buckets[cHistogramBuckets]; ///< Count of receive calls per log2 nanosecond bucket, the last is unbounded
+        };
+
+        /** Statistics of one Broker<Data>
+         */
+        struct BrokerSnapshot
+        {
+            const char* typeName; ///< Registered type name or nullptr @see SUB0_TYPENAME
+            uint32_t typeId; ///< Registered type id or zero
+            const char* channel; ///< Empty for the default channel, "#<id>" for a runtime channel or else the channel tag type name
+            uint64_t publishCount; ///< Count of Data published
+            uint64_t deliveryCount; ///< Count of Data handed to subscribers, including those rejected by filter()
+            uint64_t filterRejectCount; ///< Count of Data rejected by subscriber filter()
+            uint64_t maxFanoutNs; ///< Longest time to deliver one publish to all subscribers
+            std::vector<SubscriberSnapshot> subscribers; ///< Receive times per current subscriber
+        };
+    } // END: stats
+
+    namespace detail
+    {
+        /** @return Monotonic nanoseconds for interval timing
+         */
+        inline uint64_t statsClock()
+        {
+            return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+        }
+
+        /** Increment a counter only ever written by the calling thread
+         * @note A relaxed load and store, avoiding the locked read-modify-write of fetch_add
+         */
+        inline void increment( std::atomic<uint64_t>& counter, const uint64_t count = 1U )
+        {
+            counter.store( counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed );
+        }
+
+        /** Receive time histogram of a subscriber, reused after the subscriber unsubscribes
+         * @note Subscribers may be delivered to from several threads so updates are relaxed read-modify-writes
+         */
+        struct ReceiveStats
+        {
+            ReceiveStats()
+                : context(nullptr)
+                , next(nullptr)
+                , receiveNs(0U)
+                , buckets()
+            {}
+
+            void record( const uint64_t nanoseconds )
+            {
+                receiveNs.fetch_add( nanoseconds, std::memory_order_relaxed );
+                buckets[bucketOf(nanoseconds)].fetch_add( 1U, std::memory_order_relaxed );
+            }
+
+            void reset()
+            {
+                receiveNs.store( 0U, std::memory_order_relaxed );
+                for ( uint32_t iBucket = 0U; iBucket < stats::cHistogramBuckets; ++iBucket )
+                {
+                    buckets[iBucket].store( 0U, std::memory_order_relaxed );
+                }
+            }
+
+            static uint32_t bucketOf( const uint64_t nanoseconds )
+            {
+#if __GNUG__
+                const uint32_t bucket = 63U - static_cast<uint32_t>( __builtin_clzll(nanoseconds | 1U) );
+#else
+                uint32_t bucket = 0U;
+                for ( uint64_t value = nanoseconds >> 1U; value != 0U; value >>= 1U )
+                    ++bucket;
+#endif
+                return (bucket < stats::cHistogramBuckets) ? bucket : (stats::cHistogramBuckets - 1U);
+            }
+
+            std::atomic<const void*> context; ///< Subscriber measured, nullptr when free for reuse
+            ReceiveStats* next; ///< Next in BrokerStats::receivers
+            std::atomic<uint64_t> receiveNs;
+            std::atomic<uint64_t> buckets[stats::cHistogramBuckets];
+        };
+
+        /** Broker counters written by a single thread, reused after the thread exits
+         */
+        struct StatsShard
+        {
+            StatsShard()
+                : publishCount(0U)
+                , deliveryCount(0U)
+                , filterRejectCount(0U)
+                , maxFanoutNs(0U)
+                , inUse(true)
+                , next(nullptr)
+            {}
+
+            std::atomic<uint64_t> publishCount;
+            std::atomic<uint64_t> deliveryCount;
+            std::atomic<uint64_t> filterRejectCount;
+            std::atomic<uint64_t> maxFanoutNs;
+            std::atomic<bool> inUse; ///< Claimed by a live thread
+            StatsShard* next; ///< Next in BrokerStats::shards
+        };
+
+        /** Statistics of a Broker<Data, Channel> registered in the process-wide list enumerated by stats::snapshot()
+         * @note Shards and receive histograms are never freed so readers need no synchronisation beyond acquire loads
+         */
+        struct BrokerStats
+        {
+            typedef const char* (*TypeNameFunction)();
+            typedef uint32_t (*TypeIdFunction)();
+
+            /** Register statistics of a channel
+             * @param channelLabel  Label of the channel, nullptr for the default channel. A label too long for the snapshot keeps
+             *  its end, which holds the tag type in a compiler generated name.
+             */
+            BrokerStats( const TypeNameFunction typeNameFunction, const TypeIdFunction typeIdFunction, const char* const channelLabel )
+                : typeName(typeNameFunction)
+                , typeId(typeIdFunction)
+                , shards(nullptr)
+                , receivers(nullptr)
+                , next(nullptr)
+            {
+                const size_t length = channelLabel ? std::strlen(channelLabel) : 0U;
+                const size_t skip = (length < stats::cChannelBytes) ? 0U : (length - (stats::cChannelBytes - 1U));
+                std::memcpy( channel, channelLabel + skip, length - skip ); //< @note Zero bytes from a nullptr label
+                channel[length - skip] = '\0';
+
+                std::atomic<BrokerStats*>& head = registry();
+                next = head.load( std::memory_order_relaxed );
+                while ( !head.compare_exchange_weak( next, this, std::memory_order_release, std::memory_order_relaxed ) )
+                {}
+            }
+
+            /** @return Head of the list of all BrokerStats
+             */
+            static std::atomic<BrokerStats*>& registry()
+            {
+                static std::atomic<BrokerStats*> head( nullptr );
+                return head;
+            }
+
+            /** Claim a free shard for the calling thread or add a new one
+             */
+            StatsShard* claimShard()
+            {
+                for ( StatsShard* shard = shards.load(std::memory_order_acquire); shard; shard = shard->next )
+                {
+                    bool inUse = false;
+                    if ( shard->inUse.compare_exchange_strong( inUse, true, std::memory_order_acquire, std::memory_order_relaxed ) )
+                        return shard;
+                }
+                return push( shards, new StatsShard() );
+            }
+
+            /** Claim a receive histogram for subscriber 'context'
+             */
+            ReceiveStats* claimReceiver( const void* const context )
+            {
+                for ( ReceiveStats* receiver = receivers.load(std::memory_order_acquire); receiver; receiver = receiver->next )
+                {
+                    const void* free = nullptr;
+                    if ( receiver->context.compare_exchange_strong( free, context, std::memory_order_acq_rel, std::memory_order_relaxed ) )
+                    {
+                        receiver->reset();
+                        return receiver;
+                    }
+                }
+                ReceiveStats* const receiver = new ReceiveStats();
+                receiver->context.store( context, std::memory_order_relaxed );
+                return push( receivers, receiver );
+            }
+
+            /** Release the receive histogram of subscriber 'context' for reuse
+             */
+            void releaseReceiver( const void* const context )
+            {
+                for ( ReceiveStats* receiver = receivers.load(std::memory_order_acquire); receiver; receiver = receiver->next )
+                {
+                    const void* expected = context;
+                    if ( receiver->context.compare_exchange_strong( expected, nullptr, std::memory_order_acq_rel, std::memory_order_relaxed ) )
+                        return;
+                }
+            }
+
+            template< typename Node >
+            static Node* push( std::atomic<Node*>& list, Node* const node )
+            {
+                node->next = list.load( std::memory_order_relaxed );
+                while ( !list.compare_exchange_weak( node->next, node, std::memory_order_release, std::memory_order_relaxed ) )
+                {}
+                return node;
+            }
+
+            const TypeNameFunction typeName;
+            const TypeIdFunction typeId;
+            char channel[stats::cChannelBytes]; ///< Channel label @see stats::BrokerSnapshot::channel
+            std::atomic<StatsShard*> shards; ///< Counters per thread
+            std::atomic<ReceiveStats*> receivers; ///< Receive histograms per subscriber
+            BrokerStats* next; ///< Next in registry()
+        };
+
+        /** Thread's claims on the StatsShard of each channel it published on, released on thread exit
+         * @remark Looks up the channel published previously first, so a thread publishing one channel at a time never scans
+         */
+        class StatsShardCache
+        {
+        public:
+            /** @return Calling thread's shard of stats
+             */
+            static StatsShard& shard( BrokerStats& stats )
+            {
+                thread_local StatsShardCache cache;
+                if ( (cache.last_ < cache.entries_.size()) && (cache.entries_[cache.last_].stats == &stats) )
+                    return *cache.entries_[cache.last_].shard;
+
+                for ( cache.last_ = 0U; cache.last_ < cache.entries_.size(); ++cache.last_ )
+                {
+                    if ( cache.entries_[cache.last_].stats == &stats )
+                        return *cache.entries_[cache.last_].shard;
+                }
+                const Entry entry = { &stats, stats.claimShard() };
+                cache.entries_.push_back( entry );
+                return *entry.shard;
+            }
+
+        private:
+            struct Entry
+            {
+                BrokerStats* stats;
+                StatsShard* shard;
+            };
+
+            StatsShardCache()
+                : last_(0U)
+                , entries_()
+            {}
+
+            ~StatsShardCache()
+            {
+                for ( size_t iEntry = 0U; iEntry < entries_.size(); ++iEntry )
+                {
+                    entries_[iEntry].shard->inUse.store( false, std::memory_order_release );
+                }
+            }
+
+            size_t last_; ///< Entry of the channel published previously
+            std::vector<Entry> entries_; ///< Shard claimed per channel
+        };
+    } // END: detail
+#endif
+
+    namespace detail
+    {
+        template< typename Data >
+        struct BrokerState;
+
+        /** Broker<Data, Channel> statistics hooks, which compile to nothing unless SUB0PUB_STATS
+         * @remark Statistics are held by the BrokerState of each channel so channels of Data are counted separately
+         * @tparam Data  Data type of the broker
+         * @tparam cEnabled  Statistics recorded
+         */
+        template< typename Data, const bool cEnabled = SUB0PUB_STATS >
+        struct StatsT
+        {
+            /** Timing of one publish across its subscribers
+             */
+            struct Publication
+            {
+                Publication( BrokerState<Data>&, const size_t )
+                {}
+
+                void onReceive( const Subscription<Data>&, const size_t = 1U )
+                {}
+            };
+
+            static void attach( BrokerState<Data>&, Subscription<Data>& )
+            {}
+
+            static void detach( BrokerState<Data>&, const void* const )
+            {}
+
+            static void onFilterReject( BrokerState<Data>& )
+            {}
+        };
+
+#if SUB0PUB_STATS
+        template< typename Data >
+        struct StatsT<Data, true>
+        {
+            struct Publication
+            {
+                /** Start timing a publish
+                 * @param state  State of the channel published on
+                 * @param publishCount  Count of Data published
+                 */
+                Publication( BrokerState<Data>& state, const size_t publishCount )
+                    : shard_( StatsShardCache::shard(state.stats) )
+                    , start_( statsClock() )
+                    , time_( start_ )
+                {
+                    increment( shard_.publishCount, publishCount );
+                }
+
+                /** Record fan-out latency
+                 */
+                ~Publication()
+                {
+                    const uint64_t fanout = time_ - start_;
+                    if ( fanout > shard_.maxFanoutNs.load(std::memory_order_relaxed) )
+                        shard_.maxFanoutNs.store( fanout, std::memory_order_relaxed );
+                }
+
+                /** Record a subscriber receive completed now
+                 * @param count  Count of Data delivered
+                 */
+                void onReceive( const Subscription<Data>& subscription, const size_t count = 1U )
+                {
+                    const uint64_t now = statsClock();
+                    if ( subscription.stats )
+                        subscription.stats->record( now - time_ );
+                    increment( shard_.deliveryCount, count );
+                    time_ = now;
+                }
+
+            private:
+                StatsShard& shard_; ///< Calling thread's counters
+                const uint64_t start_; ///< Publish start time
+                uint64_t time_; ///< Time the previous receive completed
+            };
+
+            /** Assign a receive histogram to a new subscription
+             */
+            static void attach( BrokerState<Data>& state, Subscription<Data>& subscription )
+            { subscription.stats = state.stats.claimReceiver( subscription.context ); }
+
+            static void detach( BrokerState<Data>& state, const void* const context )
+            { state.stats.releaseReceiver( context ); }
+
+            static void onFilterReject( BrokerState<Data>& state )
+            { increment( StatsShardCache::shard(state.stats).filterRejectCount ); }
+
+            static const char* typeName()
+            {
+#if SUB0PUB_TYPEIDNAME
+                return Broker<Data>::typeName();
+#else
+                return TypeName<Data>::name();
+#endif
+            }
+
+            static uint32_t typeId()
+            {
+#if SUB0PUB_TYPEIDNAME
+                return Broker<Data>::typeId();
+#else
+                return TypeName<Data>::id();
+#endif
+            }
+        };
+#endif
+
+        /** Statistics hooks for Data configured by SUB0PUB_STATS
+         */
+        template< typename Data >
+        struct Stats : StatsT<Data>
+        {};
+    } // END: detail
+
+#if SUB0PUB_STATS
+    namespace stats
+    {
+        /** Snapshot statistics of every Broker<Data> used in the process
+         * @remark Safe to call from any thread while publishing continues, counters are read individually so a snapshot
+         *  taken mid-publish may be off by the in-flight publish
+         * @param[out] brokers  Replaced with a snapshot per broker
+         */
+        inline void snapshot( std::vector<BrokerSnapshot>& brokers )
+        {
+            brokers.clear();
+            for ( const detail::BrokerStats* broker = detail::BrokerStats::registry().load(std::memory_order_acquire); broker; broker = broker->next )
+            {
+                BrokerSnapshot snapshot = BrokerSnapshot();
+                snapshot.typeName = broker->typeName();
+                snapshot.typeId = broker->typeId();
+                snapshot.channel = broker->channel;
+                for ( const detail::StatsShard* shard = broker->shards.load(std::memory_order_acquire); shard; shard = shard->next )
+                {
+                    snapshot.publishCount += shard->publishCount.load( std::memory_order_relaxed );
+                    snapshot.deliveryCount += shard->deliveryCount.load( std::memory_order_relaxed );
+                    snapshot.filterRejectCount += shard->filterRejectCount.load( std::memory_order_relaxed );
+                    snapshot.maxFanoutNs = std::max( snapshot.maxFanoutNs, shard->maxFanoutNs.load(std::memory_order_relaxed) );
+                }
+                for ( const detail::ReceiveStats* receiver = broker->receivers.load(std::memory_order_acquire); receiver; receiver = receiver->next )
+                {
+                    SubscriberSnapshot subscriber = SubscriberSnapshot();
+                    subscriber.subscriber = receiver->context.load( std::memory_order_acquire );
+                    if ( subscriber.subscriber == nullptr )
+                        continue; //< Free for reuse
+
+                    subscriber.receiveNs = receiver->receiveNs.load( std::memory_order_relaxed );
+                    for ( uint32_t iBucket = 0U; iBucket < cHistogramBuckets; ++iBucket )
+                    {
+                        subscriber.buckets[iBucket] = receiver->buckets[iBucket].load( std::memory_order_relaxed );
+                        subscriber.receiveCount += subscriber.buckets[iBucket];
+                    }
+                    snapshot.subscribers.push_back( subscriber );
+                }
+                brokers.push_back( snapshot );
+            }
+        }
+
+        namespace detail
+        {
+            inline const char* nameOf( const BrokerSnapshot& broker )
+            { return broker.typeName ? broker.typeName : "unnamed"; }
+        } // END: detail
+
+        /** Write a snapshot of all broker statistics in Prometheus text exposition format
+         * @param stream  Stream to write into
+         */
+        inline void writePrometheus( OStream& stream )
+        {
+            std::vector<BrokerSnapshot> brokers;
+            snapshot( brokers );
+
+            struct Counter { const char* name; const char* type; const char* help; uint64_t BrokerSnapshot::* value; };
+            static const Counter counters[] = {
+                  { "sub0pub_publish_total", "counter", "Data published", &BrokerSnapshot::publishCount }
+                , { "sub0pub_delivery_total", "counter", "Data handed to subscribers", &BrokerSnapshot::deliveryCount }
+                , { "sub0pub_filter_reject_total", "counter", "Data rejected by subscriber filter()", &BrokerSnapshot::filterRejectCount }
+                , { "sub0pub_max_fanout_nanoseconds", "gauge", "Longest publish to all subscribers", &BrokerSnapshot::maxFanoutNs }
+            };
+            for ( const Counter& counter : counters )
+            {
+                utility::print( stream, "# HELP %s %s\n# TYPE %s %s\n", counter.name, counter.help, counter.name, counter.type );
+                for ( const BrokerSnapshot& broker : brokers )
+                {
+                    utility::print( stream, "%s{type=\"%s\",id=\"%u\",channel=\"%s\"} %llu\n", counter.name, detail::nameOf(broker), broker.typeId
+                        , broker.channel, static_cast<unsigned long long>(broker.*counter.value) );
+                }
+            }
+
+            utility::print( stream, "# HELP sub0pub_receive_nanoseconds Subscriber receive time\n# TYPE sub0pub_receive_nanoseconds histogram\n" );
+            for ( const BrokerSnapshot& broker : brokers )
+            {
+                for ( const SubscriberSnapshot& subscriber : broker.subscribers )
+                {
+                    uint64_t cumulative = 0U;
+                    for ( uint32_t iBucket = 0U; iBucket < (cHistogramBuckets - 1U); ++iBucket ) //< @note The unbounded last bucket is only in +Inf
+                    {
+                        cumulative += subscriber.buckets[iBucket];
+                        utility::print( stream, "sub0pub_receive_nanoseconds_bucket{type=\"%s\",channel=\"%s\",subscriber=\"%p\",le=\"%llu\"} %llu\n", detail::nameOf(broker)
+                            , broker.channel, subscriber.subscriber, 2ULL << iBucket, static_cast<unsigned long long>(cumulative) );
+                    }
+                    utility::print( stream, "sub0pub_receive_nanoseconds_bucket{type=\"%s\",channel=\"%s\",subscriber=\"%p\",le=\"+Inf\"} %llu\n"
+                        "sub0pub_receive_nanoseconds_sum{type=\"%s\",channel=\"%s\",subscriber=\"%p\"} %llu\n"
+                        "sub0pub_receive_nanoseconds_count{type=\"%s\",channel=\"%s\",subscriber=\"%p\"} %llu\n"
+                        , detail::nameOf(broker), broker.channel, subscriber.subscriber, static_cast<unsigned long long>(subscriber.receiveCount)
+                        , detail::nameOf(broker), broker.channel, subscriber.subscriber, static_cast<unsigned long long>(subscriber.receiveNs)
+                        , detail::nameOf(broker), broker.channel, subscriber.subscriber, static_cast<unsigned long long>(subscriber.receiveCount) );
+                }
+            }
+        }
+
+        /** Write a snapshot of all broker statistics as a JSON document
+         * @param stream  Stream to write into
+         */
+        inline void writeJson( OStream& stream )
+        {
+            std::vector<BrokerSnapshot> brokers;
+            snapshot( brokers );
+
+            utility::print( stream, "{\"brokers\":[" );
+            for ( size_t iBroker = 0U; iBroker < brokers.size(); ++iBroker )
+            {
+                const BrokerSnapshot& broker = brokers[iBroker];
+                utility::print( stream, "%s{\"type\":\"%s\",\"id\":%u,\"channel\":\"%s\",\"publish\":%llu,\"delivery\":%llu,\"filterReject\":%llu,\"maxFanoutNs\":%llu,\"subscribers\":["
+                    , iBroker ? "," : "", detail::nameOf(broker), broker.typeId, broker.channel
+                    , static_cast<unsigned long long>(broker.publishCount), static_cast<unsigned long long>(broker.deliveryCount)
+                    , static_cast<unsigned long long>(broker.filterRejectCount), static_cast<unsigned long long>(broker.maxFanoutNs) );
+                for ( size_t iSubscriber = 0U; iSubscriber < broker.subscribers.size(); ++iSubscriber )
+                {
+                    const SubscriberSnapshot& subscriber = broker.subscribers[iSubscriber];
+                    utility::print( stream, "%s{\"subscriber\":\"%p\",\"count\":%llu,\"sumNs\":%llu,\"buckets\":["
+                        , iSubscriber ? "," : "", subscriber.subscriber
+                        , static_cast<unsigned long long>(subscriber.receiveCount), static_cast<unsigned long long>(subscriber.receiveNs) );
+                    for ( uint32_t iBucket = 0U; iBucket < cHistogramBuckets; ++iBucket )
+                    {
+                        utility::print( stream, "%s%llu", iBucket ? "," : "", static_cast<unsigned long long>(subscriber.buckets[iBucket]) );
+                    }
+                    utility::print( stream, "]}" );
+                }
+                utility::print( stream, "]}" );
+            }
+            utility::print( stream, "]}\n" );
+        }
+    } // END: stats
+#endif
+
+#pragma warning(push)
+#pragma warning(disable:4355) ///< warning C4355: 'this' : used in base member initializer list
+
+    /** Base type for an object that subscribes to some strong-typed Data
+     * @remark Registers from the base constructor, or with BrokerTraits<Data>::cConcurrent or cCacheLast once the most-derived
+     *  subscriber calls subscribe() @see Subscribed
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     * @tparam  Channel  Channel of Data received from, void for the default channel @see RuntimeChannel
+     */
+    template< typename Data, typename Channel >
+    class Subscribe
+    {
+    public:
+        /** Registers the subscriber within the broker framework
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        Subscribe( 
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/ 
+#endif
+        )
+        : subscribed_(false)
+        , priority_(Priority::cNormal)
+        , broker_( Unsubscribed()
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName 
+#endif
+        )
+        { registerUnlessDeferred(); }
+
+        /** Registers the subscriber within the broker framework with a dispatch priority
+         * @param[in] priority  Delivery order among subscribers of Data, higher priorities receive first
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        explicit Subscribe( const Priority priority
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscribed_(false)
+        , priority_(priority.value)
+        , broker_( Unsubscribed()
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { registerUnlessDeferred(); }
+
+        /** Registers the subscriber on a runtime channel of Data
+         * @param[in] channel  Channel received from, requires Channel = RuntimeChannel
+         * @param[in] priority  Delivery order among subscribers of the channel, higher priorities receive first
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        explicit Subscribe( const ChannelId channel, const Priority priority = Priority()
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscribed_(false)
+        , priority_(priority.value)
+        , broker_( channel, Unsubscribed()
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { registerUnlessDeferred(); }
+
+        virtual ~Subscribe()
+        {  unsubscribe(); } ///< @todo Make implicit broker handle
+        
+        /** Receive published Data
+         * @remark Data is published from Publish<Data>::publish
+         */
+        virtual void receive( const Data& data ) = 0;
+
+        virtual bool filter(const Data& /*data*/)
+        {  return true; }
+
+        /** Receive a batch of published Data
+         * @remark Data is published from Publish<Data>::publishBatch, by default each data is passed through filter() and receive()
+         * @param data  First of 'count' contiguous data
+         * @param count  Count of data
+         */
+        virtual void receiveBatch( const Data* data, const size_t count )
+        {
+            for ( const Data* const iEnd = data + count; data != iEnd; ++data )
+            {
+                if ( filter(*data) )
+                {
+                    receive(*data);
+                }
+                else
+                {
+                    broker_.onFilterReject();
+                }
+            }
+        }
+
+#if SUB0PUB_TYPEIDNAME
+        /** Get name identifier of the Data from the broker
+         * @return Broker null-terminated type name
+        */
+        const char* typeName() const
+        { return broker_.typeName(); }
+
+        /** Stream operator for diagnostics reporting
+         * @param stream  Stream to report into
+         * @param subscriber  Subscriber instance to be written into stream
+         * @return Reference to 'stream'
+         */
+        friend OStream& operator<< ( OStream& stream, const Subscribe& subscriber )
+        { return stream << subscriber.typeName() << '{' << (void*)&subscriber << '}'; }
+#endif
+
+    protected:
+        /** Register the subscription once the subscriber can receive, then receive the cached last Data @see Broker::replay
+         * @remark Required with BrokerTraits::cConcurrent where the base constructor does not register, as another thread could
+         *  otherwise publish to a partly constructed subscriber, and with cCacheLast where the replay calls receive().
+         *  Call last in the most-derived constructor @see Subscribed
+         */
+        void subscribe()
+        {
+            if ( !subscribed_ )
+            {
+                broker_.subscribe( subscription( Priority(priority_) ) );
+                subscribed_ = true;
+                broker_.replay( subscription(), broker_.lastVersion() );
+            }
+        }
+
+        /** Remove the subscription ahead of destruction
+         * @remark Required with BrokerTraits::cConcurrent where another thread may publish while the derived object is destroyed.
+         *  Call first in the most-derived destructor, the base destructor then does nothing @see Subscribed
+         */
+        void unsubscribe()
+        {
+            if ( subscribed_ )
+            {
+                broker_.unsubscribe( subscription() );
+                subscribed_ = false;
+            }
+        }
+
+    private:
+        /** Register from the base constructor unless BrokerTraits::cConcurrent or cCacheLast, where the most-derived subscriber
+         *  registers as it may receive at once
+         */
+        void registerUnlessDeferred()
+        {
+            if ( !(Broker<Data, Channel>::Traits::cConcurrent || Broker<Data, Channel>::Traits::cCacheLast) )
+                subscribe();
+        }
+
+        /** Broker table entry dispatching to the virtual filter(), receive() and receiveBatch()
+         */
+        Subscription<Data> subscription( const Priority priority = Priority() )
+        { return Subscription<Data>( &Subscribe::dispatch, static_cast<void*>(this), &Subscribe::dispatchBatch, priority.value ); }
+
+        static void dispatch( void* context, const Data& data )
+        {
+            Subscribe* const subscriber = static_cast<Subscribe*>(context);
+            if ( subscriber->filter(data) )
+            {
+                subscriber->receive(data);
+            }
+            else
+            {
+                subscriber->broker_.onFilterReject();
+            }
+        }
+
+        static void dispatchBatch( void* context, const Data* data, const size_t count )
+        { static_cast<Subscribe*>(context)->receiveBatch( data, count ); }
+
+    private:
+        bool subscribed_; ///< Subscription is registered in the broker
+        const int32_t priority_; ///< Delivery order registered by subscribe()
+        Broker<Data, Channel> broker_; ///< Broker of the Data channel to manage publish-subscribe connections
+    };
+
+    namespace detail
+    {
+        /** Detects Target::filter( const Data& ) by exact signature so overloads for other Data types are not matched through conversion
+         * @tparam Target  Type checked for a filter member
+         * @tparam Data  Parameter type of filter
+         */
+        template< typename Target, typename Data >
+        struct HasFilter
+        {
+        private:
+            template< typename T > static char check( decltype( static_cast<bool (T::*)(const Data&)>(&T::filter) )* );
+            template< typename T > static char check( decltype( static_cast<bool (T::*)(const Data&) const>(&T::filter) )* );
+            template< typename T > static long check( ... );
+
+        public:
+            static const bool value = sizeof(check<Target>(0/*nullptr*/)) == sizeof(char);
+        };
+
+        /** Detects Target::receiveBatch( const Data*, size_t ) by exact signature
+         * @tparam Target  Type checked for a receiveBatch member
+         * @tparam Data  Batch element type
+         */
+        template< typename Target, typename Data >
+        struct HasReceiveBatch
+        {
+        private:
+            template< typename T > static char check( decltype( static_cast<void (T::*)(const Data*, size_t)>(&T::receiveBatch) )* );
+            template< typename T > static long check( ... );
+
+        public:
+            static const bool value = sizeof(check<Target>(0/*nullptr*/)) == sizeof(char);
+        };
+    } // END: detail
+
+    /** Devirtualised subscription which invokes Target::receive( const Data& ) directly from the broker
+     * @remark Broker<Data>::publish makes one indirect call per subscription into a thunk that calls the non-virtual Target::receive.
+     *  Target::filter( const Data& ) is called first only when Target declares one, otherwise no filter call is made.
+     *  Batches from Publish<Data>::publishBatch are passed whole to Target::receiveBatch( const Data*, size_t ) when declared.
+     * @note This uses the CRTP(curiously recurring template pattern) with Target derived from DirectSubscribe<..>
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     * @tparam  Target  Type of derived class which implements Target::receive( const Data& ) and optionally bool Target::filter( const Data& )
+     * @tparam  Channel  Channel of Data received from, void for the default channel @see RuntimeChannel
+     */
+    template< typename Data, typename Target, typename Channel = void >
+    class DirectSubscribe
+    {
+    public:
+        /** Registers the subscriber within the broker framework
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        DirectSubscribe(
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscribed_(false)
+        , priority_(Priority::cNormal)
+        , broker_( Unsubscribed()
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { registerUnlessDeferred(); }
+
+        /** Registers the subscriber within the broker framework with a dispatch priority
+         * @param[in] priority  Delivery order among subscribers of Data, higher priorities receive first
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        explicit DirectSubscribe( const Priority priority
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscribed_(false)
+        , priority_(priority.value)
+        , broker_( Unsubscribed()
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { registerUnlessDeferred(); }
+
+        /** Registers the subscriber on a runtime channel of Data
+         * @param[in] channel  Channel received from, requires Channel = RuntimeChannel
+         * @param[in] priority  Delivery order among subscribers of the channel, higher priorities receive first
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        explicit DirectSubscribe( const ChannelId channel, const Priority priority = Priority()
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscribed_(false)
+        , priority_(priority.value)
+        , broker_( channel, Unsubscribed()
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { registerUnlessDeferred(); }
+
+        ~DirectSubscribe()
+        {  unsubscribe(); }
+
+#if SUB0PUB_TYPEIDNAME
+        /** Get name identifier of the Data from the broker
+         * @return Broker null-terminated type name
+        */
+        const char* typeName() const
+        { return broker_.typeName(); }
+#endif
+
+    protected:
+        /** Register the subscription once the subscriber can receive, then receive the cached last Data @see Broker::replay
+         * @remark Required with BrokerTraits::cConcurrent where the base constructor does not register, as another thread could
+         *  otherwise publish to a partly constructed subscriber, and with cCacheLast where the replay calls receive().
+         *  Call last in the most-derived constructor @see Subscribed
+         */
+        void subscribe()
+        {
+            if ( !subscribed_ )
+            {
+                broker_.subscribe( subscription( Priority(priority_) ) );
+                subscribed_ = true;
+                broker_.replay( subscription(), broker_.lastVersion() );
+            }
+        }
+
+        /** Remove the subscription ahead of destruction
+         * @remark Required with BrokerTraits::cConcurrent where another thread may publish while the derived object is destroyed.
+         *  Call first in the most-derived destructor, the base destructor then does nothing @see Subscribed
+         */
+        void unsubscribe()
+        {
+            if ( subscribed_ )
+            {
+                broker_.unsubscribe( subscription() );
+                subscribed_ = false;
+            }
+        }
+
+    private:
+        DirectSubscribe( const DirectSubscribe& ); ///< Non-copyable, the broker holds 'this'
+        DirectSubscribe& operator=( const DirectSubscribe& ); ///< Non-copyable, the broker holds 'this'
+
+        /** Register from the base constructor unless BrokerTraits::cConcurrent or cCacheLast, where the most-derived subscriber
+         *  registers as it may receive at once
+         */
+        void registerUnlessDeferred()
+        {
+            if ( !(Broker<Data, Channel>::Traits::cConcurrent || Broker<Data, Channel>::Traits::cCacheLast) )
+                subscribe();
+        }
+
+        Subscription<Data> subscription( const Priority priority = Priority() )
+        {
+            return Subscription<Data>( &DirectSubscribe::dispatch, static_cast<void*>(this)
+                , batchFunction( std::integral_constant<bool, detail::HasReceiveBatch<Target,Data>::value>() ), priority.value );
+        }
+
+        static void dispatch( void* context, const Data& data )
+        {
+            Target* const target = static_cast<Target*>( static_cast<DirectSubscribe*>(context) );
+            dispatch( target, data, std::integral_constant<bool, detail::HasFilter<Target,Data>::value>() );
+        }
+
+        static void dispatch( Target* const target, const Data& data, std::true_type /*hasFilter*/ )
+        {
+            if ( target->filter(data) )
+            {
+                target->receive(data);
+            }
+            else
+            {
+                static_cast<DirectSubscribe*>(target)->broker_.onFilterReject();
+            }
+        }
+
+        static void dispatch( Target* const target, const Data& data, std::false_type /*hasFilter*/ )
+        { target->receive(data); }
+
+        static void dispatchBatch( void* context, const Data* data, const size_t count )
+        { static_cast<Target*>( static_cast<DirectSubscribe*>(context) )->receiveBatch( data, count ); }
+
+        static typename Subscription<Data>::ReceiveBatch batchFunction( std::true_type /*hasReceiveBatch*/ )
+        { return &DirectSubscribe::dispatchBatch; }
+
+        static typename Subscription<Data>::ReceiveBatch batchFunction( std::false_type /*hasReceiveBatch*/ )
+        { return 0/*nullptr*/; } //< Broker delivers batches per element through dispatch
+
+    private:
+        bool subscribed_; ///< Subscription is registered in the broker
+        const int32_t priority_; ///< Delivery order registered by subscribe()
+        Broker<Data, Channel> broker_; ///< Broker of the Data channel to manage publish-subscribe connections
+    };
+
+    /** Subscription of a free function and user context pointer
+     * @remark The function is invoked directly by the broker with no virtual or filter call
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     * @tparam  Channel  Channel of Data received from, void for the default channel @see RuntimeChannel
+     */
+    template< typename Data, typename Channel = void >
+    class FunctionSubscribe
+    {
+    public:
+        /** Registers function within the broker framework
+         * @param[in] receive  Function called with 'context' for each published Data
+         * @param[in] context  User pointer passed to receive, must be unique per FunctionSubscribe of the Data type
+         * @param[in] receiveBatch  Optional function called with 'context' for each published batch, when nullptr receive is called per element
+         * @param[in] priority  Delivery order among subscribers of Data, higher priorities receive first
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         * @remark The last published Data is received immediately when BrokerTraits<Data>::cCacheLast
+         */
+        FunctionSubscribe( const typename Subscription<Data>::Receive receive, void* const context
+            , const typename Subscription<Data>::ReceiveBatch receiveBatch = 0/*nullptr*/, const Priority priority = Priority()
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscription_( receive, context, receiveBatch, priority.value )
+        , broker_( subscription_
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { broker_.replay( subscription_, broker_.lastVersion() ); }
+
+        /** Registers function on a runtime channel of Data
+         * @param[in] channel  Channel received from, requires Channel = RuntimeChannel
+         * @see FunctionSubscribe(Receive,void*,ReceiveBatch,Priority)
+         */
+        FunctionSubscribe( const ChannelId channel, const typename Subscription<Data>::Receive receive, void* const context
+            , const typename Subscription<Data>::ReceiveBatch receiveBatch = 0/*nullptr*/, const Priority priority = Priority()
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : subscription_( receive, context, receiveBatch, priority.value )
+        , broker_( channel, subscription_
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        { broker_.replay( subscription_, broker_.lastVersion() ); }
+
+        ~FunctionSubscribe()
+        {  broker_.unsubscribe( subscription_ ); }
+
+    private:
+        FunctionSubscribe( const FunctionSubscribe& ); ///< Non-copyable
+        FunctionSubscribe& operator=( const FunctionSubscribe& ); ///< Non-copyable
+
+    private:
+        const Subscription<Data> subscription_; ///< Registered function and context
+        Broker<Data, Channel> broker_; ///< Broker of the Data channel to manage publish-subscribe connections
+    };
+
+    namespace detail
+    {
+        /** Hash of an integer, enum or pointer key, the 64-bit MurmurHash3 finaliser of its value
+         * @tparam Key  Key type
+         * @tparam cValue  Key converts to an integer
+         */
+        template< typename Key, const bool cValue = std::is_integral<Key>::value || std::is_enum<Key>::value || std::is_pointer<Key>::value >
+        struct KeyHash
+        {
+            static uint32_t hash( const Key& key )
+            {
+                uint64_t value = bits( key, std::is_pointer<Key>() );
+                value = (value ^ (value >> 33U)) * 0xFF51AFD7ED558CCDULL;
+                value = (value ^ (value >> 33U)) * 0xC4CEB9FE1A85EC53ULL;
+                return static_cast<uint32_t>( value ^ (value >> 33U) );
+            }
+
+        private:
+            static uint64_t bits( const Key& key, std::true_type /*isPointer*/ )
+            { return static_cast<uint64_t>( reinterpret_cast<uintptr_t>(key) ); }
+
+            static uint64_t bits( const Key& key, std::false_type /*isPointer*/ )
+            { return static_cast<uint64_t>( key ); }
+        };
+
+        /** Hash of any other key by std::hash
+         */
+        template< typename Key >
+        struct KeyHash<Key, false>
+        {
+#if SUB0PUB_STD
+            static uint32_t hash( const Key& key )
+            { return static_cast<uint32_t>( std::hash<Key>()(key) ); }
+#else
+            static_assert( sizeof(Key) == 0U, "KeySubscribe keys other than integers, enums and pointers require KeyOf::hash() or SUB0PUB_STD for std::hash" );
+#endif
+        };
+
+        /** Index from a key of published Data to the KeySubscribe<Data, KeyOf> subscribers of that key
+         * @remark MonoState per Data and KeyOf, subscribed to Broker<Data> once so a publish costs a single dispatch and a hash
+         *  lookup however many keyed subscribers there are. Keys are added on first subscribe and retained for reuse.
+         *  Subscriptions of a key follow BrokerTraits<Data> concurrency i.e. may change while publishing with cConcurrent.
+         * @tparam Data  Published data type
+         * @tparam KeyOf  Key extractor with typedef Key, static Key key( const Data& ) and optionally static uint32_t hash( const Key& )
+         * @tparam cMaxKeys  Count of distinct keys @note Must be a power of two
+         */
+        template< typename Data, typename KeyOf, uint32_t cMaxKeys >
+        class KeyIndex
+        {
+            static_assert( (cMaxKeys != 0U) && ((cMaxKeys & (cMaxKeys - 1U)) == 0U), "KeyIndex key capacity must be a power of two" );
+
+            typedef typename KeyOf::Key Key;
+
+            /** Per key table, growable from a single inline entry and concurrent when the broker is
+             */
+            struct KeyTraits
+            {
+                static const uint32_t cMaxSubscriptions = 1U;
+                static const bool cGrowable = true;
+                static const bool cConcurrent = BrokerTraits<Data>::cConcurrent;
+            };
+            typedef typename SubscriptionTable<Subscription<Data>, KeyTraits>::type Table;
+
+            struct Bucket
+            {
+                Bucket()
+                    : used(false)
+                    , key()
+                    , subscriptions()
+                {}
+
+#if SUB0PUB_THREADS
+                std::atomic<bool> used; ///< Key is set, never cleared
+#else
+                bool used; ///< Key is set, never cleared
+#endif
+                Key key;
+                Table subscriptions; ///< Subscribers of key in priority order
+            };
+
+        public:
+            /** @return MonoState index, subscribed to Broker<Data> on first use
+             */
+            static KeyIndex& instance()
+            {
+                static KeyIndex index;
+                return index;
+            }
+
+            /** Subscribe to data of a key
+             * @return False if the index is full of other keys
+             */
+            bool insert( const Key& key, const Subscription<Data>& subscription )
+            {
+                Table* const subscriptions = claim( key );
+                return subscriptions && subscriptions->insert( subscription ); //< @note Outside writeMutex_, the table serialises its own writers
+            }
+
+            /** @return False if subscription was not found for key
+             */
+            bool remove( const Key& key, const Subscription<Data>& subscription )
+            {
+                Table* const subscriptions = find( key );
+                return subscriptions && subscriptions->remove( subscription );
+            }
+
+        private:
+            KeyIndex()
+                : buckets_()
+#if SUB0PUB_THREADS
+                , writeMutex_()
+#endif
+                , broker_( subscription() )
+            {}
+
+            ~KeyIndex()
+            { broker_.unsubscribe( subscription() ); }
+
+            KeyIndex( const KeyIndex& ); ///< Non-copyable, the broker holds 'this'
+            KeyIndex& operator=( const KeyIndex& ); ///< Non-copyable, the broker holds 'this'
+
+            Subscription<Data> subscription()
+            { return Subscription<Data>( &KeyIndex::dispatch, static_cast<void*>(this) ); }
+
+            /** Deliver data to the subscribers of its key only
+             */
+            static void dispatch( void* context, const Data& data )
+            {
+                Table* const subscriptions = static_cast<KeyIndex*>(context)->find( KeyOf::key(data) );
+                if ( subscriptions )
+                {
+                    const typename Table::Reader reader( *subscriptions );
+                    const Subscription<Data>* const iEnd = reader.end();
+                    for ( const Subscription<Data>* iSubscription = reader.begin(); iSubscription != iEnd; ++iSubscription )
+                    {
+                        iSubscription->receive( iSubscription->context, data );
+                    }
+                }
+            }
+
+            /** @return Subscriptions of key, adding the key when new, nullptr if the index is full of other keys
+             */
+            Table* claim( const Key& key )
+            {
+#if SUB0PUB_THREADS
+                std::lock_guard<std::mutex> lock( writeMutex_ ); //< Serialise key claims, publish reads without locking
+#endif
+                for ( uint32_t iProbe = 0U; iProbe < cMaxKeys; ++iProbe )
+                {
+                    Bucket& bucket = buckets_[(hash(key) + iProbe) & (cMaxKeys - 1U)];
+                    if ( !isUsed(bucket) )
+                    {
+                        bucket.key = key;
+                        setUsed( bucket );
+                    }
+                    if ( bucket.key == key )
+                        return &bucket.subscriptions;
+                }
+                return 0/*nullptr*/;
+            }
+
+            /** @return Subscriptions of key, nullptr if key has never been subscribed
+             */
+            Table* find( const Key& key )
+            {
+                for ( uint32_t iProbe = 0U; iProbe < cMaxKeys; ++iProbe )
+                {
+                    Bucket& bucket = buckets_[(hash(key) + iProbe) & (cMaxKeys - 1U)];
+                    if ( !isUsed(bucket) )
+                        return 0/*nullptr*/;
+                    if ( bucket.key == key )
+                        return &bucket.subscriptions;
+                }
+                return 0/*nullptr*/;
+            }
+
+            /** Detect a static uint32_t T::hash( const Key& ) overriding KeyHash
+             */
+            template< typename T >
+            struct HasHash
+            {
+                template< typename U > static char check( decltype( static_cast<uint32_t (*)(const Key&)>(&U::hash) )* );
+                template< typename U > static long check( ... );
+                static const bool value = sizeof(check<T>(0/*nullptr*/)) == sizeof(char);
+            };
+
+            static uint32_t hash( const Key& key )
+            { return hash( key, std::integral_constant<bool, HasHash<KeyOf>::value>() ); }
+
+            static uint32_t hash( const Key& key, std::true_type /*hasHash*/ )
+            { return KeyOf::hash( key ); }
+
+            static uint32_t hash( const Key& key, std::false_type /*hasHash*/ )
+            { return KeyHash<Key>::hash( key ); }
+
+#if SUB0PUB_THREADS
+            static bool isUsed( const Bucket& bucket )
+            { return bucket.used.load( std::memory_order_acquire ); }
+
+            static void setUsed( Bucket& bucket )
+            { bucket.used.store( true, std::memory_order_release ); }
+#else
+            static bool isUsed( const Bucket& bucket )
+            { return bucket.used; }
+
+            static void setUsed( Bucket& bucket )
+            { bucket.used = true; }
+#endif
+
+        private:
+            Bucket buckets_[cMaxKeys]; ///< Open addressed by key hash
+#if SUB0PUB_THREADS
+            std::mutex writeMutex_; ///< Serialises key claims
+#endif
+            Broker<Data> broker_; ///< MonoState broker instance delivering all Data to the index
+        };
+    } // END: detail
+
+    /** Subscription to the Data of a single key
+     * @remark Rather than every subscriber filtering every publish, a detail::KeyIndex per Data and KeyOf subscribes once and
+     *  delivers each Data only to the subscribers of KeyOf::key(data) e.g.
+     * @code
+     *  struct SymbolOf { typedef uint32_t Key; static Key key( const MarketTick& tick ) { return tick.symbolId; } };
+     *  class Strategy : public sub0::KeySubscribe<MarketTick, SymbolOf> { public: Strategy() : KeySubscribe(42U) {} ... };
+     * @endcode
+     * @note Keyed subscribers receive in priority order among subscribers of the same key, all at the point the index is
+     *  dispatched within the broker i.e. Priority::cNormal among direct subscribers
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     * @tparam  KeyOf  Key extractor with typedef Key and static Key key( const Data& ), Key must be equality comparable. Integer, enum and
+     *  pointer keys are hashed by the index, other keys by an optional static uint32_t KeyOf::hash( const Key& ) else std::hash
+     *  with SUB0PUB_STD
+     * @tparam  cMaxKeys  Count of distinct keys of the index @note Must be a power of two
+     */
+    template< typename Data, typename KeyOf, uint32_t cMaxKeys = 256U >
+    class KeySubscribe
+    {
+        typedef detail::KeyIndex<Data, KeyOf, cMaxKeys> Index;
+
+    public:
+        typedef typename KeyOf::Key Key;
+
+        /** Registers the subscriber for data of a key
+         * @param[in] key  Receive only data where KeyOf::key(data) == key
+         * @param[in] priority  Delivery order among subscribers of key, higher first
+         */
+        explicit KeySubscribe( const Key& key, const Priority priority = Priority() )
+            : key_(key)
+            , subscribed_(false)
+            , priority_(priority.value)
+        {
+            if ( !BrokerTraits<Data>::cConcurrent )
+                subscribe(); //< With cConcurrent the most-derived subscriber registers once constructed
+        }
+
+        virtual ~KeySubscribe()
+        {  unsubscribe(); }
+
+        /** Receive published Data of key()
+         */
+        virtual void receive( const Data& data ) = 0;
+
+        /** @return Key of the subscription
+         */
+        const Key& key() const
+        { return key_; }
+
+    protected:
+        /** Register the subscription once the subscriber can receive
+         * @remark Required with BrokerTraits::cConcurrent where the base constructor does not register, as another thread could
+         *  otherwise publish to a partly constructed subscriber. Call last in the most-derived constructor @see Subscribed
+         */
+        void subscribe()
+        {
+            if ( !subscribed_ )
+            {
+                subscribed_ = Index::instance().insert( key_, subscription( Priority(priority_) ) );
+                assert( subscribed_ || !"KeySubscribe index full, increase cMaxKeys" );
+            }
+        }
+
+        /** Remove the subscription ahead of destruction
+         * @remark Required with BrokerTraits::cConcurrent where another thread may publish while the derived object is destroyed.
+         *  Call first in the most-derived destructor, the base destructor then does nothing @see Subscribed
+         */
+        void unsubscribe()
+        {
+            if ( subscribed_ )
+            {
+                Index::instance().remove( key_, subscription() );
+                subscribed_ = false;
+            }
+        }
+
+    private:
+        KeySubscribe( const KeySubscribe& ); ///< Non-copyable, the index holds 'this'
+        KeySubscribe& operator=( const KeySubscribe& ); ///< Non-copyable, the index holds 'this'
+
+        Subscription<Data> subscription( const Priority priority = Priority() )
+        { return Subscription<Data>( &KeySubscribe::dispatch, static_cast<void*>(this), 0/*nullptr*/, priority.value ); }
+
+        static void dispatch( void* context, const Data& data )
+        { static_cast<KeySubscribe*>(context)->receive(data); }
+
+    private:
+        const Key key_; ///< Subscribed key
+        bool subscribed_; ///< Subscription is registered in the index
+        const int32_t priority_; ///< Delivery order registered by subscribe()
+    };
+
+    /** Subscriber registered once fully constructed and unregistered before its destruction begins
+     * @remark With BrokerTraits<Data>::cConcurrent, Subscribe, DirectSubscribe and KeySubscribe do not register from their base
+     *  constructor as another thread could then call receive() on a partly constructed, or partly destroyed, subscriber.
+     *  Subscribe and DirectSubscribe also wait with cCacheLast as registering replays the cached last Data into receive().
+     *  Subscribed calls subscribe() after the most-derived constructor and unsubscribe() before the most-derived destructor e.g.
+     *  @code
+     *  sub0::Subscribed<Logger> logger( logFile );
+     *  @endcode
+     *  Otherwise the subscriber is already registered and subscribe() does nothing.
+     * @note A Subscriber deriving from several subscriber bases provides its own subscribe() and unsubscribe() calling each base's
+     * @tparam Subscriber  Type deriving from Subscribe, DirectSubscribe or KeySubscribe
+     */
+    template< typename Subscriber >
+    class Subscribed : public Subscriber
+    {
+    public:
+        template< typename... Args >
+        explicit Subscribed( Args&&... args )
+            : Subscriber( std::forward<Args>(args)... )
+        { Subscriber::subscribe(); }
+
+        ~Subscribed()
+        { Subscriber::unsubscribe(); }
+    };
+
+    /** Base type for an object that publishes to some strong-typed Data
+     * @tparam  Data  Type that will be published by this object to subscribers of corresponding type
+     * @tparam  Channel  Channel of Data published on, void for the default channel @see RuntimeChannel
+     */
+    template< typename Data, typename Channel >
+    class Publish
+    {
+    public:
+        /** Registers the publisher within the broker framework
+         * @param[in] typeName Optional unique data name given to data for inter-process signaling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        Publish(
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
 #endif
         )
         : broker_( this
 #if SUB0PUB_TYPEIDNAME
             , typeId, typeName
 #endif
-        )
-        {}
+        )
+        {}
+
+        /** Registers the publisher on a runtime channel of Data
+         * @param[in] channel  Channel published on, requires Channel = RuntimeChannel
+         * @param[in] typeName Optional unique data name given to data for inter-process signaling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        explicit Publish( const ChannelId channel
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        : broker_( channel, this
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName
+#endif
+        )
+        {}
+
+        virtual ~Publish()
+        { broker_.unsubscribe(this); } ///< @todo Make implicit broker handle
+
+        /** Publish data to subscribers
+         * @param[in]  data  Data value to publish to subscribers
+         * @remark Data will be received by Subscribe<Data>::receive
+         */
+        void publish( const Data& data ) const
+        {
+            detail::Check::onPublish( *this, data );
+            broker_.publish(data); //< @todo Add 'this' as traceability to data source for broker specialisation etc
+        }
+
+        /** Publish contiguous data to subscribers in a single broker pass
+         * @param[in]  first  First of 'count' data values to publish
+         * @param[in]  count  Count of data values
+         * @remark Data will be received by Subscribe<Data>::receiveBatch, or per element by receive() for subscribers without batch support
+         */
+        void publishBatch( const Data* first, const size_t count ) const
+        {
+            detail::Check::onPublishBatch( *this, first, count );
+            broker_.publishBatch( first, count );
+        }
+
+#if SUB0PUB_TYPEIDNAME
+        /** Get name identifier of the Data from the broker
+         * @return Broker null-terminated type name
+        */
+        const char* typeName() const
+        { return broker_.typeName(); }
+
+        /** Get unique identifier of the Data from the broker
+         * @return Broker unique type index
+        */
+        uint32_t typeId() const
+        { return broker_.typeId(); }
+
+        /** Stream operator for diagnostics reporting
+         * @param stream  Stream to report into
+         * @param publisher  Publisher instance to be written into stream
+         * @return Reference to 'stream'
+         */
+        friend OStream& operator<< ( OStream& stream, const Publish& publisher )
+        { return stream << publisher.typeName() << '{' << (void*)&publisher << '}'; }
+#endif
+
+    private:
+        Broker<Data, Channel> broker_; ///< Broker of the Data channel to manage publish-subscribe connections
+    };
+
+#pragma warning(pop)
+
+#if SUB0PUB_SHARED_BROKERS
+    namespace detail
+    {
+        /** Process-wide table of Broker<Data> states shared by every module (executable and shared libraries)
+         * @remark The table is found by each module through the address space itself rather than an exported symbol, so modules
+         *  loaded with hidden visibility or RTLD_LOCAL still share states. On Linux it is a named memfd mapping looked up in
+         *  /proc/self/maps, which exec() discards, mapped private so a forked child continues with its own copy. On Windows it
+         *  is a file mapping named by the process id, released with the process. Broker<Data> looks up its state once on first
+         *  use and caches the pointer. States are never freed so remain valid after the module creating them is unloaded.
+         * @note Modules must agree on the layout of each State i.e. be built with the same Sub0Pub version and BrokerTraits
+         */
+        class BrokerRegistry
+        {
+        public:
+            static const uint32_t cMagic = utility::FourCC<'S','0','B','R'>::value; ///< Identifies a constructed registry
+            static const uint32_t cVersion = 2U; ///< Incremented on any change to the registry or entry layout
+            static const uint32_t cCapacity = SUB0PUB_REGISTRY_CAPACITY; ///< Maximum count of Data types in the process
+
+            typedef void* (*CreateState)( const char* channel );
+
+            /** Find the state of a Data type, creating it when first seen in the process
+             * @remark Lock-free, concurrent lookups of a new type wait for the first to create its state
+             * @param typeId  Data type id used to index the table
+             * @param name  Data type name identifying the type where ids collide
+             * @param create  Allocates a state for the type
+             * @param channel  Channel label passed to create
+             * @return State of the type
+             */
+            void* find( const uint32_t typeId, const char* const name, const CreateState create, const char* const channel )
+            {
+                for ( uint32_t iProbe = 0U; iProbe < cCapacity; ++iProbe )
+                {
+                    Entry& entry = entries_[(typeId + iProbe) % cCapacity];
+                    uint32_t status = entry.status.load( std::memory_order_acquire );
+                    if ( (status == cEmpty) && entry.status.compare_exchange_strong( status, cClaimed, std::memory_order_acquire, std::memory_order_acquire ) )
+                    {
+                        char* const copy = new char[std::strlen(name) + 1U]; //< @note Copied so entries outlive the module
+                        std::strcpy( copy, name );
+                        entry.typeId = typeId;
+                        entry.name = copy;
+                        entry.state = create( channel );
+                        entry.status.store( cReady, std::memory_order_release );
+                        return entry.state;
+                    }
+
+                    while ( status == cClaimed )
+                    {
+                        std::this_thread::yield();
+                        status = entry.status.load( std::memory_order_acquire );
+                    }
+                    if ( (entry.typeId == typeId) && (std::strcmp( entry.name, name ) == 0) )
+                        return entry.state;
+                }
+                failure( "Sub0Pub broker registry full, increase SUB0PUB_REGISTRY_CAPACITY" );
+                return create( channel ); //< @note Module-local state when failure() does not throw
+            }
+
+            /** @return Registry shared by all modules of the process
+             */
+            static BrokerRegistry& instance()
+            {
+                static BrokerRegistry* const registry = resolve();
+                return *registry;
+            }
+
+        private:
+            enum Status { cEmpty = 0U, cClaimed = 1U, cReady = 2U };
+
+            struct Entry
+            {
+                std::atomic<uint32_t> status; ///< Status
+                uint32_t typeId;
+                const char* name;
+                void* state;
+            };
+
+            /** Construct in zeroed memory of the mapping, published by the release store of magic_
+             */
+            BrokerRegistry()
+                : magic_(0U)
+                , version_(cVersion)
+                , capacity_(cCapacity)
+                , self_(this)
+                , entries_()
+            {
+                magic_.store( cMagic, std::memory_order_release );
+            }
+
+            /** Find the registry of the process or create it
+             * @note The first resolution by each module should not race another module's first resolution e.g. concurrent dlopen()
+             */
+            static BrokerRegistry* resolve()
+            {
+                BrokerRegistry* registry = map();
+                if ( registry == 0/*nullptr*/ )
+                {
+                    failure( "Sub0Pub broker registry could not be mapped" );
+                    registry = new BrokerRegistry(); //< @note Module-local registry when failure() does not throw
+                }
+
+                if ( (registry->version_ != cVersion) || (registry->capacity_ != cCapacity) )
+                    failure( "Sub0Pub broker registry created by a different version or SUB0PUB_REGISTRY_CAPACITY" );
+                return registry;
+            }
+
+#if defined(_WIN32)
+            /** @return Registry in the file mapping named by the process id, created by the first module to open it
+             * @note The mapping handle is left open so the registry lives as long as the process
+             */
+            static BrokerRegistry* map()
+            {
+                char name[64];
+                std::snprintf( name, sizeof(name), "Local\\Sub0PubBrokerRegistry.%lu", static_cast<unsigned long>( GetCurrentProcessId() ) );
+                const HANDLE mapping = CreateFileMappingA( INVALID_HANDLE_VALUE, 0/*nullptr*/, PAGE_READWRITE, 0, static_cast<DWORD>( sizeof(BrokerRegistry) ), name );
+                if ( mapping == 0/*nullptr*/ )
+                    return 0/*nullptr*/;
+
+                const bool created = (GetLastError() != ERROR_ALREADY_EXISTS);
+                void* const view = MapViewOfFile( mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(BrokerRegistry) );
+                if ( view == 0/*nullptr*/ )
+                    return 0/*nullptr*/;
+                if ( created )
+                    return new (view) BrokerRegistry();
+
+                BrokerRegistry* const registry = static_cast<BrokerRegistry*>( view );
+                while ( registry->magic_.load( std::memory_order_acquire ) != cMagic )
+                {
+                    std::this_thread::yield(); //< Creating module is constructing the registry
+                }
+                return registry;
+            }
+#else
+            /** @return Registry in the memfd mapping of this address space, created when no module has mapped it yet
+             */
+            static BrokerRegistry* map()
+            {
+                BrokerRegistry* const registry = findMapping();
+                if ( registry )
+                    return registry;
+
+                const int fd = memfd_create( mappingName(), MFD_CLOEXEC );
+                if ( fd < 0 )
+                    return 0/*nullptr*/;
+
+                void* memory = MAP_FAILED;
+                if ( ftruncate( fd, static_cast<off_t>( sizeof(BrokerRegistry) ) ) == 0 )
+                    memory = mmap( 0/*nullptr*/, sizeof(BrokerRegistry), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+                ::close( fd ); //< @note The mapping keeps the memfd alive
+                return (memory != MAP_FAILED) ? new (memory) BrokerRegistry() : 0/*nullptr*/;
+            }
+
+            /** @return Registry mapped by another module, nullptr if none
+             * @remark Only mappings of this address space are listed, so a registry is never inherited across exec(). A candidate
+             *  is accepted once its magic and the address it was constructed at are confirmed.
+             */
+            static BrokerRegistry* findMapping()
+            {
+                std::FILE* const maps = std::fopen( "/proc/self/maps", "r" );
+                if ( maps == 0/*nullptr*/ )
+                    return 0/*nullptr*/;
+
+                BrokerRegistry* registry = 0/*nullptr*/;
+                char line[512];
+                bool lineStart = true;
+                while ( (registry == 0/*nullptr*/) && std::fgets( line, sizeof(line), maps ) )
+                {
+                    const size_t length = std::strlen( line );
+                    const bool isLineStart = lineStart;
+                    lineStart = (length != 0U) && (line[length - 1U] == '\n'); //< A long line is read over several calls
+                    if ( !isLineStart || (std::strstr( line, "/memfd:" ) == 0/*nullptr*/) || (std::strstr( line, mappingName() ) == 0/*nullptr*/) )
+                        continue;
+
+                    char* end = 0/*nullptr*/;
+                    const uintptr_t begin = static_cast<uintptr_t>( std::strtoull( line, &end, 16 ) );
+                    if ( (end == line) || (*end != '-') )
+                        continue;
+
+                    BrokerRegistry* const candidate = reinterpret_cast<BrokerRegistry*>( begin );
+                    if ( (candidate->magic_.load( std::memory_order_acquire ) == cMagic) && (candidate->self_ == candidate) )
+                        registry = candidate;
+                }
+                std::fclose( maps );
+                return registry;
+            }
+
+            /** @return memfd name shown in /proc/self/maps
+             */
+            static const char* mappingName() { return "sub0pub-broker-registry"; }
+#endif
+
+            static void failure( const char* const failureMessage )
+            {
+#if __cpp_exceptions
+                throw std::runtime_error(failureMessage);
+#else
+                assert((void*)0 == failureMessage);
+#endif
+            }
+
+        private:
+            std::atomic<uint32_t> magic_; ///< cMagic once constructed
+            const uint32_t version_; ///< cVersion of the creating module
+            const uint32_t capacity_; ///< cCapacity of the creating module
+            const BrokerRegistry* const self_; ///< Address constructed at, confirms a mapping found by name
+            Entry entries_[cCapacity]; ///< Open addressed by type id
+        };
+    } // END: detail
+#endif
+
+    namespace detail
+    {
+        /** @return Compiler generated name of Data, identical across modules built by the same compiler
+         */
+        template< typename Data >
+        inline const char* compilerTypeName()
+        {
+#if defined(_MSC_VER)
+            return __FUNCSIG__;
+#else
+            return __PRETTY_FUNCTION__;
+#endif
+        }
+
+        /** @return Label of a compile-time channel, nullptr for the default channel else the registered or compiler generated tag name
+         */
+        template< typename Channel >
+        inline const char* channelLabel()
+        { return std::is_void<Channel>::value ? 0/*nullptr*/ : (TypeName<Channel>::cRegistered ? TypeName<Channel>::name() : compilerTypeName<Channel>()); }
+    } // END: detail
+
+#if SUB0PUB_SHARED_BROKERS
+    namespace detail
+    {
+        /** @return Name keying Data in the BrokerRegistry, the registered name or else the compiler generated name
+         */
+        template< typename Data >
+        inline const char* registryName()
+        { return TypeName<Data>::cRegistered ? TypeName<Data>::name() : compilerTypeName<Data>(); }
+
+        /** @return Id indexing Data in the BrokerRegistry, the registered id or else the hash of the compiler generated name
+         */
+        template< typename Data >
+        inline uint32_t registryId()
+        { return TypeName<Data>::cRegistered ? TypeName<Data>::id() : utility::hash( compilerTypeName<Data>() ); }
+    } // END: detail
+#endif
 
-        virtual ~Publish()
-        { broker_.unsubscribe(this); } ///< @todo Make implicit broker handle
+    namespace detail
+    {
+#if SUB0PUB_THREADS
+        /** Single Data slot under a sequence lock, written by any thread and copied without blocking the writer
+         * @remark The sequence is odd while a write is in progress, a read retries when the sequence changed during its copy so
+         *  never returns a torn value. Concurrent writers are serialised on the sequence. The slot is held as atomic words so
+         *  copies racing a write are well defined.
+         * @tparam Data  Slot type @note Must be trivially copyable
+         */
+        template< typename Data >
+        class SeqLockSlot
+        {
+            static_assert( std::is_trivially_copyable<Data>::value, "SeqLockSlot copies Data as raw words" );
 
-        /** Publish data to subscribers
-         * @param[in]  data  Data value to publish to subscribers
-         * @remark Data will be received by Subscribe<Data>::receive
+        public:
+            SeqLockSlot()
+                : sequence_(0U)
+                , words_()
+            {}
+
+            /** Overwrite the slot
+             */
+            void write( const Data& data )
+            {
+                uint32_t sequence = sequence_.load( std::memory_order_relaxed );
+                for ( ;; )
+                {
+                    if ( ((sequence & 1U) == 0U) && sequence_.compare_exchange_weak( sequence, sequence + 1U, std::memory_order_acquire, std::memory_order_relaxed ) )
+                        break;
+                    if ( sequence & 1U )
+                    {
+                        std::this_thread::yield(); //< Another thread is writing
+                        sequence = sequence_.load( std::memory_order_relaxed );
+                    }
+                }
+                store( data, sequence );
+            }
+
+            /** Write the slot only when never written
+             * @remark A write racing seed() is never overwritten by it, so a stale value cannot replace a newer one
+             * @return False when the slot has been written
+             */
+            bool seed( const Data& data )
+            {
+                uint32_t sequence = 0U;
+                if ( !sequence_.compare_exchange_strong( sequence, 1U, std::memory_order_acquire, std::memory_order_relaxed ) )
+                    return false;
+                store( data, 0U );
+                return true;
+            }
+
+            /** Copy the slot
+             * @param[out] data  Slot content, unchanged when never written
+             * @return False when never written
+             */
+            bool read( Data& data ) const
+            {
+                uintptr_t words[cWords];
+                for ( ;; )
+                {
+                    const uint32_t sequence = sequence_.load( std::memory_order_acquire );
+                    if ( sequence == 0U )
+                        return false;
+
+                    if ( (sequence & 1U) == 0U )
+                    {
+                        for ( uint32_t iWord = 0U; iWord < cWords; ++iWord )
+                            words[iWord] = words_[iWord].load( std::memory_order_relaxed );
+                        std::atomic_thread_fence( std::memory_order_acquire );
+                        if ( sequence_.load( std::memory_order_relaxed ) == sequence )
+                            break;
+                    }
+                    std::this_thread::yield(); //< Write in progress
+                }
+                std::memcpy( &data, words, sizeof(Data) );
+                return true;
+            }
+
+            /** @return Count of writes @note Wraps at 2^31
+             */
+            uint32_t version() const
+            { return sequence_.load( std::memory_order_acquire ) >> 1U; }
+
+        private:
+            static const uint32_t cWords = (sizeof(Data) + sizeof(uintptr_t) - 1U) / sizeof(uintptr_t); ///< Slot size in words
+
+            /** Copy data into the slot held odd by this writer and release it
+             * @param sequence  Even sequence the slot had before this writer claimed it
+             */
+            void store( const Data& data, const uint32_t sequence )
+            {
+                uintptr_t words[cWords];
+                words[cWords - 1U] = 0U; //< @note Defined padding of a partial last word
+                std::memcpy( words, &data, sizeof(Data) );
+
+                std::atomic_thread_fence( std::memory_order_release );
+                for ( uint32_t iWord = 0U; iWord < cWords; ++iWord )
+                    words_[iWord].store( words[iWord], std::memory_order_relaxed );
+                sequence_.store( sequence + 2U, std::memory_order_release );
+            }
+
+            std::atomic<uint32_t> sequence_; ///< Twice the write count, odd while writing
+            std::atomic<uintptr_t> words_[cWords]; ///< Slot content
+        };
+#endif
+
+        /** Last published Data of a broker, replayed to new subscribers when BrokerTraits<Data>::cCacheLast
+         * @note Every publish writes the slot, so BrokerState rejects caching with concurrent publishers (cConcurrent)
+         * @tparam Data  Cached type
+         * @tparam cEnabled  BrokerTraits<Data>::cCacheLast, nothing is stored when false
          */
-        void publish( const Data& data ) const
+        template< typename Data, bool cEnabled >
+        struct LastValue
         {
-            detail::Check::onPublish( *this, data );
-            broker_.publish(data); //< @todo Add 'this' as traceability to data source for broker specialisation etc
-        }
+            void write( const Data& )
+            {}
+
+            bool read( Data& ) const
+            { return false; }
+
+            uint32_t version() const
+            { return 0U; }
+        };
+
+#if SUB0PUB_THREADS
+        template< typename Data >
+        struct LastValue<Data, true> : SeqLockSlot<Data>
+        {};
+#else
+        template< typename Data >
+        struct LastValue<Data, true>
+        {
+            static_assert( std::is_trivially_copyable<Data>::value, "BrokerTraits::cCacheLast copies Data as raw bytes" );
 
+            LastValue()
+                : cached(false)
+                , writes(0U)
+            {}
+
+            void write( const Data& data )
+            {
+                std::memcpy( &value, &data, sizeof(Data) );
+                cached = true;
+                ++writes;
+            }
+
+            bool read( Data& data ) const
+            {
+                if ( cached )
+                    std::memcpy( &data, &value, sizeof(Data) );
+                return cached;
+            }
+
+            uint32_t version() const
+            { return writes; }
+
+            typename std::aligned_storage<sizeof(Data), alignof(Data)>::type value; ///< Last published Data
+            bool cached; ///< A value has been published
+            uint32_t writes; ///< Count of writes, compared by Broker::replay to skip a value older than one delivered
+        };
+#endif
+
+        /** Subscription table and identity of a Broker<Data, Channel>
+         * @tparam Data  Data type of the subscriptions
+         */
+        template< typename Data >
+        struct BrokerState
+        {
+            static_assert( !(BrokerTraits<Data>::cCacheLast && BrokerTraits<Data>::cConcurrent)
+                , "BrokerTraits::cCacheLast serialises every publish on the cached slot, concurrent publishers would spin on it" );
+
+            typedef typename SubscriptionTable<Subscription<Data>, BrokerTraits<Data> >::type SubscriptionTable;
+
+            SubscriptionTable subscriptions; ///< Subscription table selected by BrokerTraits<Data>
+            LastValue<Data, BrokerTraits<Data>::cCacheLast> last; ///< Last published Data when BrokerTraits<Data>::cCacheLast
 #if SUB0PUB_TYPEIDNAME
-        /** Get name identifier of the Data from the broker
-         * @return Broker null-terminated type name
-        */
-        const char* typeName() const
-        { return broker_.typeName(); }
+            uint32_t typeId; ///< Type identifier index or name hash
+            const char* typeName; ///< user defined data name overrides non-portable compiler generated name
+#endif
+#if SUB0PUB_STATS
+            BrokerStats stats; ///< Statistics of the channel
+#endif
 
-        /** Get unique identifier of the Data from the broker
-         * @return Broker unique type index
-        */
-        uint32_t typeId() const
-        { return broker_.typeId(); }
+            /** Construct the state of a channel
+             * @param channel  Label of the channel in statistics, nullptr for the default channel @see channelLabel()
+             */
+            explicit BrokerState( const char* const channel = 0/*nullptr*/ )
+                : subscriptions()
+                , last()
+#if SUB0PUB_TYPEIDNAME
+                , typeId( TypeName<Data>::id() )
+                , typeName( TypeName<Data>::name() )
+#endif
+#if SUB0PUB_STATS
+                , stats( &StatsT<Data>::typeName, &StatsT<Data>::typeId, channel )
+#endif
+            {
+                (void)channel;
+                static_assert( alignof(BrokerState) <= alignof(std::max_align_t), "Broker state is heap allocated by runtime channels and shared brokers, C++11 new does not over-align" );
+            }
+        };
 
-        /** Stream operator for diagnostics reporting
-         * @param stream  Stream to report into
-         * @param publisher  Publisher instance to be written into stream
-         * @return Reference to 'stream'
+        /** Binds a Broker to the MonoState of a compile-time channel of Data
+         * @tparam Data  Data type of the channel
+         * @tparam Channel  Tag type of the channel, void for the default channel
          */
-        friend OStream& operator<< ( OStream& stream, const Publish<Data>& publisher )
-        { return stream << publisher.typeName() << '{' << (void*)&publisher << '}'; }
+        template< typename Data, typename Channel >
+        class ChannelBinding
+        {
+        public:
+            typedef BrokerState<Data> State;
+
+            /** @return MonoState of the channel
+             */
+            static State& state()
+            {
+#if SUB0PUB_SHARED_BROKERS
+                State* const shared = sharedState_.load( std::memory_order_acquire );
+                return shared ? *shared : resolveState();
+#else
+                return state_;
+#endif
+            }
+
+#if SUB0PUB_SHARED_BROKERS
+        private:
+            /** Look up the process-wide state on first use in this module
+             */
+            static State& resolveState()
+            {
+                const char* const name = std::is_void<Channel>::value ? registryName<Data>() : compilerTypeName<ChannelBinding>();
+                const uint32_t id = std::is_void<Channel>::value ? registryId<Data>() : utility::hash( name );
+                State* const shared = static_cast<State*>( BrokerRegistry::instance().find( id, name, &createState, channelLabel<Channel>() ) );
+                sharedState_.store( shared, std::memory_order_release );
+                return *shared;
+            }
+
+            static void* createState( const char* const channel )
+            { return new State( channel ); }
+
+            static std::atomic<State*> sharedState_; ///< Process-wide state cached on first use, nullptr until then
+#else
+            static State state_; ///< MonoState subscription table
 #endif
+        };
 
-    private:
-        Broker<Data> broker_; ///< MonoState broker instance to manage publish-subscribe connections
-    };
+#if SUB0PUB_SHARED_BROKERS
+        template< typename Data, typename Channel >
+        std::atomic<typename ChannelBinding<Data, Channel>::State*> ChannelBinding<Data, Channel>::sharedState_( 0/*nullptr*/ );
+#else
+        /** Monotonic broker state
+         */
+        template< typename Data, typename Channel >
+        typename ChannelBinding<Data, Channel>::State ChannelBinding<Data, Channel>::state_( channelLabel<Channel>() );
+#endif
 
-#pragma warning(pop)
+        /** States of the runtime channels of Data
+         * @remark Looked up when a Publish/Subscribe is constructed so publish reads the state through the Broker pointer alone.
+         *  States are created on first use of a ChannelId and never freed.
+         * @tparam Data  Data type of the channels
+         */
+        template< typename Data >
+        class RuntimeChannels
+        {
+        public:
+            typedef BrokerState<Data> State;
+
+            /** @return State of the channel, created when first seen
+             */
+            static State& find( const ChannelId channel )
+            {
+#if SUB0PUB_SHARED_BROKERS
+                const char* const dataName = registryName<Data>();
+                std::vector<char> name( std::strlen(dataName) + 12U ); //< "<dataName>#<channel>"
+                std::snprintf( name.data(), name.size(), "%s#%u", dataName, static_cast<unsigned>(channel.value) );
+                return *static_cast<State*>( BrokerRegistry::instance().find( utility::hash( name.data() ), name.data(), &createState
+                    , name.data() + std::strlen(dataName) ) );
+#else
+                RuntimeChannels& channels = instance();
+#if SUB0PUB_THREADS
+                std::lock_guard<std::mutex> lock( channels.mutex_ );
+#endif
+                for ( const Entry* entry = channels.entries_; entry; entry = entry->next )
+                {
+                    if ( entry->channel == channel.value )
+                        return *entry->state;
+                }
+#if SUB0PUB_STATS
+                char label[16];
+                std::snprintf( label, sizeof(label), "#%u", static_cast<unsigned>(channel.value) );
+                Entry* const entry = new Entry( channel.value, new State( label ), channels.entries_ );
+#else
+                Entry* const entry = new Entry( channel.value, new State(), channels.entries_ );
+#endif
+                channels.entries_ = entry;
+                return *entry->state;
+#endif
+            }
+
+        private:
+#if SUB0PUB_SHARED_BROKERS
+            static void* createState( const char* const channel )
+            { return new State( channel ); }
+#else
+            struct Entry
+            {
+                Entry( const uint32_t entryChannel, State* const entryState, const Entry* const entryNext )
+                    : channel(entryChannel)
+                    , state(entryState)
+                    , next(entryNext)
+                {}
+
+                const uint32_t channel;
+                State* const state;
+                const Entry* const next; ///< Entry created before this one
+            };
+
+            RuntimeChannels()
+                : entries_(0/*nullptr*/)
+            {}
+
+            static RuntimeChannels& instance()
+            {
+                static RuntimeChannels channels;
+                return channels;
+            }
+
+            const Entry* entries_; ///< Most recently created entry, never freed
+#if SUB0PUB_THREADS
+            std::mutex mutex_; ///< Serialises find()
+#endif
+#endif
+        };
+
+        /** Binds a Broker to the state of a runtime channel of Data chosen on construction
+         * @tparam Data  Data type of the channel
+         */
+        template< typename Data >
+        class ChannelBinding<Data, RuntimeChannel>
+        {
+        public:
+            typedef BrokerState<Data> State;
+
+            explicit ChannelBinding( const ChannelId channel )
+                : state_( &RuntimeChannels<Data>::find( channel ) )
+            {}
+
+            /** @return State of the bound channel
+             */
+            State& state() const
+            { return *state_; }
+
+        private:
+            State* state_; ///< Channel state, never freed
+        };
+    } // END: detail
 
     /** Broker manages publisher-subscriber connection for a data-type
+     * @remark Define SUB0PUB_SHARED_BROKERS=true to share the broker of each Data type between shared libraries
      * @tparam Data  Data type which this instance manages connections for
-     * @todo Cross-module support
+     * @tparam Channel  Channel of Data, void for the default channel, a tag type for a compile-time channel or RuntimeChannel
+     *  for a channel given by ChannelId on construction. Each channel has its own subscription table.
      */
-    template< typename Data >
-    class Broker
+    template< typename Data, typename Channel >
+    class Broker : private detail::ChannelBinding<Data, Channel>
     {
+        typedef detail::ChannelBinding<Data, Channel> Binding;
+        typedef typename Binding::State State;
+        using Binding::state;
+
     public:
-        static const uint32_t cMaxSubscriptions = 8U; ///< Subscription limit in fixed table per broker
+        typedef BrokerTraits<Data> Traits; ///< Compile-time configuration for the Data type
+        static const uint32_t cMaxSubscriptions = Traits::cMaxSubscriptions; ///< Subscription limit in fixed table per broker @note Initial capacity when Traits::cGrowable
 
     public:
-        /** Registers subscriber in brokers subscription table
+        /** Registers subscription in brokers subscription table
+         * @param[in] subscription  Receive function and context to call on publish
          * @param[in] typeName Optional unique data name given to data for inter-process signaling. 
          * @warning If typeName not supplied compiler generated names 'may' be used which are non-portable between vendors.
          */
-        Broker( Subscribe<Data>* subscriber
+        Broker( const Subscription<Data>& subscription
 #if SUB0PUB_TYPEIDNAME
             , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/ 
 #endif
         )
         {
-            detail::Check::onSubscription( *this, subscriber, state_.subscriptionCount, cMaxSubscriptions );
 #if SUB0PUB_TYPEIDNAME
             setDataName(typeId, typeName);
 #endif
-            state_.subscriptions[state_.subscriptionCount++] = subscriber;
+            subscribe( subscription );
+        }
+
+        /** Registers subscription in the subscription table of a runtime channel
+         * @param[in] channel  Channel of the subscription, requires Channel = RuntimeChannel
+         * @see Broker(const Subscription<Data>&)
+         */
+        Broker( const ChannelId channel, const Subscription<Data>& subscription
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+            : Binding( channel )
+        {
+            static_assert( std::is_same<Channel, RuntimeChannel>::value, "ChannelId requires Channel = RuntimeChannel" );
+#if SUB0PUB_TYPEIDNAME
+            setDataName(typeId, typeName);
+#endif
+            subscribe( subscription );
+        }
+
+        /** Binds the channel without a subscription, registered later by subscribe()
+         * @param[in] typeName Optional unique data name given to data for inter-process signaling.
+         */
+        explicit Broker( const Unsubscribed
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+        {
+#if SUB0PUB_TYPEIDNAME
+            setDataName(typeId, typeName);
+#endif
+        }
+
+        /** Binds a runtime channel without a subscription, registered later by subscribe()
+         * @param[in] channel  Channel of the subscription, requires Channel = RuntimeChannel
+         * @see Broker(Unsubscribed)
+         */
+        Broker( const ChannelId channel, const Unsubscribed
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+            : Binding( channel )
+        {
+            static_assert( std::is_same<Channel, RuntimeChannel>::value, "ChannelId requires Channel = RuntimeChannel" );
+#if SUB0PUB_TYPEIDNAME
+            setDataName(typeId, typeName);
+#endif
         }
 
         /** Validated publication
@@ -487,7 +3793,7 @@ namespace sub0
          * @param[in] typeName Optional unique data name given to data for inter-process signalling. 
          * @warning If typeName not supplied compiler generated names 'may' be used which are non-portable between vendors.
          */
-        Broker ( Publish<Data>* publisher
+        Broker ( Publish<Data, Channel>* publisher
 #if SUB0PUB_TYPEIDNAME
             , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
 #endif
@@ -500,39 +3806,69 @@ namespace sub0
             // Do nothing for now...
         }
 
-        void unsubscribe(Subscribe<Data>* subscriber)
+        /** Validated publication on a runtime channel
+         * @param[in] channel  Channel of the publisher, requires Channel = RuntimeChannel
+         * @see Broker(Publish<Data, Channel>*)
+         */
+        Broker( const ChannelId channel, Publish<Data, Channel>* publisher
+#if SUB0PUB_TYPEIDNAME
+            , const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+            : Binding( channel )
+        {
+            static_assert( std::is_same<Channel, RuntimeChannel>::value, "ChannelId requires Channel = RuntimeChannel" );
+            detail::Check::onPublication( publisher, *this, 0, 1/* @note No limit at present */ );
+#if SUB0PUB_TYPEIDNAME
+            setDataName(typeId, typeName);
+#endif
+        }
+
+        /** Insert a subscription into the channel table
+         * @remark A full fixed table is reported through failure(), raise BrokerTraits<Data>::cMaxSubscriptions or set cGrowable
+         */
+        void subscribe( const Subscription<Data>& subscription )
+        {
+            detail::Check::onSubscription( *this, subscription, state().subscriptions.size(), state().subscriptions.maxSize() );
+            Subscription<Data> entry( subscription );
+            detail::Stats<Data>::attach( state(), entry );
+            if ( !state().subscriptions.insert( entry ) )
+                failure( "Sub0Pub - subscription table full, increase BrokerTraits::cMaxSubscriptions" );
+        }
+
+        void unsubscribe( const Subscription<Data>& subscription )
         {
-            Subscribe<Data>** const iBegin = state_.subscriptions;
-            Subscribe<Data>** const iEnd = iBegin + state_.subscriptionCount;
-            Subscribe<Data>** const iPend = std::remove(iBegin, iEnd, subscriber );
-            assert(std::distance(iPend,iEnd ) == 1);
-            --state_.subscriptionCount;
+            const bool removed = state().subscriptions.remove( subscription );
+            assert( removed || !"Subscription not found, subscription table capacity may have been exceeded" );
+            (void)removed;
+            detail::Stats<Data>::detach( state(), subscription.context );
         }
 
-        void unsubscribe(Publish<Data>* publisher)
+        void unsubscribe(Publish<Data, Channel>*)
         {
             // Do nothing for now...
         }
 
 #if SUB0PUB_TYPEIDNAME
         /** Set a unique identifier for the data the broker manages
-         * @remark This name is used during serialisation for inter-process communications
+         * @remark This name is used during serialisation for inter-process communications and is shared by all channels of Data
          * @param[in]  typeName  Null terminated compile-time string constant
          */
-        void setDataName(const uint32_t typeId, const char* const typeName )
+        static void setDataName(const uint32_t typeId, const char* const typeName )
         {
+            State& identity = dataState();
             if (typeId)
             {
                 // Check if assigning a different name or Id is when already set
-                assert( !state_.typeId || (state_.typeId==typeId) );// @todo use RuntimeCheck and handle if a subscriber uses a different name better
-                state_.typeId = typeId; /// @todo sub0::utility::hash(state_.typeName); // Cache hash result @todo Make compile time
+                assert( !identity.typeId || (identity.typeId==typeId) );// @todo use RuntimeCheck and handle if a subscriber uses a different name better
+                identity.typeId = typeId; ///< @note Prefer SUB0_TYPENAME which sets the id at compile time
             }
 
             if (typeName)
             {
                 // Check if assigning a different name or Id is when already set
-                assert( !state_.typeName || (std::strcmp(state_.typeName,typeName)==0) );// @todo use RuntimeCheck and handle if a subscriber uses a different name better
-                state_.typeName = typeName;
+                assert( !identity.typeName || (std::strcmp(identity.typeName,typeName)==0) );// @todo use RuntimeCheck and handle if a subscriber uses a different name better
+                identity.typeName = typeName;
             }
         }
 #endif
@@ -542,18 +3878,81 @@ namespace sub0
          */
         void publish(const Data& data) const
         {
-            for (uint32_t iSubscription = 0U; iSubscription < state_.subscriptionCount; ++iSubscription )
+            state().last.write( data );
+            const typename State::SubscriptionTable::Reader subscriptions( state().subscriptions );
+            const Subscription<Data>* const iEnd = subscriptions.end();
+            typename detail::Stats<Data>::Publication stats( state(), 1U );
+            for ( const Subscription<Data>* iSubscription = subscriptions.begin(); iSubscription != iEnd; ++iSubscription )
             {
-                Subscribe<Data>* subscription = state_.subscriptions[iSubscription];
-                detail::Check::onReceive( subscription, data );
+                detail::Check::onReceive( *iSubscription, data );
+                iSubscription->receive( iSubscription->context, data );
+                stats.onReceive( *iSubscription );
+            }
+        }
 
-                if ( subscription->filter(data))
+        /** Send contiguous data to registered subscribers
+         * @param data  First of 'count' data sent to subscribers via their batch receive, or per element via 'receive()'
+         * @param count  Count of data
+         */
+        void publishBatch( const Data* data, const size_t count ) const
+        {
+            if ( count == 0U )
+                return;
+
+            state().last.write( data[count - 1U] );
+            const typename State::SubscriptionTable::Reader subscriptions( state().subscriptions );
+            const Subscription<Data>* const iEnd = subscriptions.end();
+            typename detail::Stats<Data>::Publication stats( state(), count );
+            for ( const Subscription<Data>* iSubscription = subscriptions.begin(); iSubscription != iEnd; ++iSubscription )
+            {
+                detail::Check::onReceive( *iSubscription, *data );
+                if ( iSubscription->receiveBatch )
+                {
+                    iSubscription->receiveBatch( iSubscription->context, data, count );
+                }
+                else
                 {
-                    subscription->receive(data);
+                    for ( const Data* iData = data; iData != (data + count); ++iData )
+                    {
+                        iSubscription->receive( iSubscription->context, *iData );
+                    }
                 }
+                stats.onReceive( *iSubscription, count );
             }
         }
 
+        /** Deliver the last published Data to a subscription
+         * @remark Does nothing unless BrokerTraits<Data>::cCacheLast and Data has been published on the channel
+         * @note A publish from another thread during replay may reach the subscription before or after the replayed value,
+         *  registered subscriptions replay with the version taken at registration instead
+         * @param subscription  Subscription to deliver to, need not be registered
+         * @return True when a value was delivered
+         */
+        bool replay( const Subscription<Data>& subscription ) const
+        { return replay( subscription, lastVersion(), false ); }
+
+        /** Deliver the last published Data to a subscription registered when the cache was at 'version'
+         * @remark Subscribers replay once registered and able to receive, which for Subscribe and DirectSubscribe is after the
+         *  most-derived constructor. A publish writing the cache after 'version' was taken reaches the subscription itself,
+         *  so the replay is skipped rather than deliver an older value after it.
+         * @param subscription  Registered subscription to deliver to
+         * @param version  lastVersion() taken after registering the subscription
+         * @return True when a value was delivered
+         */
+        bool replay( const Subscription<Data>& subscription, const uint32_t version ) const
+        { return replay( subscription, version, true ); }
+
+        /** @return Count of writes to the cached last Data, 0 unless BrokerTraits<Data>::cCacheLast @note Wraps at 2^31
+         */
+        uint32_t lastVersion() const
+        { return state().last.version(); }
+
+        /** Count a Data of the channel rejected by a subscriber filter()
+         * @remark Does nothing unless SUB0PUB_STATS
+         */
+        void onFilterReject() const
+        { detail::Stats<Data>::onFilterReject( state() ); }
+
         /** Prints address of monotonic state
          * @param stream  Stream to output into
          * @param broker  Broker instance to output for
@@ -562,7 +3961,7 @@ namespace sub0
 #if 0 ///@todo Remove unecessary stream operations: 
         friend OStream& operator<< ( OStream& stream, const Broker<Data>& broker )
         {
-            return stream << (void*)&broker.state_;
+            return stream << (void*)&state();
         }
 #endif
 
@@ -571,47 +3970,90 @@ namespace sub0
          */
         static uint32_t typeId()
         {
-            return state_.typeId;
+            return dataState().typeId;
         }
 
         /** @return Unique identifier name for inter-process text connections
          */
         static const char* typeName()
         {
-            return state_.typeName;
+            return dataState().typeName;
         }
 #endif
 
     private:
-        /** Object state as monotonic object shared by all instances
+        bool replay( const Subscription<Data>& subscription, const uint32_t version, const bool ordered ) const
+        {
+            typename std::aligned_storage<sizeof(Data), alignof(Data)>::type storage; //< @note Data need not be default constructible
+            Data& data = reinterpret_cast<Data&>( storage );
+            if ( !state().last.read( data ) )
+                return false;
+            if ( ordered && (state().last.version() != version) )
+                return false; //< Published since registering, the subscription has received a newer value
+
+            detail::Check::onReceive( subscription, data );
+            subscription.receive( subscription.context, data );
+            return true;
+        }
+
+        static void failure( const char* const failureMessage )
+        {
+#if __cpp_exceptions
+            throw std::runtime_error(failureMessage);
+#else
+            assert((void*)0 == failureMessage);
+#endif
+        }
+
+        /** @return State of the default channel which holds the identity of Data for every channel
          */
-        struct State
+        static State& dataState()
+        {
+            return detail::ChannelBinding<Data, void>::state();
+        }
+    };
+
+#if SUB0PUB_SHARED_BROKERS
+#define SUB0_BROKERSTATE(Data) ///< State is allocated by the BrokerRegistry
+#else
+    /** Explicit allocation of monotonic state
+    @note Enables appearing within Globals for ELF embedded targets
+    */
+#define SUB0_BROKERSTATE(Data) \
+    namespace sub0 { namespace detail { template<> ChannelBinding<Data, void>::State ChannelBinding<Data, void>::state_ {}; } } 
+#endif
+
+    namespace detail
+    {
+        template< typename Data >
+        constexpr uint32_t typeId( std::true_type /*registered*/ )
+        { return TypeName<Data>::id(); }
+
+        template< typename Data >
+        inline uint32_t typeId( std::false_type /*registered*/ )
         {
-            uint32_t subscriptionCount; ///< Count of subscriptions_
-            Subscribe<Data>* subscriptions[cMaxSubscriptions];    ///< Subscription table @todo More flexible count-support
 #if SUB0PUB_TYPEIDNAME
-            uint32_t typeId; ///< Type identifier index or name hash
-            const char* typeName; ///< user defined data name overrides non-portable compiler-generated name
+            return Broker<Data>::typeId(); //< Runtime id given to the Publish/Subscribe constructors
+#else
+            static_assert( TypeName<Data>::cRegistered, "Serialised Data requires a type id, register with SUB0_TYPENAME(Data, \"Name\") or SUB0_TYPEID(Data, \"Name\", id)" );
+            return 0U;
 #endif
-            State() 
-                : subscriptionCount(0)
-                , subscriptions() 
-            {}
-        };
-        static State state_; ///< MonoState subscription table
-    };
+        }
+    } // END: detail
 
-    /** Monotonic broker state
-     * @todo State should be shared across module boundaries and owned/defined in a single module e.g. std::cout like singleton
+    /** @return Identifier of Data used in serialised headers
+     * @remark Constant expression for types registered with SUB0_TYPENAME or SUB0_TYPEID, otherwise the runtime
+     *  identifier given to Publish/Subscribe constructors when SUB0PUB_TYPEIDNAME
      */
-    template<typename Data>
-    typename Broker<Data>::State Broker<Data>::state_ = Broker<Data>::State();
+    template< typename Data >
+    constexpr uint32_t typeId()
+    { return detail::typeId<Data>( std::integral_constant<bool, TypeName<Data>::cRegistered>() ); }
 
-    /** Explicit allocation of monotonic state
-    @note Enables appearing within Globals for ELF embedded targets
-    */
-#define SUB0_BROKERSTATE(Data) \
-    namespace sub0 {  template<> Broker<Data>::State Broker<Data>::state_ = Broker<Data>::State(); } 
+    /** @return Registered name of Data or nullptr @see SUB0_TYPENAME
+     */
+    template< typename Data >
+    constexpr const char* typeName()
+    { return TypeName<Data>::name(); }
     
     /** Publish data, used when inheriting from multiple Publish<> base types
      * @remark Circumvents C++ Name-Hiding limitations when multiple Publish<> base types are present 
@@ -637,6 +4079,40 @@ namespace sub0
         publish(*from, data);
     }
 
+    /** Publish data on a channel, used when inheriting from Publish<> base types of several channels
+     * @see publish(const From&,const Data&)
+     * @tparam Channel  Channel of the base Publish<Data, Channel> object of From e.g. `publish<LeftCamera>( *this, image )`
+     */
+    template<typename Channel, typename From, typename Data>
+    inline void publish(From& from, const Data& data)
+    {
+        const Publish<Data, Channel>& publisher = from;
+        publisher.publish(data);
+    }
+
+    /** Publish contiguous data, used when inheriting from multiple Publish<> base types
+     * @see publish(const From&,const Data&)
+     *
+     * @param[in] from  Producer object inheriting from one or more Publish<> objects
+     * @param[in] first  First of 'count' data published using the base Publish<Data> object of From
+     * @param[in] count  Count of data
+     */
+    template<typename From, typename Data>
+    inline void publishBatch(From& from, const Data* first, const size_t count)
+    {
+        const Publish<Data>& publisher = from;
+        publisher.publishBatch(first, count);
+    }
+
+    /** @see publishBatch(From&,const Data*,size_t)
+    */
+    template<typename From, typename Data>
+    inline void publishBatch(From* const from, const Data* first, const size_t count)
+    {
+        assert(from != nullptr);
+        publishBatch(*from, first, count);
+    }
+
 #if SUB0_EXPERIMENTAL //< @todo Decide if this should be part of the API to allow calling from global code easily... better make it the users duty? i.e.e use of static non-owner traceability of data sources could compilcate future features?
     /** C-compatibile global-publish wihout use of registered Publisher
     * @warning Use with caution as each instantiation creates a static
@@ -660,33 +4136,120 @@ namespace sub0
         /** Publish the data owned by the object
          */
         virtual void publish() = 0;
+
+        /** Claim the buffer the next payload is read into
+         * @remark Called by the data provider before reading each payload, N-buffered publishers return a free slot
+         * @return Buffer for the payload, nullptr to read into the buffer registered with setDataPublisher()
+         */
+        virtual char* acquire()
+        { return nullptr; }
     };
 
+    /** Writes prefix, header, payload and postfix records assembled contiguously so each reaches the stream in one write
+     * @remark Records are coalesced until at least the buffer size in bytes is pending, a buffer size of zero writes every
+     *  record (or batch) immediately. Pending records are written by flush() or close().
+     */
     template< typename Prefix_t
             , typename Header_t
             , typename Postfix_t >
     class BinaryWriter
     {
     public:
+        BinaryWriter()
+            : buffer_()
+            , bufferSize_(0U)
+        {}
+
+        /** Set the count of pending bytes at which records are written to the stream
+         * @param bufferSize  Byte threshold, zero to write each record immediately
+         */
+        void setBufferSize( const size_t bufferSize )
+        {
+            bufferSize_ = bufferSize;
+            buffer_.reserve( bufferSize );
+        }
+
         /** Output header and pay-load for data as binary
          * @param stream  Stream to write into
          * @param data  Data to construct a header record and data payload for
+         * @return False if the stream write failed
+         */
+        template<typename Data>
+        inline bool write(OStream& stream, const Data& data)
+        {
+            put( reserve(recordSize<Data>()), data );
+            return (buffer_.size() < bufferSize_) || flush(stream);
+        }
+
+        /** Output header and pay-load records for contiguous data
+         * @remark Unbuffered the batch is issued as a single stream write
+         * @param stream  Stream to write into
+         * @param data  First of 'count' data to construct records for
+         * @param count  Count of data
+         * @return False if the stream write failed
          */
         template<typename Data>
-        inline bool write(OStream& stream, const Data& data) const
+        bool writeBatch(OStream& stream, const Data* data, const size_t count)
+        {
+            char* record = reserve( count * recordSize<Data>() );
+            for ( const Data* const iEnd = data + count; data != iEnd; ++data )
+            {
+                record = put( record, *data );
+            }
+            return (buffer_.size() < bufferSize_) || flush(stream);
+        }
+
+        /** Write pending records to the stream
+         * @remark Bytes the stream did not accept stay pending and are written first by the next flush
+         * @return False if the stream write failed or was partial
+         */
+        bool flush( OStream& stream )
         {
-            Header_t header(data);
-            return utility::write<Prefix_t>(stream)
-                && utility::write(stream, Header_t(data) )
-                && utility::write(stream, data )
-                && utility::write<Postfix_t>(stream);
+            if ( buffer_.empty() )
+                return true;
+
+            const size_t written = utility::writeSome( stream, buffer_.data(), buffer_.size() );
+            buffer_.erase( written ); //< @note Capacity is retained so steady-state writes do not allocate
+            return buffer_.empty();
         }
 
         void close( OStream& stream  )
         {
-            /* Do nothing */
+            flush( stream );
+        }
+
+    private:
+        template<typename Data>
+        static constexpr size_t recordSize()
+        {
+            return utility::SizeOf<Prefix_t>::value + sizeof(Header_t) + sizeof(Data) + utility::SizeOf<Postfix_t>::value;
         }
 
+        /** Extend pending records by 'count' bytes
+         * @return First of the appended bytes
+         */
+        char* reserve( const size_t count )
+        {
+            const size_t offset = buffer_.size();
+            buffer_.resize( offset + count );
+            return buffer_.data() + offset;
+        }
+
+        /** Assemble record for data
+         * @return Position following the record
+         */
+        template<typename Data>
+        static char* put( char* record, const Data& data )
+        {
+            record = utility::put<Prefix_t>( record );
+            record = utility::put( record, Header_t(data) );
+            record = utility::put( record, data );
+            return utility::put<Postfix_t>( record );
+        }
+
+    private:
+        utility::ByteBuffer buffer_; ///< Records pending write
+        size_t bufferSize_; ///< Pending byte count at which records are written
     };
 
     struct Buffer
@@ -697,7 +4260,48 @@ namespace sub0
         IPublish* publisher; ///< Type specific publish of buffer
     };
 
-    /** @tparam  cMaxDataBufferCount  Defines the maximum number of Data type buffers the deserializer can store
+    namespace detail
+    {
+        /** @return Buffer reading directly into the Data instance
+         */
+        template < typename Data >
+        inline Buffer bufferOf( Data& buffer, IPublish& publisher, const uint_fast16_t paddingSize )
+        {
+            return Buffer{
+                  reinterpret_cast<char*>(&buffer)
+                , static_cast<uint_fast16_t>(sizeof(buffer))
+                , paddingSize
+                , &publisher
+            };
+        }
+
+        /** @return Buffer returned for headers without a registered Data type
+         */
+        inline Buffer nullBuffer()
+        {
+            return { nullptr, 0U , 0U, nullptr };
+        }
+
+        /** @return True when bytes at 'buffer' equal a default constructed Type_t, always true for void
+         */
+        template< typename Type_t >
+        inline bool matchesDefault( const char* const buffer )
+        {
+            const Type_t defaulted;
+            return std::memcmp( buffer, &defaulted, sizeof(defaulted) ) == 0;
+        }
+
+        template<>
+        inline bool matchesDefault<void>( const char* const )
+        {
+            return true;
+        }
+    } // END: detail
+
+    /** Data buffer lookup by header using binary search over a sorted array
+     * @remark Suited to few Data types or sparse type ids where memory is constrained. Alternative lookups with the same
+     *  interface are DenseBufferRegister and HashBufferRegister, selected by the BinaryReader BufferRegister parameter.
+     * @tparam  cMaxDataBufferCount  Defines the maximum number of Data type buffers the deserializer can store
     */
     template< typename Header_t, uint_fast16_t cMaxDataBufferCount = 64U >
     class BufferRegister
@@ -713,7 +4317,6 @@ namespace sub0
 
         /** Register a sink to the specified typed Data buffer
          * @remark Performs insertion sorting on buffers by the IPublish::typeId() for the buffer
-         * @todo Make search meahcnism selectable i.e. Array-index, hash, or binary-lookup etc
          * @remark Called by sub0::ForwardPublish<Data>
          *
          * @param[in] publisher  Buffer handling object to store and signal data completion
@@ -723,13 +4326,7 @@ namespace sub0
         template < typename Data >
         void set(Data& buffer, IPublish& publisher, const uint_fast16_t paddingSize = 0U )
         {
-            set( Header_t(buffer)
-               , Buffer{
-                      reinterpret_cast<char*>(&buffer)
-                    , static_cast<uint_fast16_t>(sizeof(buffer))
-                    , paddingSize
-                    , &publisher 
-               } );
+            set( Header_t(buffer), detail::bufferOf(buffer, publisher, paddingSize) );
         }
 
         void set(const Header_t& header, const Buffer& buffer)
@@ -759,7 +4356,7 @@ namespace sub0
             if ((iFind != registryEnd_) && (iFind->first == header))
                 return iFind->second;
             else
-                return { nullptr, 0U , 0U, nullptr };
+                return detail::nullBuffer();
         }
 
         /** Default validation check against provided header
@@ -768,7 +4365,7 @@ namespace sub0
          * @param header Header data to validate against
          * @return True always
         */
-        bool validate(const Header_t& header) const
+        bool validate(const Header_t& /*header*/) const
         {
             return true;
         }
@@ -783,6 +4380,184 @@ namespace sub0
         typename HeaderToBufferLookup::iterator registryEnd_; ///< Iterator to end of registry_ @note Count = registryEnd_-registry_
     };
 
+    /** Data buffer lookup directly indexed by Header_t::typeId
+     * @remark Constant time lookup for small integer type ids i.e. user assigned ids in [0,cMaxTypeId)
+     * @tparam  Header_t  Header type with an integral 'typeId' member
+     * @tparam  cMaxTypeId  Exclusive upper bound of registered type ids, the register stores one entry per id
+     */
+    template< typename Header_t, uint32_t cMaxTypeId = 256U >
+    class DenseBufferRegister
+    {
+    public:
+        DenseBufferRegister()
+            : registry_()
+        {}
+
+        /** Register a sink to the specified typed Data buffer
+         * @see BufferRegister::set
+         */
+        template < typename Data >
+        void set(Data& buffer, IPublish& publisher, const uint_fast16_t paddingSize = 0U )
+        {
+            set( Header_t(buffer), detail::bufferOf(buffer, publisher, paddingSize) );
+        }
+
+        void set(const Header_t& header, const Buffer& buffer)
+        {
+            assert(header.typeId < cMaxTypeId); //< Type id outside of the dense range, increase cMaxTypeId or use HashBufferRegister
+            if (header.typeId < cMaxTypeId)
+            {
+                Entry& entry = registry_[header.typeId];
+                entry.used = true;
+                entry.header = header;
+                entry.buffer = buffer;
+            }
+        }
+
+        Buffer find(const Header_t header)
+        {
+            if (header.typeId < cMaxTypeId)
+            {
+                const Entry& entry = registry_[header.typeId];
+                if (entry.used && (entry.header == header))
+                    return entry.buffer;
+            }
+            return detail::nullBuffer();
+        }
+
+        /** @see BufferRegister::validate
+        */
+        bool validate(const Header_t& /*header*/) const
+        {
+            return true;
+        }
+
+        void close()///< @TODO This is here as a use-case contained stream state within the buffer map! Remove/deprecate this when/as possible
+        {
+            /** Do nothing - no state to clear */
+        }
+
+    private:
+        struct Entry
+        {
+            bool used; ///< Entry has been set
+            Header_t header; ///< Registered header checked in full on lookup
+            Buffer buffer;
+        };
+
+        std::array<Entry, cMaxTypeId> registry_; ///< Entries indexed by type id
+    };
+
+    /** Data buffer lookup by Header_t::typeId using an open-addressing robin-hood hash table
+     * @remark Near constant time lookup for sparse type ids i.e. hashed type names. Entries are kept ordered by probe
+     *  distance so a miss terminates as soon as the probed entry is nearer its home slot than the key would be.
+     * @tparam  Header_t  Header type with an integral 'typeId' member
+     * @tparam  cCapacity  Table slot count, must be a power of two greater than the count of registered Data types
+     */
+    template< typename Header_t, uint32_t cCapacity = 128U >
+    class HashBufferRegister
+    {
+        static_assert( (cCapacity >= 2U) && ((cCapacity & (cCapacity - 1U)) == 0U), "HashBufferRegister capacity must be a power of two" );
+        static const uint32_t cMask = cCapacity - 1U;
+
+    public:
+        HashBufferRegister()
+            : registry_()
+            , count_(0U)
+        {}
+
+        /** Register a sink to the specified typed Data buffer
+         * @see BufferRegister::set
+         */
+        template < typename Data >
+        void set(Data& buffer, IPublish& publisher, const uint_fast16_t paddingSize = 0U )
+        {
+            set( Header_t(buffer), detail::bufferOf(buffer, publisher, paddingSize) );
+        }
+
+        void set(const Header_t& header, const Buffer& buffer)
+        {
+            Entry insert = { 1U, header, buffer };
+            uint32_t index = home(header);
+            for (;;)
+            {
+                Entry& entry = registry_[index];
+                if (entry.distance == 0U) //< Free slot
+                {
+                    assert(count_ < cMask); //< Capacity reached, a free slot is retained to bound probing
+                    entry = insert;
+                    ++count_;
+                    return;
+                }
+
+                if (entry.header.typeId == insert.header.typeId) //< Replace existing entry
+                {
+                    entry.header = insert.header;
+                    entry.buffer = insert.buffer;
+                    return;
+                }
+
+                if (entry.distance < insert.distance) //< Take the slot from the entry nearer its home and carry that on
+                    std::swap(entry, insert);
+
+                ++insert.distance;
+                index = (index + 1U) & cMask;
+            }
+        }
+
+        Buffer find(const Header_t header)
+        {
+            uint32_t index = home(header);
+            for (uint_fast16_t distance = 1U; distance <= registry_[index].distance; ++distance)
+            {
+                const Entry& entry = registry_[index];
+                if (entry.header.typeId == header.typeId)
+                    return (entry.header == header) ? entry.buffer : detail::nullBuffer();
+
+                index = (index + 1U) & cMask;
+            }
+            return detail::nullBuffer();
+        }
+
+        /** @see BufferRegister::validate
+        */
+        bool validate(const Header_t& /*header*/) const
+        {
+            return true;
+        }
+
+        void close()///< @TODO This is here as a use-case contained stream state within the buffer map! Remove/deprecate this when/as possible
+        {
+            /** Do nothing - no state to clear */
+        }
+
+    private:
+        struct Entry
+        {
+            uint_fast16_t distance; ///< Probe distance from the home slot plus one, zero when the slot is free
+            Header_t header;
+            Buffer buffer;
+        };
+
+        /** @return Home slot of header, type ids are mixed so sequential ids do not cluster
+         */
+        static uint32_t home(const Header_t& header)
+        {
+            uint32_t hash = static_cast<uint32_t>(header.typeId) * 0x9E3779B1U;
+            hash ^= hash >> 16U;
+            return hash & cMask;
+        }
+
+        std::array<Entry, cCapacity> registry_;
+        uint32_t count_; ///< Count of occupied slots
+    };
+
+    /** Reads Prefix_t, Header_t, payload and Postfix_t records from a stream publishing each completed payload
+     * @remark Records of unregistered types, or of a registered type with a different payload size, are skipped using the
+     *  header dataBytes, a size over cMaxSkipBytes is treated as corruption. On a prefix, header or postfix mismatch the reader rescans the stream for the next Prefix_t
+     *  (or Postfix_t when there is no prefix) and resumes from the following header. skipCount() and resyncCount()
+     *  report how often each occurred.
+     */
     template< typename Prefix_t, typename Header_t, typename Postfix_t, typename BufferRegister = BufferRegister<Header_t> >
     class BinaryReader
     {
@@ -792,11 +4567,18 @@ namespace sub0
             , Data ///< Data payload is being  read
             , Postfix ///< [optional] Postfix-Delimiter is being read
 
-            , SyncLost ///< Error state entered when an error occurs in any state i.e. Corrupted input stream
+            , SyncLost ///< Error state entered when an error occurs in any state i.e. Corrupted input stream, left by resync()
 
             , COUNT_ 
         };
 
+        /// Delimiter scanned for to regain sync, the prefix when present otherwise the postfix
+        typedef typename std::conditional<!std::is_void<Prefix_t>::value, Prefix_t, Postfix_t>::type Marker_t;
+        static const size_t cMarkerSize = utility::SizeOf<Marker_t>::value;
+
+        /// Largest payload skipped, fixed rather than the range of uint_fast16_t so a corrupt size is caught on every platform
+        static const uint32_t cMaxSkipBytes = UINT16_MAX;
+
     public:
         BinaryReader()
             : dataBufferRegistery_()
@@ -805,6 +4587,10 @@ namespace sub0
             , prefix_()
             , header_()
             , postfix_()
+            , marker_()
+            , markerCount_(0U)
+            , skipCount_(0U)
+            , resyncCount_(0U)
         {}
 
         bool read(IStream& stream)
@@ -831,8 +4617,19 @@ namespace sub0
             dataBufferRegistery_.close(); ///< @TODO This is here as a use-case contained stream state wihin the buffer map! Remove/deprecate this when/as possible
             currentBuffer_ = {};
             state_ = {};
+            markerCount_ = 0U;
         }
 
+        /** @return Count of records discarded as their header had no registered Data buffer
+         */
+        uint32_t skipCount() const
+        { return skipCount_; }
+
+        /** @return Count of times sync was lost to stream corruption and the stream rescanned
+         */
+        uint32_t resyncCount() const
+        { return resyncCount_; }
+
     private:
 
         /** Returns/finds buffer for state
@@ -847,7 +4644,16 @@ namespace sub0
             case State::Header: 
                 return {reinterpret_cast<char*>(&header_), static_cast<uint_fast16_t>(sizeof(header_)), 0U, nullptr };
             case State::Data:   
-                return dataBufferRegistery_.find(header_);
+            {
+                Buffer buffer = dataBufferRegistery_.find(header_);
+                if (buffer.buffer && buffer.publisher)
+                {
+                    char* const slot = buffer.publisher->acquire(); //< @note Waits for a free slot when N-buffered
+                    if (slot)
+                        buffer.buffer = slot;
+                }
+                return buffer;
+            }
             case State::Postfix: 
                 return {reinterpret_cast<char*>(&postfix_), static_cast<uint_fast16_t> ( !std::is_void<Postfix_t>::value ? sizeof(postfix_) : 0U), 0U, currentBuffer_.publisher };
             }
@@ -858,6 +4664,12 @@ namespace sub0
         */
         bool readBuffer(IStream& stream)
         {
+            if (state_ == State::SyncLost && !resync(stream))
+                return false;
+
+            if (currentBuffer_.buffer == nullptr) //< Not started or closed, begin with the initial state buffer
+                currentBuffer_ = findStateBuffer(state_);
+
             if (currentBuffer_.bufferSize > 0)
             {
 #if SUB0PUB_STD
@@ -892,15 +4704,53 @@ namespace sub0
             return stateComplete();
         }
 
-        constexpr bool getStateStatus(const State state) const
+        /** Scan the stream a byte at a time for Marker_t
+         * @return True once the marker is found and the next header is to be read, false if more data is needed
+        */
+        bool resync(IStream& stream)
+        {
+            if (cMarkerSize == 0U)
+            {
+                failure("Sub0Pub - Sync-Lost and protocol has no Prefix or Postfix to resync on");
+                return false;
+            }
+
+            for (;;)
+            {
+                char byte;
+#if SUB0PUB_STD
+                if (stream.read(&byte, 1).gcount() == 0)
+#else
+                if (stream.read(&byte, 1U) == 0U)
+#endif
+                    return false;
+
+                if (markerCount_ == cMarkerSize) //< Slide window along by a byte
+                {
+                    std::memmove(marker_, marker_ + 1U, cMarkerSize - 1U);
+                    --markerCount_;
+                }
+                marker_[markerCount_++] = byte;
+
+                if ((markerCount_ == cMarkerSize) && detail::matchesDefault<Marker_t>(marker_))
+                {
+                    markerCount_ = 0U;
+                    state_ = State::Header; //< Following a prefix, or a postfix which precedes the next header when there is no prefix
+                    currentBuffer_ = findStateBuffer(state_);
+                    return true;
+                }
+            }
+        }
+
+        bool getStateStatus(const State state) const
         {
             switch (state)
             {
             default: //< @todo SyncLost
-            case State::Prefix:  return true; ///< @todo Handle non-void Prefix_t: (prefix_ == Prefix_t())
+            case State::Prefix:  return detail::matchesDefault<Prefix_t>(reinterpret_cast<const char*>(&prefix_));
             case State::Header:  return dataBufferRegistery_.validate(header_);
             case State::Data:    return true;
-            case State::Postfix: return postfix_ == Postfix_t();///< @todo Handle void Postfix_t
+            case State::Postfix: return detail::matchesDefault<Postfix_t>(reinterpret_cast<const char*>(&postfix_));
             }
         }
 
@@ -913,70 +4763,58 @@ namespace sub0
             case State::Header:  return State::Data;
             case State::Data:    return !std::is_void<Postfix_t>::value ? State::Postfix : nextState(State::Postfix); ///< @note may not have Prefix_t or Postfix_t
             case State::Postfix:
-                assert(currentBuffer_.publisher);
-                if (currentBuffer_.publisher)
+                if (currentBuffer_.publisher) //< @note No publisher for a skipped record
                     currentBuffer_.publisher->publish(); // Signal completion of buffer content to publish data signal
                 return !std::is_void<Prefix_t>::value ? State::Prefix : nextState(State::Prefix);
             }
         }
 
-        bool checkStatusOfState(const State currentState) const
+        /** Enter SyncLost to rescan the stream for the next record
+         */
+        bool syncLost()
         {
-            const bool stateStatus = getStateStatus(currentState);
-            if(stateStatus)
-                return true;
-
-            const char* failureMessage = nullptr;
-            switch(currentState)
-            {
-                case State::Header: failureMessage = "Binary-Header mismatch - stream corruption or incompatible data-stream"; break;
-                case State::Postfix: failureMessage = "Binary-Postfix mismatch - stream corruption or incompatible data-stream"; break;
-                default: failureMessage = "Sync-Lost - TODO Details"; break;
-            }
-
-            if(failureMessage != nullptr)
-            {
-#if __cpp_exceptions
-                throw std::runtime_error(failureMessage);
-#else
-                assert((void*)0 == failureMessage);
-#endif
-            }
-
-            return false;
+            state_ = State::SyncLost;
+            currentBuffer_ = {};
+            markerCount_ = 0U;
+            ++resyncCount_;
+            return true; //< Continue reading to resync
         }
 
         bool stateComplete()
         {
-            if(!checkStatusOfState(state_))
-            {
-                state_ = State::SyncLost;
-                return false;
-            }
+            if(!getStateStatus(state_))
+                return syncLost(); //< Prefix, header or postfix mismatch - stream corruption or incompatible data-stream
 
             state_ = nextState( state_ );
             currentBuffer_ = findStateBuffer(state_);
 
-            // Check if header maps to a recognised Data
-            if ( currentBuffer_.buffer == nullptr)/// @todo Does not handle and discard unrecognised typeId [Critical]
-            {
-                const char* failureMessage = nullptr;
-                if ( state_ == State::Data )
-                    failureMessage = "Sub0Pub - Data buffer is null, potential payload size mismatch or unrecognised Id"; /// @todo Does not handle changed data structure size [Critical]
-                else
-                    failureMessage = "Sub0Pub - some logic is wrong!";
-               
-                if(failureMessage != nullptr)
-                {
+            // Check if header maps to a recognised Data
+            if ( currentBuffer_.buffer == nullptr)
+            {
+                if ( state_ != State::Data )
+                {
+                    failure("Sub0Pub - some logic is wrong!");
+                    return false;
+                }
+
+                /// Unrecognised typeId or changed payload size, discard the payload @note A size beyond cMaxSkipBytes is treated as corruption
+                if ( header_.dataBytes > cMaxSkipBytes )
+                    return syncLost();
+
+                ++skipCount_;
+                currentBuffer_ = { reinterpret_cast<char*>(&header_), 0U, static_cast<uint_fast16_t>(header_.dataBytes), nullptr };
+            }
+            
+            return true;
+        }
+
+        static void failure( const char* const failureMessage )
+        {
 #if __cpp_exceptions
-                    throw std::runtime_error(failureMessage);
+            throw std::runtime_error(failureMessage);
 #else
-                    assert((void*)0 == failureMessage);
+            assert((void*)0 == failureMessage);
 #endif
-                }
-            }
-            
-            return currentBuffer_.buffer != nullptr;
         }
 
     private:
@@ -993,16 +4831,26 @@ namespace sub0
         MemberPrefix_t prefix_;
         Header_t header_; ///< Packet head buffer
         MemberPostfix_t postfix_;
+
+        char marker_[cMarkerSize ? cMarkerSize : 1U]; ///< Sliding window of the last bytes read while resyncing
+        size_t markerCount_; ///< Bytes in marker_
+        uint32_t skipCount_; ///< Records discarded with no registered Data buffer
+        uint32_t resyncCount_; ///< Times sync was lost
     };
 
     /** Binary protocol for serialised signal and data transfer
      * @remark The protocol consists of a Header chunk followed by Header::dataBytes bytes of payload data
+     * @remark The reader buffer lookup is selected by deriving a protocol with a different Reader e.g.
+     *  `struct HashedSerialisation : DefaultSerialisation { using Reader = ReaderWith< HashBufferRegister<Header, 1024U> >; };`
      */
     class DefaultSerialisation
     {
+    public:
         struct Prefix
         {
             const uint32_t magic = sub0::utility::FourCC<'S', 'U', 'B', '0'>::value; //< Magic number to identify Sub0 network protocol packets
+
+            bool operator == (const Prefix& rhs) const { return magic == rhs.magic; }
         };
 
         /** Header containing signal type information
@@ -1014,35 +4862,51 @@ namespace sub0
 
             Header() = default;
 
+            constexpr Header( const uint32_t typeId, const uint32_t dataBytes )
+                : typeId( typeId )
+                , dataBytes( dataBytes )
+            {}
+
             /** header for specified Data type
+             * @note Constant expression when Data is registered with SUB0_TYPENAME or SUB0_TYPEID
             */
             template<typename Data>
-            Header( const Data& data )
-#if SUB0PUB_TYPEIDNAME
-                : typeId(Broker<Data>::typeId() )
-#else
-
-                : typeId(12345) // reinterpret_cast<uint32_t>(&typeid(data)) ) ///< @todo Crude using typeid address!!!
-#endif
+            constexpr Header( const Data& )
+                : typeId( sub0::typeId<Data>() )
                 , dataBytes(sizeof(Data) )
             {}
 
+            /** header for specified Data type without a Data instance
+            */
+            template<typename Data>
+            static constexpr Header of()
+            {
+                return Header( sub0::typeId<Data>(), sizeof(Data) );
+            }
+
             /** Sort by typeId only
             */
-            bool operator < (const Header& rhs) { return typeId < rhs.typeId; }
+            bool operator < (const Header& rhs) const { return typeId < rhs.typeId; }
 
             /** Compare full equality 
             */
-            bool operator == (const Header& rhs) { return (typeId == rhs.typeId) && (dataBytes == rhs.dataBytes); }
+            bool operator == (const Header& rhs) const { return (typeId == rhs.typeId) && (dataBytes == rhs.dataBytes); }
         };
 
         struct Postfix
         {
             const uint8_t delim = '\n';
+
+            bool operator == (const Postfix& rhs) const { return delim == rhs.delim; }
         };
 
         using Writer = BinaryWriter<Prefix, Header, Postfix>;
         using Reader = BinaryReader<Prefix, Header, Postfix>;
+
+        /** Reader using the specified BufferRegister lookup @see BufferRegister, DenseBufferRegister, HashBufferRegister
+         */
+        template< typename Register >
+        using ReaderWith = BinaryReader<Prefix, Header, Postfix, Register>;
     };
 
     /** Serialises Sub0Pub data into a target stream object
@@ -1056,11 +4920,21 @@ namespace sub0
     public:
         /** Construct from stream
          * @param[in] stream  Stream reference stored and used to write serialised data into
+         * @param[in] bufferSize  Bytes of records coalesced into one stream write, zero writes each record as it is forwarded
          */
-        StreamSerializer( OStream& stream )
+        StreamSerializer( OStream& stream, const size_t bufferSize = 0U )
             : stream_(stream)
             , writer_()
-        {}
+        {
+            writer_.setBufferSize( bufferSize );
+        }
+
+        /** Writes records still pending in the buffer
+         */
+        ~StreamSerializer()
+        {
+            writer_.flush( stream_ );
+        }
 
         /** Receives forwarded data from a subscriber and serialises it to the output stream
          * @param[in] data  Forwarded data
@@ -1071,6 +4945,25 @@ namespace sub0
             writer_.write( stream_, data );
         }
 
+        /** Receives a forwarded batch from a subscriber and serialises it with a single stream write
+         * @param[in] data  First of 'count' forwarded data
+         * @param[in] count  Count of data
+         */
+        template<typename Data>
+        void forwardBatch( const Data* data, const size_t count )
+        {
+            writer_.writeBatch( stream_, data, count );
+        }
+
+        /** Write buffered records and flush the stream
+         * @remark Call at message boundaries where the receiver must see all forwarded data e.g. end of a frame
+        */
+        void flush()
+        {
+            writer_.flush( stream_ );
+            stream_.flush();
+        }
+
         /** Reset writer internal  state
         */
         void close()
@@ -1123,11 +5016,291 @@ namespace sub0
             reader_.close( stream_ );
         }
 
+        /** @return Count of records discarded as their type was not registered @see BinaryReader::skipCount
+         */
+        uint32_t skipCount() const
+        { return reader_.skipCount(); }
+
+        /** @return Count of times stream corruption was detected and the stream rescanned @see BinaryReader::resyncCount
+         */
+        uint32_t resyncCount() const
+        { return reader_.resyncCount(); }
+
     private:
         IStream& stream_; ///< Stream from which data is de-serialized
         typename Protocol::Reader reader_;
     };
 
+    namespace detail
+    {
+        /** Function publishing a record payload in place
+         * @param context  Registered publisher
+         * @param payload  Record payload within the input buffer @note Not necessarily aligned for the Data type
+         */
+        typedef void (*PublishRecord)( const void* context, const char* payload );
+
+        /** Table of direct publishers by record header for in-place deserialisers
+         * @remark Lookup remembers the last match as recorded streams commonly repeat the same Data type
+         * @tparam  Header_t  Record header type
+         * @tparam  cMaxPublishers  Count of Data types that can be registered
+         */
+        template< typename Header_t, uint32_t cMaxPublishers >
+        class DirectPublishers
+        {
+        public:
+            struct Publisher
+            {
+                Header_t header;
+                PublishRecord publish;
+                const void* context;
+            };
+
+            DirectPublishers()
+                : count_(0U)
+                , last_(0U)
+                , publishers_()
+            {}
+
+            void set( const Header_t& header, const PublishRecord publish, const void* const context )
+            {
+                assert( count_ < cMaxPublishers ); //< Capacity reached
+                if ( count_ < cMaxPublishers )
+                {
+                    const Publisher publisher = { header, publish, context };
+                    publishers_[count_++] = publisher;
+                }
+            }
+
+            /** @return Publisher registered for header or nullptr
+             */
+            const Publisher* find( const Header_t& header )
+            {
+                if ( (last_ < count_) && (publishers_[last_].header == header) )
+                    return &publishers_[last_];
+
+                for ( uint32_t iPublisher = 0U; iPublisher < count_; ++iPublisher )
+                {
+                    if ( publishers_[iPublisher].header == header )
+                    {
+                        last_ = iPublisher;
+                        return &publishers_[iPublisher];
+                    }
+                }
+                return nullptr;
+            }
+
+        private:
+            uint32_t count_; ///< Count of publishers_ in use
+            uint32_t last_; ///< Index of the last found publisher
+            Publisher publishers_[cMaxPublishers]; ///< Publisher per registered record header
+        };
+    } // END: detail
+
+    /** Publishes messages parsed in place from contiguous buffers of serialised records
+     * @remark Counterpart to StreamDeserializer for bulk decoding e.g. an mmap'd recording or large chunks read from an
+     *  IStream. Headers are parsed in place and subscribers receive a reference straight into the buffer when the payload
+     *  is aligned for its Data type, otherwise the payload is copied once to an aligned temporary.
+     *  Records of unregistered types are skipped using the header size, corrupt records are skipped by rescanning for the
+     *  next record so a bad header never stalls decoding or grows the chunk past maxDataBytes().
+     * @note Register publishers with DirectPublish<Data,BufferDeserializer>. Data must be trivially copyable.
+     * @tparam  Protocol  Stream data protocol with Prefix, Header and Postfix record types @see sub0::DefaultSerialisation
+     * @tparam  cMaxPublishers  Count of Data types that can be registered
+     */
+    template< typename Protocol = DefaultSerialisation, uint32_t cMaxPublishers = 64U >
+    class BufferDeserializer
+    {
+    public:
+        typedef typename Protocol::Prefix Prefix_t;
+        typedef typename Protocol::Header Header_t;
+        typedef typename Protocol::Postfix Postfix_t;
+
+        /** @param[in] chunkSize  Bytes requested per IStream read by update(IStream&)
+         */
+        explicit BufferDeserializer( const size_t chunkSize = 64U * 1024U )
+            : publishers_()
+            , chunk_( chunkSize )
+            , chunkCount_(0U)
+            , maxDataBytes_( static_cast<uint32_t>( std::min<size_t>( chunkSize, UINT32_MAX ) ) )
+            , syncLost_(false)
+            , skipCount_(0U)
+            , resyncCount_(0U)
+        {}
+
+        /** Register the publisher for records with header
+         * @remark Called by sub0::DirectPublish<Data>
+         */
+        void setDirectPublisher( const Header_t& header, const detail::PublishRecord publish, const void* const context )
+        {
+            publishers_.set( header, publish, context );
+            maxDataBytes_ = std::max( maxDataBytes_, static_cast<uint32_t>(header.dataBytes) );
+        }
+
+        /** Publish all complete records in buffer
+         * @remark On a prefix or postfix mismatch, or a header larger than maxDataBytes(), the records are rescanned for the
+         *  next Prefix_t (or Postfix_t when there is no prefix) as BinaryReader does, continuing into following buffers.
+         * @param[in] buffer  Serialised records, beginning at a record boundary
+         * @param[in] bufferCount  Bytes in buffer
+         * @return Bytes consumed, the remainder is an incomplete record to present again with the following bytes
+         */
+        size_t update( const char* const buffer, const size_t bufferCount )
+        {
+            size_t consumed = 0U;
+            while ( consumed < bufferCount )
+            {
+                if ( syncLost_ )
+                {
+                    consumed += resync( buffer + consumed, bufferCount - consumed );
+                    if ( syncLost_ )
+                        break; //< Marker not yet found
+                    continue;
+                }
+
+                if ( (bufferCount - consumed) < cPayloadOffset )
+                    break; //< Incomplete header
+
+                const char* const record = buffer + consumed;
+                if ( !detail::matchesDefault<Prefix_t>(record) )
+                {
+                    consumed += syncLost(); //< Prefix mismatch - stream corruption or incompatible data-stream
+                    continue;
+                }
+
+                Header_t header;
+                std::memcpy( &header, record + cHeaderOffset, sizeof(header) );
+                if ( header.dataBytes > maxDataBytes_ )
+                {
+                    consumed += syncLost(); //< Corrupt header, not a record that could be registered or buffered
+                    continue;
+                }
+
+                const size_t recordSize = recordBytes( header.dataBytes );
+                if ( (bufferCount - consumed) < recordSize )
+                    break; //< Incomplete record
+
+                if ( !detail::matchesDefault<Postfix_t>(record + cPayloadOffset + header.dataBytes) )
+                {
+                    consumed += syncLost(); //< Postfix mismatch - stream corruption or incompatible data-stream
+                    continue;
+                }
+
+                const typename detail::DirectPublishers<Header_t, cMaxPublishers>::Publisher* const publisher = publishers_.find( header );
+                if ( publisher )
+                    publisher->publish( publisher->context, record + cPayloadOffset );
+                else
+                    ++skipCount_; //< Unregistered type, record skipped
+
+                consumed += recordSize;
+            }
+            return consumed;
+        }
+
+        /** Read a chunk from stream and publish its complete records
+         * @remark An incomplete trailing record is retained and completed by the next update()
+         * @return True when records were published or skipped, false if no complete record was present in stream
+         */
+        bool update( IStream& stream )
+        {
+            if ( (chunkCount_ == chunk_.size()) && (chunk_.size() < recordBytes( maxDataBytes_ )) )
+                chunk_.resize( recordBytes( maxDataBytes_ ) ); //< Record larger than the chunk, bounded by maxDataBytes()
+
+#if SUB0PUB_STD
+            chunkCount_ += static_cast<size_t>( stream.read(chunk_.data() + chunkCount_, chunk_.size() - chunkCount_).gcount() );
+#else
+            chunkCount_ += stream.read( chunk_.data() + chunkCount_, static_cast<IStream::StreamSize>(chunk_.size() - chunkCount_) );
+#endif
+            const size_t consumed = update( chunk_.data(), chunkCount_ );
+            std::memmove( chunk_.data(), chunk_.data() + consumed, chunkCount_ - consumed );
+            chunkCount_ -= consumed;
+            return consumed != 0U;
+        }
+
+        /** Discard any retained incomplete record
+        */
+        void close()
+        {
+            chunkCount_ = 0U;
+            syncLost_ = false;
+        }
+
+        /** @return Largest accepted record payload, the larger of the chunk size and the largest registered Data
+         * @note Unregistered records up to this size are skipped, larger headers are treated as corruption
+         */
+        uint32_t maxDataBytes() const
+        { return maxDataBytes_; }
+
+        /** @return Count of records skipped as no publisher was registered for their header
+         */
+        uint32_t skipCount() const
+        { return skipCount_; }
+
+        /** @return Count of times stream corruption was detected and the records rescanned @see BinaryReader::resyncCount
+         */
+        uint32_t resyncCount() const
+        { return resyncCount_; }
+
+    private:
+        /// Delimiter scanned for to regain sync, the prefix when present otherwise the postfix
+        typedef typename std::conditional<!std::is_void<Prefix_t>::value, Prefix_t, Postfix_t>::type Marker_t;
+        static const size_t cMarkerSize = utility::SizeOf<Marker_t>::value;
+        static const size_t cHeaderOffset = utility::SizeOf<Prefix_t>::value; ///< Offset of the header in a record
+        static const size_t cPayloadOffset = cHeaderOffset + sizeof(Header_t); ///< Offset of the payload in a record
+
+        /** @return Bytes of a record with 'dataBytes' payload
+         */
+        static size_t recordBytes( const uint32_t dataBytes )
+        { return cPayloadOffset + dataBytes + utility::SizeOf<Postfix_t>::value; }
+
+        /** Enter the resync state
+         * @return Bytes to skip, the mismatched record's first byte so its marker is not found again
+         */
+        size_t syncLost()
+        {
+            syncLost_ = true;
+            ++resyncCount_;
+            return 1U;
+        }
+
+        /** Scan for the next Marker_t
+         * @return Bytes consumed, up to the next header once found, otherwise all but a possible partial marker
+         */
+        size_t resync( const char* const buffer, const size_t bufferCount )
+        {
+            if ( cMarkerSize == 0U )
+            {
+                failure( "Sub0Pub - Sync-Lost and protocol has no Prefix or Postfix to resync on" );
+                return bufferCount; //< Nothing to resync on, discard the remaining stream
+            }
+
+            for ( size_t offset = 0U; (offset + cMarkerSize) <= bufferCount; ++offset )
+            {
+                if ( detail::matchesDefault<Marker_t>( buffer + offset ) )
+                {
+                    syncLost_ = false;
+                    return std::is_void<Prefix_t>::value ? (offset + cMarkerSize) : offset; //< A prefix starts the record, a postfix precedes the next header
+                }
+            }
+            return (bufferCount >= cMarkerSize) ? (bufferCount - (cMarkerSize - 1U)) : 0U;
+        }
+
+        static void failure( const char* const failureMessage )
+        {
+#if __cpp_exceptions
+            throw std::runtime_error(failureMessage);
+#else
+            assert((void*)0 == failureMessage);
+#endif
+        }
+
+    private:
+        detail::DirectPublishers<Header_t, cMaxPublishers> publishers_; ///< Publisher per registered record header
+        utility::ByteBuffer chunk_; ///< Bytes read from an IStream awaiting parsing
+        size_t chunkCount_; ///< Count of bytes in chunk_
+        uint32_t maxDataBytes_; ///< Largest accepted payload @see maxDataBytes()
+        bool syncLost_; ///< Scanning for the next marker after corruption
+        uint32_t skipCount_; ///< Records with no registered publisher
+        uint32_t resyncCount_; ///< Times sync was lost
+    };
+
     /** Forward receive() to  Target type convertible from this
      * @remark The call is made with Data type allowing for templated forward() handler functions @see class StreamSerializer
      * @note This uses the CRTP(curiously recurring template pattern) to forward to a target type derived from ForwardSubscribe<..>
@@ -1160,19 +5333,202 @@ namespace sub0
         {
             static_cast<Target*>(this)->forward( data );
         }
+
+        /** Receives subscribed batch and forwards it whole to Target::forwardBatch( const Data*, size_t ), or per element to forward()
+         * @note Targets which customise forward() and inherit forwardBatch() should customise forwardBatch() too
+         * @param data  First of 'count' data to forward
+         * @param count  Count of data
+         */
+        inline void receiveBatch( const Data* data, const size_t count ) final
+        {
+            forwardEach( data, count, std::integral_constant<bool, HasForwardBatch<Target>::value>() );
+        }
+
+    private:
+        /** Detects Target::forwardBatch( const Data*, size_t ) including inherited and template members
+         */
+        template< typename T >
+        struct HasForwardBatch
+        {
+            template< typename U > static char check( decltype( static_cast<void (U::*)(const Data*, size_t)>(&U::forwardBatch) )* );
+            template< typename U > static long check( ... );
+            static const bool value = sizeof(check<T>(0/*nullptr*/)) == sizeof(char);
+        };
+
+        void forwardEach( const Data* data, const size_t count, std::true_type /*hasForwardBatch*/ )
+        {
+            static_cast<Target*>(this)->forwardBatch( data, count );
+        }
+
+        void forwardEach( const Data* data, const size_t count, std::false_type /*hasForwardBatch*/ )
+        {
+            for ( const Data* const iEnd = data + count; data != iEnd; ++data )
+            {
+                static_cast<Target*>(this)->forward( *data );
+            }
+        }
     };
 
+    namespace detail
+    {
+        /** Payload buffers of a ForwardPublish
+         * @remark Single buffer published on completion by the thread reading the provider
+         * @tparam Data  Data type read into the buffers
+         * @tparam cBuffers  Count of buffers
+         */
+        template< typename Data, uint32_t cBuffers >
+        class ForwardBuffers;
+
+        template< typename Data >
+        class ForwardBuffers<Data, 1U>
+        {
+        public:
+            ForwardBuffers()
+                : buffer_()
+            {}
+
+            /** @return Buffer registered with the data provider
+             */
+            Data& initial()
+            { return buffer_; }
+
+            /** @return nullptr, the provider reads into the registered buffer
+             */
+            char* acquire()
+            { return 0/*nullptr*/; }
+
+            /** Publish the completed buffer
+             */
+            void complete( const Publish<Data>& publisher )
+            { publisher.publish( buffer_ ); }
+
+            /** @return 0, completed buffers are published by complete()
+             */
+            uint32_t dispatch( const Publish<Data>& /*publisher*/, const uint32_t /*maxCount*/ )
+            { return 0U; }
+
+        private:
+            Data buffer_; ///< Data buffer to be published
+        };
+
+#if SUB0PUB_THREADS
+        /** Ring of cBuffers payload slots handed from the thread reading the provider to the thread publishing them
+         * @remark Each slot records its owner in an atomic state. The reader claims the next slot in ring order once it is free,
+         *  fills it and marks it ready, the dispatching thread publishes ready slots in order and frees them. A slot left
+         *  filling by a discarded record is refilled by the next payload.
+         * @tparam Data  Data type read into the slots
+         * @tparam cBuffers  Count of slots
+         */
+        template< typename Data, uint32_t cBuffers >
+        class ForwardBuffers
+        {
+        public:
+            /** Owner of a slot
+             */
+            enum SlotState : uint32_t
+            {
+                  cFree ///< Available to the reader
+                , cFilling ///< Payload being read
+                , cReady ///< Payload complete and awaiting dispatch
+                , cPublishing ///< Payload being delivered to subscribers
+            };
+
+            ForwardBuffers()
+                : writeSlot_(0U)
+                , readSlot_(0U)
+                , slots_()
+            {}
+
+            /** @return First slot, registered with the data provider
+             */
+            Data& initial()
+            { return slots_[0].data; }
+
+            /** Claim the next slot for the reader
+             * @warning Blocks the reader until the dispatching thread frees the slot
+             * @return Slot to read the payload into
+             */
+            char* acquire()
+            {
+                Slot& slot = slots_[writeSlot_];
+                uint32_t state = slot.state.load( std::memory_order_acquire );
+                while ( (state != cFree) && (state != cFilling) )
+                {
+                    std::this_thread::yield();
+                    state = slot.state.load( std::memory_order_acquire );
+                }
+                slot.state.store( cFilling, std::memory_order_relaxed );
+                return reinterpret_cast<char*>( &slot.data );
+            }
+
+            /** Hand the filled slot to the dispatching thread
+             */
+            void complete( const Publish<Data>& )
+            {
+                Slot& slot = slots_[writeSlot_];
+                assert( slot.state.load( std::memory_order_relaxed ) == cFilling ); //< @note Provider must call IPublish::acquire() for each payload
+                slot.state.store( cReady, std::memory_order_release );
+                writeSlot_ = (writeSlot_ + 1U) % cBuffers;
+            }
+
+            /** Publish ready slots in the order they were read
+             * @warning Only one thread may dispatch at a time
+             */
+            uint32_t dispatch( const Publish<Data>& publisher, const uint32_t maxCount )
+            {
+                uint32_t count = 0U;
+                while ( count < maxCount )
+                {
+                    Slot& slot = slots_[readSlot_];
+                    if ( slot.state.load( std::memory_order_acquire ) != cReady )
+                        break;
+
+                    slot.state.store( cPublishing, std::memory_order_relaxed );
+                    publisher.publish( slot.data );
+                    slot.state.store( cFree, std::memory_order_release );
+                    readSlot_ = (readSlot_ + 1U) % cBuffers;
+                    ++count;
+                }
+                return count;
+            }
+
+            /** @return Current owner of a slot
+             */
+            SlotState state( const uint32_t slot ) const
+            { return static_cast<SlotState>( slots_[slot].state.load( std::memory_order_relaxed ) ); }
+
+        private:
+            struct alignas(64) Slot
+            {
+                Slot() : state(cFree), data() {}
+
+                std::atomic<uint32_t> state; ///< SlotState
+                Data data; ///< Payload
+            };
+
+            alignas(64) uint32_t writeSlot_; ///< Slot filled next, reader thread only
+            alignas(64) uint32_t readSlot_; ///< Slot dispatched next, dispatching thread only
+            Slot slots_[cBuffers];
+        };
+#endif
+    } // END: detail
+
     /** Register publication of data with a provider instance
      * @remark The call is made with Data type allowing for templated forward() handler functions @see class StreamSerializer
+     *  With cBuffers > 1 payloads are read into a ring of slots and published by dispatch() on another thread, so the reader
+     *  fills the next slot while subscribers receive the previous one. The reader waits when every slot awaits dispatch.
      * @note This uses the CRTP(curiously recurring template pattern) to forward to a target type derived from ForwardPublish<..>
      * @tparam  Data  Data type which will be read into from a DataProvider
      * @tparam  DataProvider  CRTP Type of derived class which implements a function of type DataProvider::setDataPublisher( Data&, IPublish& ) via base inheritance or direct member
+     * @tparam  cBuffers  Count of payload buffers, 1 publishes each payload on the reading thread as it completes
      *
      * @todo API not final
      */
-    template<typename Data, typename DataProvider >
+    template<typename Data, typename DataProvider, uint32_t cBuffers = 1U >
     class ForwardPublish : public Publish<Data>, protected IPublish
     {
+        static_assert( (cBuffers == 1U) || SUB0PUB_THREADS, "N-buffered ForwardPublish requires SUB0PUB_THREADS" );
+
     public:
         /** Register publisher buffer with the data provider
          * @param typeName  Unique name given to the serialised data entry @note Replaces compiler generated name which is not portable
@@ -1188,21 +5544,80 @@ namespace sub0
 #endif
               )
             , IPublish()
+            , buffers_()
         {
             DataProvider& provider = static_cast<DataProvider&>(*this);
-            provider.setDataPublisher( buffer_, static_cast<IPublish&>(*this) ); // Register the buffer sink to the data provider
+            provider.setDataPublisher( buffers_.initial(), static_cast<IPublish&>(*this) ); // Register the buffer sink to the data provider
         }
 
+        /** Publish payloads read by the provider thread, for cBuffers > 1
+         * @warning Only one thread may dispatch at a time
+         * @param[in] maxCount  Maximum count of payloads to publish
+         * @return Count of payloads published
+         */
+        uint32_t dispatch( const uint32_t maxCount = UINT32_MAX )
+        { return buffers_.dispatch( *this, maxCount ); }
+
     private:
+        /** Claim the buffer the provider reads the next payload into
+         */
+        virtual char* acquire() final
+        { return buffers_.acquire(); }
 
-        /** Publish the data populated in buffer_
+        /** Publish the data populated in the buffer, or hand it to dispatch() when cBuffers > 1
          */
         virtual void publish() final
-        { Publish<Data>::publish( buffer_ ); }
+        { buffers_.complete( *this ); }
+
+    private:
+        detail::ForwardBuffers<Data, cBuffers> buffers_; ///< Payload buffers
+    };
+
+    /** Register publication of Data records parsed in place by a data provider
+     * @remark Counterpart of ForwardPublish<Data,DataProvider> which publishes from the provider's input buffer with no copy
+     *  when the payload is aligned for Data @see BufferDeserializer
+     * @note This uses the CRTP(curiously recurring template pattern) to register with a DataProvider base of the derived type
+     * @tparam Data  Data type published from records @note Must be trivially copyable
+     * @tparam DataProvider  CRTP Type of derived class which implements DataProvider::setDirectPublisher() via base inheritance
+     */
+    template<typename Data, typename DataProvider >
+    class DirectPublish : public Publish<Data>
+    {
+    public:
+        /** Register publisher with the data provider
+         * @param typeName  Unique name given to the serialised data entry @note Replaces compiler generated name which is not portable
+         */
+        DirectPublish(
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/
+#endif
+        )
+            : Publish<Data>(
+#if SUB0PUB_TYPEIDNAME
+                typeId, typeName
+#endif
+              )
+        {
+            static_assert( std::is_trivially_copyable<Data>::value, "Records are published from raw bytes" );
+            DataProvider& provider = static_cast<DataProvider&>(*this);
+            provider.setDirectPublisher( DataProvider::Header_t::template of<Data>(), &DirectPublish::publishRecord, static_cast<const void*>(this) );
+        }
 
     private:
-        Data buffer_; ///< Data buffer to be published 
-                      ///< @todo Double-buffer data storage for asynchronous processing and receive?
+        static void publishRecord( const void* context, const char* payload )
+        {
+            const DirectPublish* const publisher = static_cast<const DirectPublish*>(context);
+            if ( (reinterpret_cast<uintptr_t>(payload) % alignof(Data)) == 0U )
+            {
+                publisher->Publish<Data>::publish( *reinterpret_cast<const Data*>(payload) );
+            }
+            else
+            {
+                Data aligned;
+                std::memcpy( &aligned, payload, sizeof(aligned) );
+                publisher->Publish<Data>::publish( aligned );
+            }
+        }
     };
 
 } // END: sub0
@@ -0,0 +1,116 @@
+/** Sub0Pub unit test support
+ * @remark Each test is a plain executable run by ctest. SUB0PUB_TEST_CHECK reports a failed condition and continues,
+ *  sub0test::result() is returned from main so any failure fails the test. Checks are independent of NDEBUG.
+ */
+#ifndef CROG_SUB0PUB_TEST_HPP
+#define CROG_SUB0PUB_TEST_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <algorithm> //< std::min
+#include <atomic> //< std::atomic
+#include <cstdio> //< std::printf
+#include <cstring> //< std::memcpy
+#include <vector> //< std::vector
+
+/** Report a failed condition with its location
+ */
+#define SUB0PUB_TEST_CHECK( condition ) \
+    ( (condition) ? (void)0 : sub0test::fail( #condition, __FILE__, __LINE__ ) )
+
+namespace sub0test
+{
+    /** @return Count of failed checks, checked from any thread
+     */
+    inline std::atomic<int>& failureCount()
+    {
+        static std::atomic<int> failures( 0 );
+        return failures;
+    }
+
+    inline void fail( const char* const condition, const char* const file, const int line )
+    {
+        std::printf( "%s:%d: check failed: %s\n", file, line, condition );
+        ++failureCount();
+    }
+
+    /** @return Exit code of the test executable
+     */
+    inline int result()
+    {
+        const int failures = failureCount().load();
+        std::printf( failures ? "FAILED %d check(s)\n" : "OK\n", failures );
+        return failures ? 1 : 0;
+    }
+
+#if !SUB0PUB_STD
+    /** Growable in-memory stream used as both serialiser output and deserialiser input
+     * @remark Reads return at most the chunk size so a deserialiser sees records split across updates as from a socket
+     */
+    class MemoryStream : public sub0::OStream, public sub0::IStream
+    {
+    public:
+        MemoryStream()
+            : buffer()
+            , readPosition_(0U)
+            , chunk_(~0U)
+        {}
+
+        /** Restart reading from the first byte
+         * @param chunk  Maximum bytes returned by each read
+         */
+        void rewind( const sub0::IStream::StreamSize chunk = ~0U )
+        {
+            readPosition_ = 0U;
+            chunk_ = chunk;
+        }
+
+        virtual sub0::OStream::StreamSize write( const char* const data, const sub0::OStream::StreamSize dataCount ) override
+        {
+            buffer.insert( buffer.end(), data, data + dataCount );
+            return dataCount;
+        }
+
+        virtual void flush() final
+        {}
+
+        virtual sub0::IStream::StreamSize read( char* const data, const sub0::IStream::StreamSize dataCount ) final
+        {
+            const sub0::IStream::StreamSize count = available( dataCount );
+            std::memcpy( data, buffer.data() + readPosition_, count );
+            readPosition_ += count;
+            return count;
+        }
+
+        virtual sub0::IStream::StreamSize ignore( const sub0::IStream::StreamSize dataCount ) final
+        {
+            const sub0::IStream::StreamSize count = available( dataCount );
+            readPosition_ += count;
+            return count;
+        }
+
+        virtual sub0::IStream::StreamSize ignore( const sub0::IStream::StreamSize dataCount, const char delimiter ) final
+        {
+            sub0::IStream::StreamSize count = 0U;
+            while ( (count < available( dataCount )) && (buffer[readPosition_ + count] != delimiter) )
+                ++count;
+            readPosition_ += count;
+            return count;
+        }
+
+        virtual bool isEof() final
+        { return readPosition_ == buffer.size(); }
+
+        std::vector<char> buffer; ///< Written bytes, editable to corrupt the stream
+
+    private:
+        sub0::IStream::StreamSize available( const sub0::IStream::StreamSize dataCount ) const
+        { return static_cast<sub0::IStream::StreamSize>( std::min<size_t>( std::min<size_t>( dataCount, chunk_ ), buffer.size() - readPosition_ ) ); }
+
+        size_t readPosition_; ///< Next byte read
+        sub0::IStream::StreamSize chunk_; ///< Maximum bytes returned by a read
+    };
+#endif
+} // END: sub0test
+
+#endif
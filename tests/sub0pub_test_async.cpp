@@ -0,0 +1,602 @@
+/** Asynchronous delivery tests: mailbox ordering and overflow, sequence lock ordering, LatestSubscribe replay, deferred delivery
+ *  order and ParallelExecutor affinity
+ */
+
+#include "sub0pub_test.hpp"
+#include "sub0pub/async.hpp"
+
+#include <atomic> //< std::atomic
+#include <chrono> //< std::chrono::milliseconds
+#include <memory> //< std::unique_ptr
+#include <mutex> //< std::mutex
+#include <thread> //< std::thread
+#include <vector> //< std::vector
+
+namespace
+{
+    /** State published with cCacheLast, fields derived from seq to detect torn copies
+     */
+    struct Pose
+    {
+        uint64_t seq;
+        double x;
+        uint64_t check;
+    };
+
+    /** Queued into AsyncSubscribe mailboxes
+     */
+    struct Item
+    {
+        uint32_t value;
+    };
+
+    /** Job fanned out over a ParallelExecutor
+     */
+    struct Job
+    {
+        uint32_t value;
+    };
+
+    /** Published back into a DeferredDelivery by its own deferred subscriber
+     */
+    struct Echo
+    {
+        uint32_t depth;
+    };
+
+    /** Published from several threads into a DeferredDelivery
+     */
+    struct Tick
+    {
+        uint32_t value;
+    };
+
+    /** Received by direct and deferred subscribers
+     */
+    struct Stage
+    {
+        uint32_t value;
+    };
+} // END: namespace
+
+namespace sub0
+{
+    template<>
+    struct BrokerTraits<Pose> : DefaultBrokerTraits
+    {
+        static const bool cCacheLast = true;
+    };
+
+    template<>
+    struct BrokerTraits<Tick> : DefaultBrokerTraits
+    {
+        static const bool cConcurrent = true;
+    };
+}
+
+namespace
+{
+    /** A single producer's data is popped in push order, across many laps of the ring
+     */
+    void testMailboxOrder()
+    {
+        const uint32_t cCount = 200000U;
+        sub0::detail::MailboxRing<uint32_t, 64U> ring;
+        std::thread producer( [&]()
+        {
+            for ( uint32_t iValue = 0U; iValue < cCount; ++iValue )
+            {
+                while ( !ring.tryPush( iValue ) )
+                    std::this_thread::yield();
+            }
+        } );
+
+        uint32_t expected = 0U;
+        while ( expected < cCount )
+        {
+            uint32_t value;
+            if ( !ring.tryPop( value ) )
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            SUB0PUB_TEST_CHECK( value == expected );
+            if ( value != expected )
+                break;
+            ++expected;
+        }
+        producer.join();
+        SUB0PUB_TEST_CHECK( ring.empty() );
+    }
+
+    /** Shared producers each keep their own push order and no data is lost or duplicated
+     */
+    void testMailboxSharedOrder()
+    {
+        const uint32_t cProducers = 3U;
+        const uint32_t cCount = 100000U;
+        sub0::detail::MailboxRing<uint32_t, 64U> ring;
+        std::vector<std::thread> producers;
+        for ( uint32_t iProducer = 0U; iProducer < cProducers; ++iProducer )
+        {
+            producers.emplace_back( [&ring, iProducer, cCount]()
+            {
+                for ( uint32_t iValue = 0U; iValue < cCount; ++iValue )
+                {
+                    while ( !ring.tryPushShared( (iProducer << 24U) | iValue ) )
+                        std::this_thread::yield();
+                }
+            } );
+        }
+
+        uint32_t next[cProducers] = {};
+        for ( uint32_t iReceived = 0U; iReceived < (cProducers * cCount); )
+        {
+            uint32_t value;
+            if ( !ring.tryPop( value ) )
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            const uint32_t producer = value >> 24U;
+            SUB0PUB_TEST_CHECK( (producer < cProducers) && ((value & 0xFFFFFFU) == next[producer]) );
+            if ( producer < cProducers )
+                next[producer] = (value & 0xFFFFFFU) + 1U;
+            ++iReceived;
+        }
+        for ( std::thread& producer : producers )
+            producer.join();
+        SUB0PUB_TEST_CHECK( ring.empty() );
+    }
+
+    /** Records drained Item values, filter() rejects zero on the publishing thread
+     */
+    template< sub0::Overflow cOverflow >
+    class ItemQueue : public sub0::AsyncSubscribe<Item, 4U, cOverflow>
+    {
+    public:
+        virtual bool filter( const Item& item ) final
+        { return item.value != 0U; }
+
+        virtual void receive( const Item& item ) final
+        { received.push_back( item.value ); }
+
+        std::vector<uint32_t> received; ///< Drained values in order
+    };
+
+    /** Publish Item 0 then 1 to 'count'
+     */
+    void publishItems( const uint32_t count )
+    {
+        const sub0::Publish<Item> publisher;
+        for ( uint32_t iItem = 0U; iItem <= count; ++iItem )
+            publisher.publish( Item{ iItem } );
+    }
+
+    /** A full mailbox drops the newest or the oldest data and counts it, or blocks the publisher until drained
+     */
+    void testOverflow()
+    {
+        {
+            ItemQueue<sub0::Overflow::DropNewest> queue;
+            publishItems( 6U );
+            SUB0PUB_TEST_CHECK( (queue.drain() == 4U) && (queue.dropCount() == 2U) && queue.empty() );
+            SUB0PUB_TEST_CHECK( queue.received == (std::vector<uint32_t>{ 1U, 2U, 3U, 4U }) );
+        }
+        {
+            ItemQueue<sub0::Overflow::DropOldest> queue;
+            publishItems( 6U );
+            SUB0PUB_TEST_CHECK( (queue.drain( 3U ) == 3U) && (queue.dropCount() == 2U) && !queue.empty() );
+            SUB0PUB_TEST_CHECK( (queue.drain() == 1U) && (queue.received == std::vector<uint32_t>{ 3U, 4U, 5U, 6U }) );
+        }
+        {
+            const uint32_t cCount = 1000U;
+            ItemQueue<sub0::Overflow::Block> queue;
+            std::thread publisher( publishItems, cCount );
+            while ( queue.received.size() < cCount )
+            {
+                if ( queue.drain() == 0U )
+                    std::this_thread::yield();
+            }
+            publisher.join();
+
+            bool ordered = (queue.dropCount() == 0U);
+            for ( uint32_t iItem = 0U; iItem < cCount; ++iItem )
+                ordered = ordered && (queue.received[iItem] == (iItem + 1U));
+            SUB0PUB_TEST_CHECK( ordered && queue.empty() );
+        }
+    }
+
+    /** Reads racing writes are never torn and never go back in time, seed() never replaces a write
+     */
+    void testSeqLockSlot()
+    {
+        sub0::detail::SeqLockSlot<Pose> slot;
+        Pose pose = {};
+        SUB0PUB_TEST_CHECK( !slot.read( pose ) );
+
+        std::atomic<bool> stop( false );
+        std::thread writer( [&]()
+        {
+            for ( uint64_t iSeq = 1U; !stop.load( std::memory_order_relaxed ); ++iSeq )
+            {
+                const Pose next = { iSeq, static_cast<double>(iSeq), iSeq * 7U };
+                slot.write( next );
+            }
+        } );
+
+        uint64_t last = 0U;
+        for ( int iRead = 0; iRead < 200000; ++iRead )
+        {
+            if ( !slot.read( pose ) )
+                continue;
+            SUB0PUB_TEST_CHECK( (pose.x == static_cast<double>(pose.seq)) && (pose.check == (pose.seq * 7U)) );
+            SUB0PUB_TEST_CHECK( pose.seq >= last );
+            last = pose.seq;
+        }
+        stop.store( true, std::memory_order_relaxed );
+        writer.join();
+
+        sub0::detail::SeqLockSlot<Pose> seeded;
+        const Pose first = { 1U, 1.0, 7U };
+        const Pose second = { 2U, 2.0, 14U };
+        SUB0PUB_TEST_CHECK( seeded.seed( first ) );
+        seeded.write( second );
+        SUB0PUB_TEST_CHECK( !seeded.seed( first ) );
+        SUB0PUB_TEST_CHECK( seeded.read( pose ) && (pose.seq == 2U) && (seeded.version() == 2U) );
+    }
+
+    /** A LatestSubscribe starts with the cached value and later publishes replace it
+     */
+    void testLatestReplay()
+    {
+        const sub0::Publish<Pose> publisher;
+        const Pose first = { 1U, 1.0, 7U };
+        publisher.publish( first );
+
+        sub0::LatestSubscribe<Pose> latest;
+        Pose pose = {};
+        SUB0PUB_TEST_CHECK( latest.read( pose ) && (pose.seq == 1U) && (latest.version() == 1U) );
+
+        const Pose batch[3] = { { 2U, 2.0, 14U }, { 3U, 3.0, 21U }, { 4U, 4.0, 28U } };
+        publisher.publishBatch( batch, 3U );
+        SUB0PUB_TEST_CHECK( latest.read( pose ) && (pose.seq == 4U) && (latest.version() == 2U) );
+
+        sub0::LatestSubscribe<Pose> later;
+        SUB0PUB_TEST_CHECK( later.read( pose ) && (pose.seq == 4U) && (later.version() == 1U) );
+    }
+
+    /** Records the seq of each received Pose
+     */
+    class PoseSink : public sub0::Subscribe<Pose>
+    {
+    public:
+        PoseSink()
+            : count(0U)
+        {}
+
+        virtual void receive( const Pose& pose ) final
+        {
+            if ( count < 4U )
+                seqs[count] = pose.seq;
+            ++count;
+        }
+
+        uint64_t seqs[4]; ///< seq of the first received Pose
+        uint32_t count; ///< Count of received Pose
+    };
+
+    /** Queues Pose for drain()
+     */
+    class PoseQueue : public sub0::AsyncSubscribe<Pose>
+    {
+    public:
+        PoseQueue()
+            : last(0U)
+        {}
+
+        virtual void receive( const Pose& pose ) final
+        { last = pose.seq; }
+
+        uint64_t last; ///< seq of the last drained Pose
+    };
+
+    /** Subscribers receive the cached value once when registered, and a replay taken before a newer publish is skipped
+     */
+    void testCachedReplay()
+    {
+        const sub0::Publish<Pose> publisher;
+        publisher.publish( Pose{ 5U, 5.0, 35U } );
+        {
+            sub0::Subscribed<PoseSink> sink;
+            SUB0PUB_TEST_CHECK( (sink.count == 1U) && (sink.seqs[0] == 5U) );
+            publisher.publish( Pose{ 6U, 6.0, 42U } );
+            SUB0PUB_TEST_CHECK( (sink.count == 2U) && (sink.seqs[1] == 6U) );
+
+            PoseQueue queue;
+            SUB0PUB_TEST_CHECK( (queue.drain() == 1U) && (queue.last == 6U) && queue.empty() );
+        }
+
+        const sub0::Broker<Pose> broker( (sub0::Unsubscribed()) );
+        uint64_t replayed = 0U;
+        const sub0::Subscription<Pose> subscription( []( void* target, const Pose& pose ) { *static_cast<uint64_t*>(target) = pose.seq; }, &replayed );
+        const uint32_t version = broker.lastVersion();
+        publisher.publish( Pose{ 7U, 7.0, 49U } );
+        SUB0PUB_TEST_CHECK( !broker.replay( subscription, version ) && (replayed == 0U) );
+        SUB0PUB_TEST_CHECK( broker.replay( subscription, broker.lastVersion() ) && (replayed == 7U) );
+    }
+
+    /** Deferred subscriber counting received data
+     */
+    template< typename Data >
+    class DeferredCount : public sub0::DeferredSubscribe<Data>
+    {
+    public:
+        explicit DeferredCount( sub0::detail::DeferredSubscriptions<Data>& delivery, const sub0::Priority priority = sub0::Priority() )
+            : sub0::DeferredSubscribe<Data>( delivery, priority )
+            , count(0U)
+        {}
+
+        ~DeferredCount()
+        { this->unsubscribe(); }
+
+        virtual void receive( const Data& ) override
+        { count.fetch_add( 1U, std::memory_order_relaxed ); }
+
+        /** Wait up to about ten seconds for 'expected' receives
+         */
+        bool waitFor( const uint32_t expected ) const
+        {
+            for ( int iWait = 0; (iWait < 10000) && (count.load( std::memory_order_relaxed ) < expected); ++iWait )
+                std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+            return count.load( std::memory_order_relaxed ) == expected;
+        }
+
+        std::atomic<uint32_t> count; ///< Count of received data
+    };
+
+    /** Publishes more Echo from the worker than its mailbox holds
+     */
+    class EchoSink : public DeferredCount<Echo>
+    {
+    public:
+        explicit EchoSink( sub0::detail::DeferredSubscriptions<Echo>& delivery )
+            : DeferredCount<Echo>( delivery )
+        {}
+
+        ~EchoSink()
+        { unsubscribe(); }
+
+        virtual void receive( const Echo& echo ) final
+        {
+            DeferredCount<Echo>::receive( echo );
+            if ( echo.depth == 0U )
+            {
+                for ( uint32_t iEcho = 0U; iEcho < 16U; ++iEcho )
+                    publisher_.publish( Echo{ 1U } );
+            }
+        }
+
+    private:
+        const sub0::Publish<Echo> publisher_;
+    };
+
+    /** A deferred subscriber publishing into its own full mailbox drops the overflow instead of blocking the worker
+     */
+    void testDeferredReentrant()
+    {
+        sub0::DeferredDelivery<Echo, 4U> delivery;
+        EchoSink sink( delivery );
+        const sub0::Publish<Echo> publisher;
+        publisher.publish( Echo{ 0U } );
+
+        SUB0PUB_TEST_CHECK( sink.waitFor( 1U + 4U ) && (delivery.dropCount() == (16U - 4U)) );
+    }
+
+    /** With cConcurrent several threads publish into the mailbox at once without losing data
+     */
+    void testDeferredShared()
+    {
+        const uint32_t cPublishers = 4U;
+        const uint32_t cCount = 20000U;
+        sub0::DeferredDelivery<Tick, 64U> delivery;
+        DeferredCount<Tick> sink( delivery );
+        std::vector<std::thread> publishers;
+        for ( uint32_t iPublisher = 0U; iPublisher < cPublishers; ++iPublisher )
+        {
+            publishers.emplace_back( [cCount]()
+            {
+                const sub0::Publish<Tick> publisher;
+                for ( uint32_t iTick = 0U; iTick < cCount; ++iTick )
+                    publisher.publish( Tick{ iTick } );
+            } );
+        }
+        for ( std::thread& publisher : publishers )
+            publisher.join();
+
+        SUB0PUB_TEST_CHECK( sink.waitFor( cPublishers * cCount ) && (delivery.dropCount() == 0U) );
+    }
+
+    /** Receive order of direct and deferred Stage subscribers
+     */
+    struct StageLog
+    {
+        void append( const uint32_t tag )
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            tags.push_back( tag );
+        }
+
+        std::mutex mutex; ///< Guards tags, appended from the publisher and worker threads
+        std::vector<uint32_t> tags; ///< Tags in receive order
+    };
+
+    /** Direct subscriber slow to receive, so a deferred subscriber running before it is seen in the log
+     */
+    class DirectStage : public sub0::Subscribe<Stage>
+    {
+    public:
+        DirectStage( StageLog& log, const sub0::Priority priority )
+            : sub0::Subscribe<Stage>( priority )
+            , log_(log)
+        {}
+
+        virtual void receive( const Stage& ) final
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+            log_.append( 0U );
+        }
+
+    private:
+        StageLog& log_; ///< Shared receive order
+    };
+
+    /** Deferred subscriber recording its tag
+     */
+    class DeferredStage : public DeferredCount<Stage>
+    {
+    public:
+        DeferredStage( sub0::detail::DeferredSubscriptions<Stage>& delivery, StageLog& log, const uint32_t tag, const sub0::Priority priority )
+            : DeferredCount<Stage>( delivery, priority )
+            , log_(log)
+            , tag_(tag)
+        {}
+
+        ~DeferredStage()
+        { unsubscribe(); }
+
+        virtual void receive( const Stage& stage ) final
+        {
+            log_.append( tag_ );
+            DeferredCount<Stage>::receive( stage );
+        }
+
+    private:
+        StageLog& log_; ///< Shared receive order
+        const uint32_t tag_; ///< Identifies this sink in the log
+    };
+
+    /** Deferred subscribers receive after every direct subscriber, even one of lower priority subscribed later, and in
+     *  priority order among themselves
+     */
+    void testDeferredOrder()
+    {
+        StageLog log;
+        sub0::DeferredDelivery<Stage> delivery;
+        DeferredStage low( delivery, log, 1U, sub0::Priority( -5 ) );
+        DeferredStage high( delivery, log, 2U, sub0::Priority( sub0::Priority::cCritical ) );
+        DeferredStage normal( delivery, log, 3U, sub0::Priority() );
+        DirectStage direct( log, sub0::Priority( -1000 ) );
+        const sub0::Publish<Stage> publisher;
+        publisher.publish( Stage{ 1U } );
+        publisher.publish( Stage{ 2U } );
+
+        SUB0PUB_TEST_CHECK( low.waitFor( 2U ) );
+        std::lock_guard<std::mutex> lock( log.mutex );
+        std::vector<uint32_t> deferred;
+        uint32_t directCount = 0U;
+        bool afterDirect = true;
+        for ( const uint32_t tag : log.tags )
+        {
+            if ( tag == 0U )
+            {
+                ++directCount;
+                continue;
+            }
+            afterDirect = afterDirect && (directCount > (deferred.size() / 3U)); //< Publish n reached its direct subscriber first
+            deferred.push_back( tag );
+        }
+        SUB0PUB_TEST_CHECK( (directCount == 2U) && afterDirect );
+        SUB0PUB_TEST_CHECK( deferred == (std::vector<uint32_t>{ 2U, 3U, 1U, 2U, 3U, 1U }) );
+    }
+
+    /** Subscriber pinned to a worker counting receives off that worker
+     */
+    class PinnedSink : public sub0::ParallelSubscribe<Job>
+    {
+    public:
+        PinnedSink( sub0::ParallelDelivery<Job>& delivery, const int32_t worker, std::thread::id* const workerThread )
+            : sub0::ParallelSubscribe<Job>( delivery, sub0::Affinity( worker ) )
+            , workerThread_(workerThread)
+            , count(0U)
+            , misplaced(0U)
+        {}
+
+        ~PinnedSink()
+        { unsubscribe(); }
+
+        virtual void receive( const Job& ) final
+        {
+            if ( *workerThread_ != std::this_thread::get_id() )
+                ++misplaced;
+            ++count;
+        }
+
+        std::thread::id* const workerThread_; ///< Thread of the pinned worker
+        uint32_t count; ///< Count of received jobs
+        uint32_t misplaced; ///< Count of jobs received on another thread
+    };
+
+    /** Learns the thread of a worker from its first pinned task
+     */
+    class WorkerProbe : public sub0::ParallelSubscribe<Job>
+    {
+    public:
+        WorkerProbe( sub0::ParallelDelivery<Job>& delivery, const int32_t worker )
+            : sub0::ParallelSubscribe<Job>( delivery, sub0::Affinity( worker ) )
+            , thread()
+        {}
+
+        ~WorkerProbe()
+        { unsubscribe(); }
+
+        virtual void receive( const Job& ) final
+        { thread = std::this_thread::get_id(); }
+
+        std::thread::id thread; ///< Thread of the pinned worker
+    };
+
+    /** Pinned tasks beyond the queue capacity still run on their worker
+     */
+    void testParallelAffinity()
+    {
+        sub0::ParallelExecutor<2U> executor;
+        sub0::ParallelDelivery<Job> delivery( executor );
+        const sub0::Publish<Job> publisher;
+
+        std::thread::id workerThreads[2];
+        {
+            WorkerProbe probe0( delivery, 0 );
+            WorkerProbe probe1( delivery, 1 );
+            publisher.publish( Job{ 0U } );
+            workerThreads[0] = probe0.thread;
+            workerThreads[1] = probe1.thread;
+        }
+
+        const uint32_t cSinks = 3U * sub0::detail::WorkStealingPool::cQueueCapacity;
+        std::vector< std::unique_ptr<PinnedSink> > sinks;
+        for ( uint32_t iSink = 0U; iSink < cSinks; ++iSink )
+            sinks.emplace_back( new PinnedSink( delivery, iSink % 2U, &workerThreads[iSink % 2U] ) );
+
+        for ( uint32_t iPublish = 0U; iPublish < 20U; ++iPublish )
+            publisher.publish( Job{ iPublish } );
+
+        for ( const std::unique_ptr<PinnedSink>& sink : sinks )
+            SUB0PUB_TEST_CHECK( (sink->count == 20U) && (sink->misplaced == 0U) );
+    }
+} // END: namespace
+
+int main()
+{
+    testMailboxOrder();
+    testMailboxSharedOrder();
+    testOverflow();
+    testSeqLockSlot();
+    testLatestReplay();
+    testCachedReplay();
+    testDeferredReentrant();
+    testDeferredShared();
+    testDeferredOrder();
+    testParallelAffinity();
+    return sub0test::result();
+}
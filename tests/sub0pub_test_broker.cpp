@@ -0,0 +1,253 @@
+/** Broker tests: subscribe and unsubscribe from other threads and from handlers while data is published
+ */
+
+#include "sub0pub_test.hpp"
+
+#include <atomic> //< std::atomic
+#include <stdexcept> //< std::runtime_error
+#include <thread> //< std::thread
+#include <vector> //< std::vector
+
+namespace
+{
+    /** Published data of the concurrent broker
+     */
+    struct Sample
+    {
+        uint32_t value;
+    };
+
+    /** Published data of a broker with a small fixed subscription table
+     */
+    struct Fixed
+    {
+        uint32_t value;
+    };
+} // END: namespace
+
+namespace sub0
+{
+    template<>
+    struct BrokerTraits<Sample> : DefaultBrokerTraits
+    {
+        static const bool cConcurrent = true;
+    };
+
+    template<>
+    struct BrokerTraits<Fixed> : DefaultBrokerTraits
+    {
+        static const uint32_t cMaxSubscriptions = 2U;
+    };
+}
+
+namespace
+{
+    /** Subscriber counting received data, registered through sub0::Subscribed
+     */
+    class CountingSink : public sub0::Subscribe<Sample>
+    {
+    public:
+        CountingSink()
+            : count(0U)
+        {}
+
+        virtual void receive( const Sample& sample ) final
+        { count.fetch_add( sample.value, std::memory_order_relaxed ); }
+
+        std::atomic<uint64_t> count; ///< Sum of received values
+    };
+
+    /** Marks its owner alive from construction until destruction
+     */
+    struct Alive
+    {
+        static const uint32_t cAlive = 0x600DF00DU;
+
+        Alive()
+            : value(cAlive)
+        {}
+
+        ~Alive()
+        { value = 0U; }
+
+        volatile uint32_t value; ///< cAlive while the owner is alive
+    };
+
+    /** Subscription created and destroyed while other threads publish, checking it is alive whenever it receives
+     * @remark FunctionSubscribe registers once its context is constructed and unregisters before the context is destroyed
+     */
+    class ChurnSink
+    {
+    public:
+        ChurnSink()
+            : alive()
+            , subscription( &ChurnSink::receive, this )
+        {}
+
+    private:
+        static void receive( void* const context, const Sample& )
+        { SUB0PUB_TEST_CHECK( static_cast<ChurnSink*>(context)->alive.value == Alive::cAlive ); }
+
+        Alive alive; ///< Destroyed after subscription
+        sub0::FunctionSubscribe<Sample> subscription; ///< Registered while alive
+    };
+
+    /** Subscribe derived subscriber checking its members are alive whenever it receives
+     */
+    class ChurnSubscriber : public sub0::Subscribe<Sample>
+    {
+    public:
+        virtual void receive( const Sample& ) final
+        { SUB0PUB_TEST_CHECK( alive.value == Alive::cAlive ); }
+
+    private:
+        Alive alive; ///< Constructed after and destroyed before the Subscribe base
+    };
+
+    /** Subscribers created and destroyed on several threads while others publish
+     */
+    void testConcurrentSubscribe()
+    {
+        const int cPublishers = 3;
+        const int cChurners = 2;
+        const int cChurnCount = 20000;
+
+        sub0::Subscribed<CountingSink> keep;
+        std::atomic<bool> stop( false );
+        std::atomic<uint64_t> published( 0U );
+        std::vector<std::thread> threads;
+        for ( int iPublisher = 0; iPublisher < cPublishers; ++iPublisher )
+        {
+            threads.emplace_back( [&]()
+            {
+                const sub0::Publish<Sample> publisher;
+                uint64_t count = 0U;
+                while ( !stop.load( std::memory_order_relaxed ) )
+                {
+                    publisher.publish( Sample{ 1U } );
+                    ++count;
+                }
+                published.fetch_add( count, std::memory_order_relaxed );
+            } );
+        }
+
+        std::vector<std::thread> churners;
+        for ( int iChurner = 0; iChurner < cChurners; ++iChurner )
+        {
+            churners.emplace_back( [&]()
+            {
+                for ( int iChurn = 0; iChurn < cChurnCount; ++iChurn )
+                {
+                    ChurnSink* const sink = new ChurnSink();
+                    ChurnSink nested;
+                    const sub0::Subscribed<ChurnSubscriber> subscriber;
+                    delete sink;
+                }
+            } );
+        }
+
+        for ( std::thread& churner : churners )
+            churner.join();
+        stop.store( true, std::memory_order_relaxed );
+        for ( std::thread& thread : threads )
+            thread.join();
+
+        SUB0PUB_TEST_CHECK( keep.count.load() == published.load() );
+
+        sub0::Subscribed<CountingSink> late;
+        const sub0::Publish<Sample> publisher;
+        publisher.publish( Sample{ 5U } );
+        SUB0PUB_TEST_CHECK( late.count.load() == 5U );
+        SUB0PUB_TEST_CHECK( keep.count.load() == (published.load() + 5U) );
+    }
+
+    /** Subscribes and unsubscribes a nested subscription from within receive()
+     */
+    class NestingSink : public sub0::Subscribe<Sample>
+    {
+    public:
+        NestingSink()
+            : count(0U)
+            , nested(0U)
+        { subscribe(); }
+
+        ~NestingSink()
+        { unsubscribe(); }
+
+        virtual void receive( const Sample& ) final
+        {
+            count.fetch_add( 1U, std::memory_order_relaxed );
+            static thread_local NestingSink* const self = this; //< Context unique to the publishing thread, written before subscribing
+            const sub0::FunctionSubscribe<Sample> subscription( &NestingSink::receiveNested, const_cast<NestingSink**>(&self) ); //< Unsubscribed before returning
+        }
+
+        static void receiveNested( void* const context, const Sample& )
+        { (*static_cast<NestingSink* const*>(context))->nested.fetch_add( 1U, std::memory_order_relaxed ); }
+
+        std::atomic<uint64_t> count; ///< Count of received Sample
+        std::atomic<uint64_t> nested; ///< Count received by nested subscriptions
+    };
+
+    /** Subscribe and unsubscribe from handlers on several publishing threads neither deadlock nor lose deliveries
+     */
+    void testSubscribeFromHandler()
+    {
+        const int cPublishers = 3;
+        const uint64_t cPublishCount = 5000U;
+
+        NestingSink sink;
+        std::vector<std::thread> threads;
+        for ( int iPublisher = 0; iPublisher < cPublishers; ++iPublisher )
+        {
+            threads.emplace_back( [&]()
+            {
+                const sub0::Publish<Sample> publisher;
+                for ( uint64_t iPublish = 0U; iPublish < cPublishCount; ++iPublish )
+                    publisher.publish( Sample{ 1U } );
+            } );
+        }
+        for ( std::thread& thread : threads )
+            thread.join();
+
+        SUB0PUB_TEST_CHECK( sink.count.load() == (cPublishers * cPublishCount) );
+
+        const sub0::Publish<Sample> publisher;
+        const uint64_t nested = sink.nested.load();
+        publisher.publish( Sample{ 1U } );
+        SUB0PUB_TEST_CHECK( sink.nested.load() == nested ); //< Every nested subscription was removed
+    }
+
+    void receiveFixed( void* const context, const Fixed& fixed )
+    { *static_cast<uint32_t*>(context) += fixed.value; }
+
+    /** Subscribing to a full fixed table is reported rather than silently dropped
+     */
+    void testFixedFull()
+    {
+        uint32_t received[3] = {};
+        sub0::FunctionSubscribe<Fixed> first( &receiveFixed, &received[0] );
+        sub0::FunctionSubscribe<Fixed> second( &receiveFixed, &received[1] );
+        bool thrown = false;
+        try
+        {
+            sub0::FunctionSubscribe<Fixed> third( &receiveFixed, &received[2] );
+        }
+        catch ( const std::runtime_error& )
+        {
+            thrown = true;
+        }
+        SUB0PUB_TEST_CHECK( thrown );
+
+        const sub0::Publish<Fixed> publisher;
+        publisher.publish( Fixed{ 1U } );
+        SUB0PUB_TEST_CHECK( (received[0] == 1U) && (received[1] == 1U) && (received[2] == 0U) );
+    }
+} // END: namespace
+
+int main()
+{
+    testConcurrentSubscribe();
+    testSubscribeFromHandler();
+    testFixedFull();
+    return sub0test::result();
+}
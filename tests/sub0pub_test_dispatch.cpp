@@ -0,0 +1,446 @@
+/** Dispatch tests: devirtualised and function subscriptions, batches, priority order, keyed subscriptions, channels
+ */
+
+#include "sub0pub_test.hpp"
+
+#include <vector> //< std::vector
+
+namespace
+{
+    /** Published data of the dispatch tests
+     */
+    struct Value
+    {
+        uint32_t value;
+    };
+
+    /** Published in batches
+     */
+    struct Point
+    {
+        uint32_t index;
+    };
+
+    /** Delivered in priority order
+     */
+    struct Ordered
+    {
+        uint32_t value;
+    };
+
+    /** Delivered to the subscribers of its symbol
+     */
+    struct Tick
+    {
+        uint32_t symbol;
+        uint32_t price;
+    };
+
+    /** Delivered to the subscribers of its venue
+     */
+    struct Quote
+    {
+        char venue[4];
+        uint32_t price;
+    };
+
+    /** Published on compile-time and runtime channels
+     */
+    struct Frame
+    {
+        uint32_t camera;
+    };
+
+    /** Compile-time channels of Frame
+     */
+    struct LeftCamera {};
+    struct RightCamera {};
+
+    /** Integer key of Tick, hashed by the index
+     */
+    struct SymbolOf
+    {
+        typedef uint32_t Key;
+        static Key key( const Tick& tick ) { return tick.symbol; }
+    };
+
+    /** Venue name of a Quote
+     */
+    struct Venue
+    {
+        bool operator==( const Venue& other ) const
+        { return std::memcmp( name, other.name, sizeof(name) ) == 0; }
+
+        char name[4];
+    };
+
+    /** Struct key of Quote with a hash placing every venue in the same bucket, so keys are found by probing
+     */
+    struct VenueOf
+    {
+        typedef Venue Key;
+        static Key key( const Quote& quote ) { Venue venue; std::memcpy( venue.name, quote.venue, sizeof(venue.name) ); return venue; }
+        static uint32_t hash( const Key& ) { return 0U; }
+    };
+
+    /** Direct subscriber without filter(), receives every Value
+     */
+    class DirectSink : public sub0::DirectSubscribe<Value, DirectSink>
+    {
+    public:
+        DirectSink()
+            : sum(0U)
+        {}
+
+        void receive( const Value& value )
+        { sum += value.value; }
+
+        uint32_t sum; ///< Sum of received values
+    };
+
+    /** Direct subscriber whose filter() passes even values only
+     */
+    class EvenSink : public sub0::DirectSubscribe<Value, EvenSink>
+    {
+    public:
+        EvenSink()
+            : filtered(0U)
+            , received()
+        {}
+
+        bool filter( const Value& value )
+        {
+            ++filtered;
+            return (value.value % 2U) == 0U;
+        }
+
+        void receive( const Value& value )
+        { received.push_back( value.value ); }
+
+        uint32_t filtered; ///< Count of filter() calls
+        std::vector<uint32_t> received; ///< Received values in order
+    };
+
+    void receiveValue( void* const context, const Value& value )
+    { static_cast<std::vector<uint32_t>*>(context)->push_back( value.value ); }
+
+    /** DirectSubscribe calls Target::receive directly, through Target::filter only when declared, and FunctionSubscribe calls
+     *  its function with its context until destroyed
+     */
+    void testDirect()
+    {
+        const sub0::Publish<Value> publisher;
+        DirectSink all;
+        EvenSink even;
+        std::vector<uint32_t> function;
+        {
+            sub0::FunctionSubscribe<Value> subscription( &receiveValue, &function );
+            for ( uint32_t iValue = 1U; iValue <= 4U; ++iValue )
+                publisher.publish( Value{ iValue } );
+        }
+        publisher.publish( Value{ 6U } );
+
+        SUB0PUB_TEST_CHECK( all.sum == (1U + 2U + 3U + 4U + 6U) );
+        SUB0PUB_TEST_CHECK( (even.filtered == 5U) && (even.received == std::vector<uint32_t>{ 2U, 4U, 6U }) );
+        SUB0PUB_TEST_CHECK( function == (std::vector<uint32_t>{ 1U, 2U, 3U, 4U }) );
+    }
+
+    /** Receives batches whole, recording their sizes
+     */
+    class BatchSink : public sub0::Subscribe<Point>
+    {
+    public:
+        virtual void receive( const Point& point ) final
+        { singles.push_back( point.index ); }
+
+        virtual void receiveBatch( const Point* points, const size_t count ) final
+        {
+            batches.push_back( count );
+            for ( size_t iPoint = 0U; iPoint < count; ++iPoint )
+                singles.push_back( points[iPoint].index );
+        }
+
+        std::vector<size_t> batches; ///< Size of each received batch
+        std::vector<uint32_t> singles; ///< Received indexes in order
+    };
+
+    /** Receives batches per element through the default receiveBatch(), filter() passes odd indexes
+     */
+    class OddSink : public sub0::Subscribe<Point>
+    {
+    public:
+        virtual bool filter( const Point& point ) final
+        { return (point.index % 2U) == 1U; }
+
+        virtual void receive( const Point& point ) final
+        { received.push_back( point.index ); }
+
+        std::vector<uint32_t> received; ///< Received indexes in order
+    };
+
+    /** Direct subscriber receiving batches whole through Target::receiveBatch
+     */
+    class DirectBatchSink : public sub0::DirectSubscribe<Point, DirectBatchSink>
+    {
+    public:
+        DirectBatchSink()
+            : singles(0U)
+            , batched(0U)
+        {}
+
+        void receive( const Point& )
+        { ++singles; }
+
+        void receiveBatch( const Point*, const size_t count )
+        { batched += static_cast<uint32_t>(count); }
+
+        uint32_t singles; ///< Count received through receive()
+        uint32_t batched; ///< Count received through receiveBatch()
+    };
+
+    void receivePoint( void* const context, const Point& point )
+    { static_cast<std::vector<uint32_t>*>(context)->push_back( point.index ); }
+
+    /** publishBatch passes the whole span to batch receivers in one call and per element, filtered, to the others
+     */
+    void testBatch()
+    {
+        const sub0::Publish<Point> publisher;
+        BatchSink batch;
+        OddSink odd;
+        DirectBatchSink direct;
+        std::vector<uint32_t> function;
+        sub0::FunctionSubscribe<Point> subscription( &receivePoint, &function );
+
+        const Point points[5] = { { 0U }, { 1U }, { 2U }, { 3U }, { 4U } };
+        publisher.publishBatch( points, 5U );
+        publisher.publishBatch( points, 0U );
+        publisher.publish( points[1] );
+
+        SUB0PUB_TEST_CHECK( (batch.batches == std::vector<size_t>{ 5U }) && (batch.singles == std::vector<uint32_t>{ 0U, 1U, 2U, 3U, 4U, 1U }) );
+        SUB0PUB_TEST_CHECK( odd.received == (std::vector<uint32_t>{ 1U, 3U, 1U }) );
+        SUB0PUB_TEST_CHECK( (direct.batched == 5U) && (direct.singles == 1U) );
+        SUB0PUB_TEST_CHECK( function == (std::vector<uint32_t>{ 0U, 1U, 2U, 3U, 4U, 1U }) );
+    }
+
+    /** Records its tag in a shared log on receive
+     */
+    class OrderSink : public sub0::Subscribe<Ordered>
+    {
+    public:
+        OrderSink( std::vector<uint32_t>& log, const uint32_t tag, const sub0::Priority priority = sub0::Priority() )
+            : sub0::Subscribe<Ordered>( priority )
+            , log_(log)
+            , tag_(tag)
+        {}
+
+        virtual void receive( const Ordered& ) final
+        { log_.push_back( tag_ ); }
+
+    private:
+        std::vector<uint32_t>& log_; ///< Receive order of all sinks
+        const uint32_t tag_; ///< Identifies this sink in the log
+    };
+
+    /** Direct subscriber recording its tag in a shared log on receive
+     */
+    class DirectOrderSink : public sub0::DirectSubscribe<Ordered, DirectOrderSink>
+    {
+    public:
+        DirectOrderSink( std::vector<uint32_t>& log, const uint32_t tag, const sub0::Priority priority )
+            : sub0::DirectSubscribe<Ordered, DirectOrderSink>( priority )
+            , log_(log)
+            , tag_(tag)
+        {}
+
+        void receive( const Ordered& )
+        { log_.push_back( tag_ ); }
+
+    private:
+        std::vector<uint32_t>& log_; ///< Receive order of all sinks
+        const uint32_t tag_; ///< Identifies this sink in the log
+    };
+
+    void receiveOrdered( void* const context, const Ordered& )
+    { static_cast<std::vector<uint32_t>*>(context)->push_back( 7U ); }
+
+    /** Higher priorities receive first, equal priorities in the order they subscribed, including after an unsubscribe
+     */
+    void testPriority()
+    {
+        const sub0::Publish<Ordered> publisher;
+        std::vector<uint32_t> log;
+        OrderSink normal( log, 1U );
+        OrderSink critical( log, 2U, sub0::Priority( sub0::Priority::cCritical ) );
+        OrderSink later( log, 3U );
+        OrderSink low( log, 4U, sub0::Priority( -5 ) );
+        DirectOrderSink direct( log, 5U, sub0::Priority( 10 ) );
+        sub0::FunctionSubscribe<Ordered> function( &receiveOrdered, &log, 0/*nullptr*/, sub0::Priority( sub0::Priority::cCritical ) );
+        publisher.publish( Ordered{ 0U } );
+        SUB0PUB_TEST_CHECK( log == (std::vector<uint32_t>{ 2U, 7U, 5U, 1U, 3U, 4U }) );
+
+        log.clear();
+        {
+            OrderSink removed( log, 6U, sub0::Priority( 10 ) );
+            OrderSink last( log, 8U );
+            publisher.publish( Ordered{ 1U } );
+        }
+        OrderSink readded( log, 9U );
+        publisher.publish( Ordered{ 2U } );
+        SUB0PUB_TEST_CHECK( log == (std::vector<uint32_t>{ 2U, 7U, 5U, 6U, 1U, 3U, 8U, 4U, 2U, 7U, 5U, 1U, 3U, 9U, 4U }) );
+    }
+
+    /** Records received prices of one symbol with its tag in a shared log
+     */
+    class SymbolSink : public sub0::KeySubscribe<Tick, SymbolOf>
+    {
+    public:
+        SymbolSink( std::vector<uint32_t>& log, const uint32_t symbol, const uint32_t tag, const sub0::Priority priority = sub0::Priority() )
+            : sub0::KeySubscribe<Tick, SymbolOf>( symbol, priority )
+            , log_(log)
+            , tag_(tag)
+        {}
+
+        virtual void receive( const Tick& tick ) final
+        {
+            SUB0PUB_TEST_CHECK( tick.symbol == key() );
+            log_.push_back( (tag_ * 100U) + tick.price );
+        }
+
+    private:
+        std::vector<uint32_t>& log_; ///< Receive order of all sinks
+        const uint32_t tag_; ///< Identifies this sink in the log
+    };
+
+    /** Sums received prices of one venue
+     */
+    class VenueSink : public sub0::KeySubscribe<Quote, VenueOf, 4U>
+    {
+    public:
+        explicit VenueSink( const Venue& venue )
+            : sub0::KeySubscribe<Quote, VenueOf, 4U>( venue )
+            , sum(0U)
+        {}
+
+        virtual void receive( const Quote& quote ) final
+        { sum += quote.price; }
+
+        uint32_t sum; ///< Sum of received prices
+    };
+
+    /** Keyed subscribers receive only data of their key, in priority order within a key, and keys are reused after unsubscribe
+     */
+    void testKeys()
+    {
+        const sub0::Publish<Tick> publisher;
+        std::vector<uint32_t> log;
+        SymbolSink first( log, 1U, 1U );
+        SymbolSink second( log, 2U, 2U );
+        {
+            SymbolSink critical( log, 2U, 3U, sub0::Priority( sub0::Priority::cCritical ) );
+            publisher.publish( Tick{ 1U, 10U } );
+            publisher.publish( Tick{ 2U, 20U } );
+            publisher.publish( Tick{ 3U, 30U } );
+        }
+        publisher.publish( Tick{ 2U, 40U } );
+        SymbolSink third( log, 3U, 4U );
+        publisher.publish( Tick{ 3U, 50U } );
+        SUB0PUB_TEST_CHECK( log == (std::vector<uint32_t>{ 110U, 320U, 220U, 240U, 450U }) );
+
+        const sub0::Publish<Quote> quotes;
+        VenueSink lse( Venue{ { 'L', 'S', 'E', 0 } } );
+        VenueSink nyse( Venue{ { 'N', 'Y', 'S', 'E' } } );
+        quotes.publish( Quote{ { 'N', 'Y', 'S', 'E' }, 5U } );
+        quotes.publish( Quote{ { 'L', 'S', 'E', 0 }, 7U } );
+        quotes.publish( Quote{ { 'T', 'S', 'E', 0 }, 11U } );
+        quotes.publish( Quote{ { 'N', 'Y', 'S', 'E' }, 13U } );
+        SUB0PUB_TEST_CHECK( (lse.sum == 7U) && (nyse.sum == 18U) );
+    }
+
+    /** Records the cameras of received Frame of a channel
+     */
+    template< typename Channel >
+    class FrameSink : public sub0::Subscribe<Frame, Channel>
+    {
+    public:
+        FrameSink()
+            : cameras()
+        {}
+
+        explicit FrameSink( const sub0::ChannelId channel )
+            : sub0::Subscribe<Frame, Channel>( channel )
+            , cameras()
+        {}
+
+        virtual void receive( const Frame& frame ) final
+        { cameras.push_back( frame.camera ); }
+
+        std::vector<uint32_t> cameras; ///< Received cameras in order
+    };
+
+    /** Direct subscriber summing the cameras of received Frame of a compile-time channel
+     */
+    class DirectFrameSink : public sub0::DirectSubscribe<Frame, DirectFrameSink, RightCamera>
+    {
+    public:
+        DirectFrameSink()
+            : sum(0U)
+        {}
+
+        void receive( const Frame& frame )
+        { sum += frame.camera; }
+
+        uint32_t sum; ///< Sum of received cameras
+    };
+
+    void receiveFrame( void* const context, const Frame& frame )
+    { static_cast<std::vector<uint32_t>*>(context)->push_back( frame.camera ); }
+
+    /** Each compile-time tag and runtime channel id has its own subscribers, none of which receive another channel's data
+     */
+    void testChannels()
+    {
+        FrameSink<void> all;
+        FrameSink<LeftCamera> left;
+        DirectFrameSink right;
+        FrameSink<sub0::RuntimeChannel> first( sub0::ChannelId( 1U ) );
+        FrameSink<sub0::RuntimeChannel> second( sub0::ChannelId( 2U ) );
+        std::vector<uint32_t> function;
+        sub0::FunctionSubscribe<Frame, sub0::RuntimeChannel> subscription( sub0::ChannelId( 2U ), &receiveFrame, &function );
+
+        const sub0::Publish<Frame> publisher;
+        const sub0::Publish<Frame, LeftCamera> leftPublisher;
+        const sub0::Publish<Frame, RightCamera> rightPublisher;
+        const sub0::Publish<Frame, sub0::RuntimeChannel> firstPublisher( sub0::ChannelId( 1U ) );
+        const sub0::Publish<Frame, sub0::RuntimeChannel> secondPublisher( sub0::ChannelId( 2U ) );
+        const sub0::Publish<Frame, sub0::RuntimeChannel> unsubscribedPublisher( sub0::ChannelId( 3U ) );
+        publisher.publish( Frame{ 10U } );
+        leftPublisher.publish( Frame{ 20U } );
+        rightPublisher.publish( Frame{ 30U } );
+        firstPublisher.publish( Frame{ 40U } );
+        secondPublisher.publish( Frame{ 50U } );
+        unsubscribedPublisher.publish( Frame{ 60U } );
+        const Frame batch[2] = { { 70U }, { 80U } };
+        leftPublisher.publishBatch( batch, 2U );
+        {
+            const sub0::Publish<Frame, sub0::RuntimeChannel> samePublisher( sub0::ChannelId( 1U ) ); //< Shares the table of channel 1
+            samePublisher.publish( Frame{ 90U } );
+        }
+
+        SUB0PUB_TEST_CHECK( all.cameras == (std::vector<uint32_t>{ 10U }) );
+        SUB0PUB_TEST_CHECK( left.cameras == (std::vector<uint32_t>{ 20U, 70U, 80U }) );
+        SUB0PUB_TEST_CHECK( right.sum == 30U );
+        SUB0PUB_TEST_CHECK( first.cameras == (std::vector<uint32_t>{ 40U, 90U }) );
+        SUB0PUB_TEST_CHECK( (second.cameras == std::vector<uint32_t>{ 50U }) && (function == std::vector<uint32_t>{ 50U }) );
+    }
+} // END: namespace
+
+int main()
+{
+    testDirect();
+    testBatch();
+    testPriority();
+    testKeys();
+    testChannels();
+    return sub0test::result();
+}
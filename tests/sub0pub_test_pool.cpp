@@ -0,0 +1,236 @@
+/** Memory pool tests: exhaustion of Pool, ThreadArena and the LoanPublish pool is reported rather than using the heap, loans
+ *  are delivered in place
+ */
+
+#include "sub0pub_test.hpp"
+#include "sub0pub/loan.hpp"
+#include "sub0pub/pool.hpp"
+
+#include <thread> //< std::thread
+#include <utility> //< std::move
+#include <vector> //< std::vector
+
+namespace
+{
+    /** Pooled message
+     */
+    struct Message
+    {
+        uint64_t owner;
+        uint64_t seq;
+    };
+
+    /** Loaned image
+     */
+    struct Image
+    {
+        uint32_t value;
+    };
+} // END: namespace
+
+namespace sub0
+{
+    template<>
+    struct BrokerTraits<Message> : DefaultBrokerTraits
+    {
+        static const uint32_t cMaxPooled = 32U;
+    };
+}
+
+namespace
+{
+    /** Creating past the capacity fails without disturbing live blocks, a destroyed block is reused
+     */
+    void testPoolExhaustion()
+    {
+        sub0::Pool<Message>& pool = sub0::Pool<Message>::instance();
+        std::vector<Message*> held;
+        for ( uint32_t iCreate = 0U; iCreate < sub0::Pool<Message>::cCapacity; ++iCreate )
+        {
+            Message* const message = pool.create( Message{ 0U, iCreate } );
+            SUB0PUB_TEST_CHECK( message != nullptr );
+            held.push_back( message );
+        }
+        SUB0PUB_TEST_CHECK( pool.create() == nullptr );
+        SUB0PUB_TEST_CHECK( pool.create() == nullptr );
+
+        sub0::AllocationCounters counters = pool.counters();
+        SUB0PUB_TEST_CHECK( (counters.allocations == 32U) && (counters.failures == 2U) && (counters.highWater == 32U) && (counters.capacity == 32U) );
+        for ( uint32_t iHeld = 0U; iHeld < held.size(); ++iHeld )
+            SUB0PUB_TEST_CHECK( held[iHeld]->seq == iHeld );
+
+        pool.destroy( held.back() );
+        held.pop_back();
+        Message* const reused = pool.create();
+        SUB0PUB_TEST_CHECK( reused != nullptr );
+        held.push_back( reused );
+
+        for ( Message* const message : held )
+            pool.destroy( message );
+        counters = pool.counters();
+        SUB0PUB_TEST_CHECK( counters.allocations == counters.releases );
+    }
+
+    /** Threads contending for more blocks than exist never share a block and return every block
+     */
+    void testPoolContention()
+    {
+        sub0::Pool<Message>& pool = sub0::Pool<Message>::instance();
+        const sub0::AllocationCounters before = pool.counters();
+        std::vector<std::thread> threads;
+        for ( uint64_t iThread = 0U; iThread < 4U; ++iThread )
+        {
+            threads.emplace_back( [&pool, iThread]()
+            {
+                Message* held[16];
+                for ( uint64_t iRound = 0U; iRound < 20000U; ++iRound )
+                {
+                    uint32_t count = 0U;
+                    for ( ; count < 16U; ++count )
+                    {
+                        held[count] = pool.create( Message{ iThread, iRound } );
+                        if ( !held[count] )
+                            break;
+                    }
+                    for ( uint32_t iHeld = 0U; iHeld < count; ++iHeld )
+                    {
+                        SUB0PUB_TEST_CHECK( (held[iHeld]->owner == iThread) && (held[iHeld]->seq == iRound) );
+                        pool.destroy( held[iHeld] );
+                    }
+                }
+            } );
+        }
+        for ( std::thread& thread : threads )
+            thread.join();
+
+        const sub0::AllocationCounters after = pool.counters();
+        SUB0PUB_TEST_CHECK( after.allocations == after.releases );
+        SUB0PUB_TEST_CHECK( after.highWater <= 32U );
+        SUB0PUB_TEST_CHECK( after.failures > before.failures ); //< 64 wanted from 32 blocks
+    }
+
+    /** Pooled handles report exhaustion as false and return their block on destruction
+     */
+    void testPooledHandle()
+    {
+        {
+            std::vector< sub0::Pooled<Message> > handles;
+            uint32_t valid = 0U;
+            for ( uint32_t iHandle = 0U; iHandle < 40U; ++iHandle )
+            {
+                handles.push_back( sub0::makePooled<Message>() );
+                valid += handles.back() ? 1U : 0U;
+            }
+            SUB0PUB_TEST_CHECK( valid == 32U );
+        }
+        const sub0::AllocationCounters counters = sub0::Pool<Message>::instance().counters();
+        SUB0PUB_TEST_CHECK( counters.allocations == counters.releases );
+    }
+
+    /** An exhausted arena returns nullptr until reset()
+     */
+    void testArenaExhaustion()
+    {
+        typedef sub0::ThreadArena<256U> Arena;
+        uint32_t created = 0U;
+        for ( uint32_t iCreate = 0U; iCreate < 40U; ++iCreate )
+            created += Arena::create<Message>() ? 1U : 0U;
+        SUB0PUB_TEST_CHECK( created == (256U / sizeof(Message)) );
+        SUB0PUB_TEST_CHECK( Arena::counters().failures == (40U - created) );
+
+        Arena::reset();
+        SUB0PUB_TEST_CHECK( Arena::create<Message>() != nullptr );
+        Arena::reset();
+    }
+
+    /** Loans beyond cMaxLoans fail while every slot is held
+     */
+    void testLoanExhaustion()
+    {
+        const sub0::LoanPublish<Image> publisher;
+        {
+            std::vector< sub0::Loan<Image> > loans;
+            uint32_t valid = 0U;
+            for ( uint32_t iLoan = 0U; iLoan <= sub0::BrokerTraits<Image>::cMaxLoans; ++iLoan )
+            {
+                loans.push_back( publisher.loan() );
+                valid += loans.back() ? 1U : 0U;
+            }
+            SUB0PUB_TEST_CHECK( valid == sub0::BrokerTraits<Image>::cMaxLoans );
+        }
+        SUB0PUB_TEST_CHECK( bool( publisher.loan() ) );
+
+        const sub0::AllocationCounters counters = sub0::LoanPublish<Image>::poolCounters();
+        SUB0PUB_TEST_CHECK( counters.failures == 1U );
+        SUB0PUB_TEST_CHECK( counters.allocations == counters.releases );
+    }
+
+    /** Retains the loan handle it receives
+     */
+    class LoanSink : public sub0::LoanSubscribe<Image>
+    {
+    public:
+        virtual void receive( const sub0::SharedLoan<Image>& loan ) final
+        { retained = loan; }
+
+        sub0::SharedLoan<Image> retained; ///< Last received loan
+    };
+
+    /** Records the address of the Image it receives
+     */
+    class ImageSink : public sub0::Subscribe<Image>
+    {
+    public:
+        ImageSink()
+            : address(nullptr)
+            , value(0U)
+        {}
+
+        virtual void receive( const Image& image ) final
+        {
+            address = &image;
+            value = image.value;
+        }
+
+        const Image* address; ///< Received Image
+        uint32_t value; ///< Value of the received Image
+    };
+
+    /** A published loan reaches both subscriber kinds without a copy and its slot stays loaned while a handle retains it
+     */
+    void testLoanDelivery()
+    {
+        const sub0::LoanPublish<Image> publisher;
+        LoanSink loans;
+        ImageSink images;
+        const sub0::AllocationCounters before = sub0::LoanPublish<Image>::poolCounters();
+        {
+            sub0::Loan<Image> loan = publisher.loan();
+            SUB0PUB_TEST_CHECK( bool( loan ) );
+            loan->value = 42U;
+            publisher.publish( std::move(loan) );
+            SUB0PUB_TEST_CHECK( !loan );
+        }
+
+        SUB0PUB_TEST_CHECK( loans.retained && (loans.retained->value == 42U) );
+        SUB0PUB_TEST_CHECK( (images.address == &*loans.retained) && (images.value == 42U) );
+        sub0::AllocationCounters counters = sub0::LoanPublish<Image>::poolCounters();
+        SUB0PUB_TEST_CHECK( (counters.allocations - before.allocations) == 1U );
+        SUB0PUB_TEST_CHECK( (counters.releases - before.releases) == 0U );
+
+        loans.retained.reset();
+        counters = sub0::LoanPublish<Image>::poolCounters();
+        SUB0PUB_TEST_CHECK( counters.allocations == counters.releases );
+    }
+} // END: namespace
+
+int main()
+{
+    testPoolExhaustion();
+    testPoolContention();
+    testPooledHandle();
+    testArenaExhaustion();
+    testLoanExhaustion();
+    testLoanDelivery();
+    return sub0test::result();
+}
@@ -0,0 +1,287 @@
+/** Recording tests: Player replays complete records of truncated logs and stops at corrupt records
+ */
+
+#include "sub0pub_test.hpp"
+#include "sub0pub/record.hpp"
+
+#include <fstream> //< std::ofstream, std::ifstream
+#include <iterator> //< std::istreambuf_iterator
+#include <stdexcept> //< std::runtime_error
+
+namespace
+{
+    /** Recorded position
+     */
+    struct Position
+    {
+        double x;
+        double y;
+    };
+
+    /** Recorded heading, interleaved with Position to test filtered replay
+     */
+    struct Heading
+    {
+        double degrees;
+    };
+} // END: namespace
+
+SUB0_TYPENAME( Position, "Position" )
+SUB0_TYPENAME( Heading, "Heading" )
+
+namespace
+{
+    const char* const cLogPath = "sub0pub_test_record.log"; ///< Log written in the test working directory
+    const uint32_t cRecords = 100U; ///< Records written to the log
+    const uint64_t cInterval = 1000U; ///< Nanoseconds between record timestamps
+    const size_t cRecordBytes = 8U + sizeof(sub0::Recorder<>::Header_t) + sizeof(Position); ///< Bytes of a record, 8-byte aligned
+
+    /** Records Position
+     */
+    class Recording : public sub0::Recorder<>
+        , public sub0::ForwardSubscribe<Position, Recording>
+    {
+    public:
+        explicit Recording( std::ostream& stream )
+            : sub0::Recorder<>( stream, 16U )
+        {}
+    };
+
+    /** Replays Position
+     */
+    class Replay : public sub0::Player<>
+        , public sub0::DirectPublish<Position, Replay>
+    {
+    public:
+        explicit Replay( const char* const path )
+            : sub0::Player<>( path )
+        {
+            setSpeed( 0.0 );
+        }
+    };
+
+    /** Receives replayed Position in record order
+     */
+    class PositionSink : public sub0::Subscribe<Position>
+    {
+    public:
+        PositionSink()
+            : count(0U)
+            , first(-1.0)
+        {}
+
+        virtual void receive( const Position& position ) final
+        {
+            if ( count == 0U )
+                first = position.x;
+            SUB0PUB_TEST_CHECK( position.x == (first + count) );
+            ++count;
+        }
+
+        uint32_t count; ///< Count of received Position
+        double first; ///< x of the first received Position
+    };
+
+    /** @return Complete log of cRecords with trailer, record i at x i and timestamp i * cInterval
+     */
+    std::vector<char> recordLog()
+    {
+        {
+            std::ofstream file( cLogPath, std::ios::binary | std::ios::trunc );
+            Recording recording( file );
+            for ( uint32_t iRecord = 0U; iRecord < cRecords; ++iRecord )
+                recording.record( Position{ static_cast<double>(iRecord), 0.0 }, iRecord * cInterval );
+        }
+        std::ifstream file( cLogPath, std::ios::binary );
+        return std::vector<char>( (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>() );
+    }
+
+    void writeLog( const std::vector<char>& log, const size_t size )
+    {
+        std::ofstream file( cLogPath, std::ios::binary | std::ios::trunc );
+        file.write( log.data(), static_cast<std::streamsize>(size) );
+    }
+
+    /** @return File offset of the dataBytes field of record 'index'
+     */
+    size_t dataBytesOffset( const uint32_t index )
+    { return sizeof(sub0::record::FileHeader) + (index * cRecordBytes) + 8U + offsetof(sub0::Recorder<>::Header_t, dataBytes); }
+
+    /** A complete log replays every record and seeks by time
+     */
+    void testComplete()
+    {
+        recordLog();
+        Replay replay( cLogPath );
+        {
+            PositionSink sink;
+            SUB0PUB_TEST_CHECK( replay.play() == cRecords );
+            SUB0PUB_TEST_CHECK( (sink.count == cRecords) && replay.isEof() && !replay.isCorrupt() );
+        }
+
+        PositionSink later;
+        replay.seek( 90U * cInterval );
+        SUB0PUB_TEST_CHECK( replay.play() == 10U );
+        SUB0PUB_TEST_CHECK( (later.count == 10U) && (later.first == 90.0) );
+    }
+
+    /** A log cut within a record, without indexes, replays the complete records before the cut
+     */
+    void testTruncated()
+    {
+        const std::vector<char> log = recordLog();
+        const size_t cuts[] = { sizeof(sub0::record::FileHeader) + (60U * cRecordBytes) + 5U, sizeof(sub0::record::FileHeader) + (60U * cRecordBytes), log.size() - 1U };
+        const uint32_t expected[] = { 60U, 60U, cRecords };
+        for ( size_t iCut = 0U; iCut < (sizeof(cuts) / sizeof(cuts[0])); ++iCut )
+        {
+            writeLog( log, cuts[iCut] );
+            PositionSink sink;
+            Replay replay( cLogPath );
+            replay.play();
+            SUB0PUB_TEST_CHECK( (sink.count == expected[iCut]) && !replay.isCorrupt() );
+        }
+    }
+
+    /** A record whose size overruns the log stops replay there, including replay after a seek before it
+     */
+    void testCorrupt()
+    {
+        std::vector<char> log = recordLog();
+        const uint32_t huge = 0x7FFFFFFFU;
+        std::memcpy( &log[dataBytesOffset( 50U )], &huge, sizeof(huge) );
+        writeLog( log, log.size() );
+        {
+            PositionSink sink;
+            Replay replay( cLogPath );
+            replay.play();
+            SUB0PUB_TEST_CHECK( (sink.count == 50U) && replay.isCorrupt() && replay.isEof() );
+        }
+        {
+            PositionSink sink;
+            Replay replay( cLogPath );
+            replay.seek( 40U * cInterval );
+            replay.play();
+            SUB0PUB_TEST_CHECK( (sink.count == 10U) && (sink.first == 40.0) && replay.isCorrupt() );
+        }
+
+        writeLog( log, log.size() - sizeof(sub0::record::Trailer) ); //< Scanned without indexes, stopping at the corrupt record
+        {
+            PositionSink sink;
+            Replay replay( cLogPath );
+            replay.play();
+            SUB0PUB_TEST_CHECK( sink.count == 50U );
+        }
+    }
+
+    /** Replays Heading
+     */
+    class HeadingReplay : public Replay
+        , public sub0::DirectPublish<Heading, HeadingReplay>
+    {
+    public:
+        explicit HeadingReplay( const char* const path )
+            : Replay( path )
+        {}
+    };
+
+    /** Counts replayed Heading
+     */
+    class HeadingSink : public sub0::Subscribe<Heading>
+    {
+    public:
+        HeadingSink()
+            : count(0U)
+        {}
+
+        virtual void receive( const Heading& ) final
+        { ++count; }
+
+        uint32_t count; ///< Count of received Heading
+    };
+
+    /** A filtered replay walks the offsets of its types, a damaged record of another type is not read
+     */
+    void testFiltered()
+    {
+        std::vector<char> log;
+        {
+            std::ofstream file( cLogPath, std::ios::binary | std::ios::trunc );
+            sub0::Recorder<> recorder( file, 16U );
+            for ( uint32_t iRecord = 0U; iRecord < cRecords; ++iRecord )
+            {
+                recorder.record( Position{ static_cast<double>(iRecord), 0.0 }, iRecord * cInterval );
+                recorder.record( Heading{ 1.0 }, iRecord * cInterval );
+            }
+        }
+        {
+            std::ifstream file( cLogPath, std::ios::binary );
+            log.assign( (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>() );
+        }
+
+        {
+            PositionSink positions;
+            HeadingSink headings;
+            HeadingReplay replay( cLogPath );
+            replay.filter( sub0::typeId<Heading>() );
+            SUB0PUB_TEST_CHECK( replay.play() == cRecords );
+            SUB0PUB_TEST_CHECK( (positions.count == 0U) && (headings.count == cRecords) && replay.isEof() );
+
+            PositionSink later;
+            replay.clearFilter();
+            replay.filter( sub0::typeId<Position>() );
+            replay.seek( 90U * cInterval );
+            SUB0PUB_TEST_CHECK( (replay.play( 5U ) == 5U) && (later.first == 90.0) );
+            SUB0PUB_TEST_CHECK( (replay.play() == 5U) && (later.count == 10U) && (headings.count == cRecords) );
+        }
+
+        const size_t headingBytes = 8U + sizeof(sub0::Recorder<>::Header_t) + sizeof(Heading);
+        const size_t heading = sizeof(sub0::record::FileHeader) + (50U * (cRecordBytes + headingBytes)) + cRecordBytes;
+        const uint32_t huge = 0x7FFFFFFFU;
+        std::memcpy( &log[heading + 8U + offsetof(sub0::Recorder<>::Header_t, dataBytes)], &huge, sizeof(huge) );
+        writeLog( log, log.size() );
+        {
+            PositionSink positions;
+            HeadingReplay replay( cLogPath );
+            replay.filter( sub0::typeId<Position>() );
+            SUB0PUB_TEST_CHECK( replay.play() == cRecords );
+            SUB0PUB_TEST_CHECK( (positions.count == cRecords) && !replay.isCorrupt() );
+        }
+
+        writeLog( log, log.size() - sizeof(sub0::record::Trailer) ); //< Offsets rebuilt by scanning, stopping at the damaged record
+        {
+            PositionSink positions;
+            HeadingReplay replay( cLogPath );
+            replay.filter( sub0::typeId<Position>() );
+            SUB0PUB_TEST_CHECK( (replay.play() == 51U) && (positions.count == 51U) );
+        }
+    }
+
+    /** A file that is not a log is rejected
+     */
+    void testInvalid()
+    {
+        const std::vector<char> garbage( 256U, '\x5A' );
+        writeLog( garbage, garbage.size() );
+        bool rejected = false;
+        try
+        {
+            Replay replay( cLogPath );
+        }
+        catch ( const std::runtime_error& )
+        {
+            rejected = true;
+        }
+        SUB0PUB_TEST_CHECK( rejected );
+    }
+} // END: namespace
+
+int main()
+{
+    testComplete();
+    testTruncated();
+    testCorrupt();
+    testFiltered();
+    testInvalid();
+    std::remove( cLogPath );
+    return sub0test::result();
+}
@@ -0,0 +1,93 @@
+/** Registry tests: brokers are shared with a module loaded RTLD_LOCAL with hidden visibility, keyed by type id and name
+ */
+
+#include "sub0pub_test.hpp"
+#include "sub0pub_test_registry.hpp"
+
+#include <dlfcn.h> //< dlopen, dlsym
+
+namespace
+{
+    /** Sums received Sample of a channel
+     */
+    template< typename Channel >
+    class SumSink : public sub0::Subscribe<Sample, Channel>
+    {
+    public:
+        SumSink()
+            : sum(0U)
+        {}
+
+        explicit SumSink( const sub0::ChannelId channel )
+            : sub0::Subscribe<Sample, Channel>( channel )
+            , sum(0U)
+        {}
+
+        virtual void receive( const Sample& sample ) final
+        { sum += sample.value; }
+
+        uint32_t sum; ///< Sum of received values
+    };
+
+    void publishSamples()
+    {
+        const sub0::Publish<Sample> publisher;
+        publisher.publish( Sample{ 3U } );
+        publisher.publish( Sample{ 4U } );
+    }
+
+    /** @return Address of 'symbol' in the module, nullptr when missing
+     */
+    template< typename Function >
+    Function symbol( void* const module, const char* const name )
+    { return module ? reinterpret_cast<Function>( dlsym( module, name ) ) : 0/*nullptr*/; }
+
+    /** Publish and subscribe both ways across the module boundary on the default, compile-time and runtime channels
+     */
+    void testModule()
+    {
+        void* const module = dlopen( SUB0PUB_TEST_REGISTRY_MODULE, RTLD_NOW | RTLD_LOCAL );
+        const RegistryPublish publish = symbol<RegistryPublish>( module, "registryPublish" );
+        const RegistryReceive receive = symbol<RegistryReceive>( module, "registryReceive" );
+        const RegistryState state = symbol<RegistryState>( module, "registryState" );
+        SUB0PUB_TEST_CHECK( publish && receive && state );
+        if ( !(publish && receive && state) )
+            return;
+
+        SUB0PUB_TEST_CHECK( (state() == &sub0::detail::ChannelBinding<Sample, void>::state()) );
+
+        SumSink<void> sink;
+        SumSink<Secondary> secondary;
+        SumSink<sub0::RuntimeChannel> runtime( sub0::ChannelId( 7U ) );
+        SumSink<sub0::RuntimeChannel> other( sub0::ChannelId( 8U ) );
+        publish( 5U );
+        publish( 6U );
+        SUB0PUB_TEST_CHECK( (sink.sum == 11U) && (secondary.sum == 11U) && (runtime.sum == 11U) && (other.sum == 0U) );
+
+        SUB0PUB_TEST_CHECK( receive( &publishSamples ) == 7U );
+        SUB0PUB_TEST_CHECK( sink.sum == 18U );
+    }
+
+    void* createState( const char* const )
+    { return new uint32_t( 0U ); }
+
+    /** Entries are keyed by id and name, a colliding id with another name probes to its own entry
+     */
+    void testFind()
+    {
+        sub0::detail::BrokerRegistry& registry = sub0::detail::BrokerRegistry::instance();
+        void* const first = registry.find( 900U, "RegistryFirst", &createState, 0/*nullptr*/ );
+        void* const second = registry.find( 900U, "RegistrySecond", &createState, 0/*nullptr*/ );
+        SUB0PUB_TEST_CHECK( (first != 0/*nullptr*/) && (second != 0/*nullptr*/) && (first != second) );
+        SUB0PUB_TEST_CHECK( registry.find( 900U, "RegistryFirst", &createState, 0/*nullptr*/ ) == first );
+        SUB0PUB_TEST_CHECK( registry.find( 900U, "RegistrySecond", &createState, 0/*nullptr*/ ) == second );
+        SUB0PUB_TEST_CHECK( &registry == &sub0::detail::BrokerRegistry::instance() );
+    }
+} // END: namespace
+
+int main()
+{
+    testModule();
+    testFind();
+    return sub0test::result();
+}
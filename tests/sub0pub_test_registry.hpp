@@ -0,0 +1,34 @@
+/** Registry test support: Data and functions shared by the test executable and the module it loads
+ */
+#ifndef CROG_SUB0PUB_TEST_REGISTRY_HPP
+#define CROG_SUB0PUB_TEST_REGISTRY_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+/** Published across the module boundary
+ */
+struct Sample
+{
+    uint32_t value;
+};
+
+/** Tag of a compile-time channel of Sample
+ */
+struct Secondary {};
+
+SUB0_TYPEID( Sample, "Sample", 14U )
+
+/** Publish 'value' on the default, Secondary and runtime #7 channels of Sample from the module
+ */
+typedef void (*RegistryPublish)( uint32_t value );
+
+/** Subscribe to the default channel of Sample in the module while 'publish' runs
+ * @return Sum of the values received by the module
+ */
+typedef uint32_t (*RegistryReceive)( void (*publish)() );
+
+/** @return State of the default channel of Sample as resolved by the module
+ */
+typedef const void* (*RegistryState)();
+
+#endif
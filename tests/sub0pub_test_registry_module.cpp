@@ -0,0 +1,44 @@
+/** Registry test module: built with hidden visibility and loaded RTLD_LOCAL so it shares no template statics with the test
+ */
+
+#include "sub0pub_test_registry.hpp"
+
+#define SUB0PUB_TEST_EXPORT extern "C" __attribute__((visibility("default")))
+
+namespace
+{
+    /** Sums received Sample
+     */
+    class SumSink : public sub0::Subscribe<Sample>
+    {
+    public:
+        SumSink()
+            : sum(0U)
+        {}
+
+        virtual void receive( const Sample& sample ) final
+        { sum += sample.value; }
+
+        uint32_t sum; ///< Sum of received values
+    };
+} // END: namespace
+
+SUB0PUB_TEST_EXPORT void registryPublish( const uint32_t value )
+{
+    const sub0::Publish<Sample> publisher;
+    const sub0::Publish<Sample, Secondary> secondary;
+    const sub0::Publish<Sample, sub0::RuntimeChannel> runtime( sub0::ChannelId( 7U ) );
+    publisher.publish( Sample{ value } );
+    secondary.publish( Sample{ value } );
+    runtime.publish( Sample{ value } );
+}
+
+SUB0PUB_TEST_EXPORT uint32_t registryReceive( void (*publish)() )
+{
+    SumSink sink;
+    publish();
+    return sink.sum;
+}
+
+SUB0PUB_TEST_EXPORT const void* registryState()
+{ return &sub0::detail::ChannelBinding<Sample, void>::state(); }
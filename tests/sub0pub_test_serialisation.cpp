@@ -0,0 +1,426 @@
+/** Serialisation tests: deserialisers recover from corrupted and truncated streams, N-buffered forwarding, buffer register
+ *  lookups and type ids
+ */
+
+#include "sub0pub_test.hpp"
+
+#include <thread> //< std::thread
+
+namespace
+{
+    /** Published data alternating with Count in the serialised stream
+     */
+    struct Reading
+    {
+        float value;
+    };
+
+    /** Published data alternating with Reading in the serialised stream
+     */
+    struct Count
+    {
+        uint32_t value;
+    };
+
+    /** Type without a registered name or id
+     */
+    struct Unnamed
+    {
+        uint32_t value;
+    };
+} // END: namespace
+
+SUB0_TYPENAME( Reading, "Reading" )
+SUB0_TYPENAME( Count, "Count" )
+
+namespace
+{
+    typedef sub0::DefaultSerialisation Protocol;
+
+    const uint32_t cRecordPairs = 100U; ///< Reading and Count records written to the stream
+    const size_t cPrefixBytes = sizeof(Protocol::Prefix);
+    const size_t cRecordBytes = cPrefixBytes + sizeof(Protocol::Header) + sizeof(Reading) + sizeof(Protocol::Postfix); ///< Bytes of either record
+
+    /** Serialises Reading and Count into a stream
+     */
+    class Writer : public sub0::StreamSerializer<>
+        , public sub0::ForwardSubscribe<Reading, Writer>
+        , public sub0::ForwardSubscribe<Count, Writer>
+    {
+    public:
+        explicit Writer( sub0::OStream& stream )
+            : sub0::StreamSerializer<>( stream )
+        {}
+    };
+
+    /** Publishes Reading from a stream, Count records are skipped
+     */
+    class StreamReader : public sub0::StreamDeserializer<>
+        , public sub0::ForwardPublish<Reading, StreamReader>
+    {
+    public:
+        explicit StreamReader( sub0::IStream& stream )
+            : sub0::StreamDeserializer<>( stream )
+        {}
+    };
+
+    /** Publishes Reading from buffers, Count records are skipped
+     */
+    class BufferReader : public sub0::BufferDeserializer<>
+        , public sub0::DirectPublish<Reading, BufferReader>
+    {
+    public:
+        explicit BufferReader( const size_t maxDataBytes )
+            : sub0::BufferDeserializer<>( maxDataBytes )
+        {}
+    };
+
+    /** Receives the deserialised Reading
+     */
+    class ReadingSink : public sub0::Subscribe<Reading>
+    {
+    public:
+        ReadingSink()
+            : count(0U)
+            , last(-1.0f)
+        {}
+
+        virtual void receive( const Reading& reading ) final
+        {
+            ++count;
+            last = reading.value;
+        }
+
+        uint32_t count; ///< Count of received Reading
+        float last; ///< Value of the last received Reading
+    };
+
+    /** @return Stream of alternating Reading and Count records, Reading i has value i
+     */
+    std::vector<char> writeStream()
+    {
+        sub0test::MemoryStream stream;
+        {
+            Writer writer( stream );
+            const sub0::Publish<Reading> readings;
+            const sub0::Publish<Count> counts;
+            for ( uint32_t iPair = 0U; iPair < cRecordPairs; ++iPair )
+            {
+                readings.publish( Reading{ static_cast<float>(iPair) } );
+                counts.publish( Count{ iPair } );
+            }
+        }
+        SUB0PUB_TEST_CHECK( stream.buffer.size() == (2U * cRecordPairs * cRecordBytes) );
+        return stream.buffer;
+    }
+
+    /** Corrupt the postfix of Reading 5, the prefix of Reading 20 and the header size of Reading 35
+     */
+    std::vector<char> corruptStream( std::vector<char> buffer )
+    {
+        buffer[(2U * 5U * cRecordBytes) + cRecordBytes - 1U] ^= 0x5A;
+        buffer[(2U * 20U * cRecordBytes)] ^= 0x5A;
+        const Protocol::Header header( sub0::TypeName<Reading>::id(), 0xFFFFFFFFU );
+        std::memcpy( &buffer[(2U * 35U * cRecordBytes) + cPrefixBytes], &header, sizeof(header) );
+        return buffer;
+    }
+
+    /** BinaryReader, through StreamDeserializer, resyncs after each corruption whatever the read chunk size
+     */
+    void testStreamResync()
+    {
+        const sub0::IStream::StreamSize chunks[] = { ~0U, 1U, 7U };
+        for ( const sub0::IStream::StreamSize chunk : chunks )
+        {
+            sub0test::MemoryStream stream;
+            stream.buffer = corruptStream( writeStream() );
+            stream.rewind( chunk );
+
+            ReadingSink sink;
+            StreamReader reader( stream );
+            while ( !stream.isEof() )
+                reader.update();
+            while ( reader.update() )
+            {}
+
+            SUB0PUB_TEST_CHECK( sink.count == (cRecordPairs - 3U) );
+            SUB0PUB_TEST_CHECK( sink.last == static_cast<float>(cRecordPairs - 1U) );
+            SUB0PUB_TEST_CHECK( reader.resyncCount() == 3U );
+        }
+    }
+
+    /** Uncorrupted stream is read whole with Count records skipped
+     */
+    void testStreamClean()
+    {
+        sub0test::MemoryStream stream;
+        stream.buffer = writeStream();
+        ReadingSink sink;
+        StreamReader reader( stream );
+        while ( !stream.isEof() )
+            reader.update();
+
+        SUB0PUB_TEST_CHECK( sink.count == cRecordPairs );
+        SUB0PUB_TEST_CHECK( reader.resyncCount() == 0U );
+        SUB0PUB_TEST_CHECK( reader.skipCount() == cRecordPairs );
+    }
+
+    /** BufferDeserializer resyncs on corruption and holds back a truncated record until completed
+     */
+    void testBufferCorrupt()
+    {
+        const std::vector<char> buffer = corruptStream( writeStream() );
+        const size_t truncated = buffer.size() - cRecordBytes - 3U; //< Ends within the last Reading
+
+        ReadingSink sink;
+        BufferReader reader( 0U );
+        const size_t consumed = reader.update( buffer.data(), truncated );
+        SUB0PUB_TEST_CHECK( consumed == (buffer.size() - (2U * cRecordBytes)) );
+        SUB0PUB_TEST_CHECK( sink.count == (cRecordPairs - 4U) );
+        SUB0PUB_TEST_CHECK( reader.resyncCount() == 3U );
+
+        SUB0PUB_TEST_CHECK( reader.update( buffer.data() + consumed, buffer.size() - consumed ) == (buffer.size() - consumed) );
+        SUB0PUB_TEST_CHECK( sink.count == (cRecordPairs - 3U) );
+        SUB0PUB_TEST_CHECK( sink.last == static_cast<float>(cRecordPairs - 1U) );
+    }
+
+    /** BufferDeserializer fed from a stream in small chunks, then a stream of garbage, publishes nothing invalid
+     */
+    void testBufferStream()
+    {
+        sub0test::MemoryStream stream;
+        stream.buffer = corruptStream( writeStream() );
+        stream.rewind( 13U );
+        {
+            ReadingSink sink;
+            BufferReader reader( 16U );
+            while ( !stream.isEof() )
+                reader.update( stream );
+            while ( reader.update( stream ) )
+            {}
+            SUB0PUB_TEST_CHECK( sink.count == (cRecordPairs - 3U) );
+            SUB0PUB_TEST_CHECK( reader.resyncCount() == 3U );
+        }
+
+        stream.buffer.assign( 1U << 16U, '\xFF' );
+        stream.rewind( 4096U );
+        {
+            ReadingSink sink;
+            BufferReader reader( 64U );
+            while ( !stream.isEof() )
+                reader.update( stream );
+            SUB0PUB_TEST_CHECK( sink.count == 0U );
+        }
+    }
+
+    /** Publishes Reading from a stream through three payload slots, published by dispatch()
+     */
+    class BufferedReader : public sub0::StreamDeserializer<>
+        , public sub0::ForwardPublish<Reading, BufferedReader, 3U>
+    {
+    public:
+        explicit BufferedReader( sub0::IStream& stream )
+            : sub0::StreamDeserializer<>( stream )
+        {}
+    };
+
+    /** Receives Reading in stream order, checking the slot is not refilled while received
+     */
+    class OrderedSink : public sub0::Subscribe<Reading>
+    {
+    public:
+        OrderedSink()
+            : count(0U)
+            , misordered(0U)
+        {}
+
+        virtual void receive( const Reading& reading ) final
+        {
+            const float value = reading.value;
+            std::this_thread::yield(); //< Let the reader run ahead
+            if ( (value != static_cast<float>(count)) || (reading.value != value) )
+                ++misordered;
+            ++count;
+        }
+
+        uint32_t count; ///< Count of received Reading
+        uint32_t misordered; ///< Count of Reading received out of order or changed during receive
+    };
+
+    /** dispatch() publishes read slots in order, up to maxCount, and the reader fills later slots while earlier ones are received
+     */
+    void testForwardBuffers()
+    {
+        sub0test::MemoryStream stream;
+        {
+            const std::vector<char> buffer = writeStream();
+            stream.buffer.assign( buffer.begin(), buffer.begin() + (2U * 3U * cRecordBytes) ); //< Reading 0 to 2 fill every slot
+            OrderedSink sink;
+            BufferedReader reader( stream );
+            while ( !stream.isEof() )
+                reader.update();
+            SUB0PUB_TEST_CHECK( sink.count == 0U );
+            SUB0PUB_TEST_CHECK( (reader.dispatch( 2U ) == 2U) && (reader.dispatch() == 1U) && (reader.dispatch() == 0U) );
+            SUB0PUB_TEST_CHECK( (sink.count == 3U) && (sink.misordered == 0U) );
+        }
+
+        stream.buffer = writeStream();
+        stream.rewind( 5U );
+        OrderedSink sink;
+        BufferedReader reader( stream );
+        std::atomic<bool> done( false );
+        std::thread decoder( [&stream, &reader, &done]()
+        {
+            while ( !stream.isEof() )
+                reader.update();
+            done.store( true, std::memory_order_release );
+        } );
+        uint32_t published = 0U;
+        while ( !done.load( std::memory_order_acquire ) )
+            published += reader.dispatch();
+        decoder.join();
+        published += reader.dispatch(); //< Slots completed after the last dispatch
+        SUB0PUB_TEST_CHECK( (published == cRecordPairs) && (sink.count == cRecordPairs) && (sink.misordered == 0U) );
+    }
+
+    /** Set 'count' headers of ids 'step' apart, each to a buffer of its index, and find them again
+     * @tparam Register  BufferRegister, DenseBufferRegister or HashBufferRegister of Protocol::Header
+     */
+    template< typename Register >
+    void checkRegister( const uint32_t count, const uint32_t step )
+    {
+        Register registry;
+        char bytes[128];
+        for ( uint32_t iHeader = 0U; iHeader < count; ++iHeader )
+            registry.set( Protocol::Header( 1U + (iHeader * step), 4U ), sub0::Buffer{ &bytes[iHeader], 4U, 0U, nullptr } );
+        registry.set( Protocol::Header( 1U, 4U ), sub0::Buffer{ &bytes[count], 4U, 0U, nullptr } ); //< Replaces the first entry
+
+        bool found = (registry.find( Protocol::Header( 1U, 4U ) ).buffer == &bytes[count]);
+        for ( uint32_t iHeader = 1U; iHeader < count; ++iHeader )
+            found = found && (registry.find( Protocol::Header( 1U + (iHeader * step), 4U ) ).buffer == &bytes[iHeader]);
+        SUB0PUB_TEST_CHECK( found );
+        SUB0PUB_TEST_CHECK( registry.find( Protocol::Header( 1U + step, 8U ) ).buffer == nullptr ); //< Payload size differs
+        SUB0PUB_TEST_CHECK( registry.find( Protocol::Header( 1U + (count * step), 4U ) ).buffer == nullptr );
+        SUB0PUB_TEST_CHECK( registry.find( Protocol::Header( 0U, 4U ) ).buffer == nullptr );
+    }
+
+    /** Reader using a robin-hood hash lookup
+     */
+    struct HashedSerialisation : Protocol
+    {
+        using Reader = ReaderWith< sub0::HashBufferRegister<Header, 64U> >;
+    };
+
+    /** Publishes Reading and Count from a stream through HashBufferRegister
+     */
+    class HashedReader : public sub0::StreamDeserializer<HashedSerialisation>
+        , public sub0::ForwardPublish<Reading, HashedReader>
+        , public sub0::ForwardPublish<Count, HashedReader>
+    {
+    public:
+        explicit HashedReader( sub0::IStream& stream )
+            : sub0::StreamDeserializer<HashedSerialisation>( stream )
+        {}
+    };
+
+    /** Sums the deserialised Count
+     */
+    class CountSink : public sub0::Subscribe<Count>
+    {
+    public:
+        CountSink()
+            : sum(0U)
+        {}
+
+        virtual void receive( const Count& count ) final
+        { sum += count.value; }
+
+        uint32_t sum; ///< Sum of received values
+    };
+
+    /** Sorted, dense and hashed registers find every set header, including ids colliding in the hash table, and only those
+     */
+    void testBufferRegisters()
+    {
+        checkRegister< sub0::BufferRegister<Protocol::Header> >( 60U, 0x9E3779B1U );
+        checkRegister< sub0::DenseBufferRegister<Protocol::Header> >( 100U, 2U );
+        checkRegister< sub0::HashBufferRegister<Protocol::Header> >( 100U, 128U ); //< 100 of 128 slots, probing past colliding entries
+        checkRegister< sub0::HashBufferRegister<Protocol::Header> >( 100U, 0x9E3779B1U );
+
+        sub0test::MemoryStream stream;
+        stream.buffer = writeStream();
+        ReadingSink readings;
+        CountSink counts;
+        HashedReader reader( stream );
+        while ( !stream.isEof() )
+            reader.update();
+        SUB0PUB_TEST_CHECK( (readings.count == cRecordPairs) && (counts.sum == ((cRecordPairs * (cRecordPairs - 1U)) / 2U)) );
+        SUB0PUB_TEST_CHECK( reader.skipCount() == 0U );
+    }
+
+    /** Registered ids and headers are constant expressions, the id being the djb2 hash of the registered name
+     */
+    void testTypeIds()
+    {
+        static_assert( sub0::utility::hash( "" ) == 5381U, "djb2 seed" );
+        static_assert( sub0::utility::hash( "a" ) == ((5381U * 33U) + 'a'), "djb2 step" );
+        static_assert( sub0::typeId<Reading>() == sub0::utility::hash( "Reading" ), "SUB0_TYPENAME id is the name hash" );
+        static_assert( sub0::typeId<Reading>() != sub0::typeId<Count>(), "Distinct names hash apart" );
+        static_assert( sub0::TypeName<Count>::cRegistered && !sub0::TypeName<Unnamed>::cRegistered, "Registration is per type" );
+
+        constexpr Protocol::Header header = Protocol::Header::of<Count>();
+        static_assert( (header.typeId == sub0::typeId<Count>()) && (header.dataBytes == sizeof(Count)), "Header of a registered type" );
+
+        SUB0PUB_TEST_CHECK( std::strcmp( sub0::typeName<Reading>(), "Reading" ) == 0 );
+        SUB0PUB_TEST_CHECK( sub0::typeName<Unnamed>() == nullptr );
+        SUB0PUB_TEST_CHECK( Protocol::Header( Count{ 1U } ) == header );
+    }
+
+    /** Stream accepting at most 'limit' bytes per write
+     */
+    class ShortStream : public sub0test::MemoryStream
+    {
+    public:
+        explicit ShortStream( const sub0::OStream::StreamSize limitBytes )
+            : limit( limitBytes )
+        {}
+
+        virtual sub0::OStream::StreamSize write( const char* const data, const sub0::OStream::StreamSize dataCount ) override
+        { return sub0test::MemoryStream::write( data, std::min( dataCount, limit ) ); }
+
+        sub0::OStream::StreamSize limit; ///< Bytes accepted by each write
+    };
+
+    /** BinaryWriter keeps the bytes a partial write did not accept and writes them first on the next flush
+     */
+    void testPartialFlush()
+    {
+        Protocol::Writer writer;
+        writer.setBufferSize( 1024U );
+        ShortStream stream( 7U );
+        for ( uint32_t iPair = 0U; iPair < cRecordPairs; ++iPair )
+        {
+            writer.write( stream, Reading{ static_cast<float>(iPair) } );
+            writer.write( stream, Count{ iPair } );
+        }
+
+        uint32_t flushCount = 1U;
+        while ( !writer.flush( stream ) )
+            ++flushCount;
+        SUB0PUB_TEST_CHECK( flushCount > 1U );
+        SUB0PUB_TEST_CHECK( stream.buffer == writeStream() );
+    }
+} // END: namespace
+
+int main()
+{
+    testStreamClean();
+    testPartialFlush();
+    testStreamResync();
+    testBufferCorrupt();
+    testBufferStream();
+    testForwardBuffers();
+    testBufferRegisters();
+    testTypeIds();
+    return sub0test::result();
+}
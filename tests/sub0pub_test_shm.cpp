@@ -0,0 +1,168 @@
+/** Shared memory tests: ShmRing wrap-around of the data region and of its 32-bit positions
+ */
+
+#include "sub0pub_test.hpp"
+#include "sub0pub/shm.hpp"
+
+#include <stdexcept> //< std::runtime_error
+#include <thread> //< std::thread
+
+namespace
+{
+    /** Record not dividing the ring capacity so records straddle the end of the data region
+     */
+    struct Block
+    {
+        uint64_t seq;
+        char fill[3992];
+        uint64_t check;
+    };
+
+    /** Record published through ShmSerializer and ShmDeserializer
+     */
+    struct Sample
+    {
+        uint64_t seq;
+        uint64_t check;
+    };
+} // END: namespace
+
+SUB0_TYPEID( Sample, "Sample", 7U )
+SUB0_TYPEID_OWNER( Sample )
+
+namespace
+{
+    /** Records reserved across the end of the mirrored data region read back whole, past 2^32 bytes committed
+     */
+    void testRingWrap()
+    {
+        sub0::ShmRing ring( nullptr, 3U * 4096U );
+        SUB0PUB_TEST_CHECK( ring.capacity() == 16384U );
+
+        const uint32_t cInFlight = 3U;
+        const uint64_t cCount = ((5ULL << 30U) / sizeof(Block)) + 1U; //< Positions wrap at 4GiB
+        Block block;
+        std::memset( &block, 0, sizeof(block) );
+        uint64_t expected = 0U;
+        for ( uint64_t iBlock = 0U; iBlock < cCount; ++iBlock )
+        {
+            block.seq = iBlock;
+            block.fill[0] = static_cast<char>(iBlock);
+            block.fill[sizeof(block.fill) - 1U] = static_cast<char>(iBlock >> 8U);
+            block.check = ~iBlock;
+            char* const reserved = ring.reserve( sizeof(block), 0 );
+            SUB0PUB_TEST_CHECK( reserved != nullptr );
+            if ( !reserved )
+                return;
+            std::memcpy( reserved, &block, sizeof(block) );
+            ring.commit( sizeof(block) );
+            if ( iBlock < (cInFlight - 1U) )
+                continue;
+
+            uint32_t available = 0U;
+            const char* const oldest = ring.peek( available );
+            Block read;
+            std::memcpy( &read, oldest, sizeof(read) );
+            const bool intact = (available == (cInFlight * sizeof(Block))) && (read.seq == expected) && (read.check == ~expected)
+                && (read.fill[0] == static_cast<char>(expected)) && (read.fill[sizeof(read.fill) - 1U] == static_cast<char>(expected >> 8U));
+            SUB0PUB_TEST_CHECK( intact );
+            if ( !intact )
+                return;
+            ring.consume( sizeof(read) );
+            ++expected;
+        }
+    }
+
+    /** Publishes Sample records read from a ring
+     */
+    class Reader : public sub0::ShmDeserializer<>
+        , public sub0::ShmPublish<Sample, Reader>
+    {
+    public:
+        explicit Reader( sub0::ShmRing& ring )
+            : sub0::ShmDeserializer<>( ring )
+        {}
+    };
+
+    /** Checks Sample is received in order
+     */
+    class SampleSink : public sub0::Subscribe<Sample>
+    {
+    public:
+        SampleSink()
+            : count(0U)
+        {}
+
+        virtual void receive( const Sample& sample ) final
+        {
+            SUB0PUB_TEST_CHECK( (sample.seq == count) && (sample.check == ~count) );
+            ++count;
+        }
+
+        uint64_t count; ///< Count of received Sample
+    };
+
+    /** Producer thread filling a one page ring many times over while the consumer publishes each record in order
+     */
+    void testSerialiserWrap()
+    {
+        const uint64_t cCount = 200000U;
+        sub0::ShmRing ring( nullptr, 4096U );
+        std::thread producer( [&ring, cCount]()
+        {
+            sub0::ShmSerializer<> writer( ring );
+            for ( uint64_t iSample = 0U; iSample < cCount; ++iSample )
+                writer.forward( Sample{ iSample, ~iSample } );
+            writer.close();
+        } );
+
+        SampleSink sink;
+        Reader reader( ring );
+        for (;;)
+        {
+            const bool closed = ring.isClosed();
+            reader.update();
+            if ( closed && !reader.update() )
+                break;
+            reader.wait( 100 );
+        }
+        producer.join();
+
+        SUB0PUB_TEST_CHECK( sink.count == cCount );
+        SUB0PUB_TEST_CHECK( reader.corruptCount() == 0U );
+    }
+
+    /** A named segment failing setup after shm_open is unlinked before the constructor throws
+     */
+    void testCreateFailure()
+    {
+        char name[64];
+        std::snprintf( name, sizeof(name), "/sub0pub-test-%d", static_cast<int>(::getpid()) );
+        bool thrown = false;
+        try
+        {
+            sub0::ShmRing ring( name, 0x80000001U );
+        }
+        catch ( const std::runtime_error& )
+        {
+            thrown = true;
+        }
+        SUB0PUB_TEST_CHECK( thrown );
+
+        const int fd = ::shm_open( name, O_RDWR, 0600 );
+        SUB0PUB_TEST_CHECK( fd < 0 );
+        if ( fd >= 0 )
+        {
+            ::close( fd );
+            ::shm_unlink( name );
+        }
+    }
+} // END: namespace
+
+int main()
+{
+    testRingWrap();
+    testSerialiserWrap();
+    testCreateFailure();
+    return sub0test::result();
+}
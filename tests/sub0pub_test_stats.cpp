@@ -0,0 +1,109 @@
+/** Statistics tests: per-channel counters and receive times reach the snapshot, Prometheus and JSON exports
+ */
+
+#include "sub0pub_test.hpp"
+
+#include <string> //< std::string
+#include <vector> //< std::vector
+
+namespace
+{
+    /** Published data counted by the statistics
+     */
+    struct Temperature
+    {
+        uint32_t value;
+    };
+} // END: namespace
+
+SUB0_TYPEID( Temperature, "Temperature", 11U )
+
+namespace
+{
+    /** Receives Temperature of a channel, filter() passes even values
+     */
+    template< typename Channel >
+    class EvenSink : public sub0::Subscribe<Temperature, Channel>
+    {
+    public:
+        EvenSink()
+            : count(0U)
+        {}
+
+        explicit EvenSink( const sub0::ChannelId channel )
+            : sub0::Subscribe<Temperature, Channel>( channel )
+            , count(0U)
+        {}
+
+        virtual bool filter( const Temperature& temperature ) final
+        { return (temperature.value % 2U) == 0U; }
+
+        virtual void receive( const Temperature& ) final
+        { ++count; }
+
+        uint32_t count; ///< Count of received Temperature
+    };
+
+    /** @return Snapshot of the Temperature broker of 'channel'
+     */
+    sub0::stats::BrokerSnapshot find( const std::vector<sub0::stats::BrokerSnapshot>& brokers, const char* const channel )
+    {
+        for ( const sub0::stats::BrokerSnapshot& broker : brokers )
+        {
+            if ( (broker.typeId == 11U) && (std::strcmp( broker.channel, channel ) == 0) )
+                return broker;
+        }
+        return sub0::stats::BrokerSnapshot();
+    }
+
+    /** @return Text written to a MemoryStream
+     */
+    std::string text( const sub0test::MemoryStream& stream )
+    { return std::string( stream.buffer.begin(), stream.buffer.end() ); }
+
+    /** Publishes, deliveries, filter rejects and receive times are counted per channel and exported
+     */
+    void testCounters()
+    {
+        EvenSink<void> sink;
+        EvenSink<sub0::RuntimeChannel> channelSink( sub0::ChannelId( 3U ) );
+        const sub0::Publish<Temperature> publisher;
+        const sub0::Publish<Temperature, sub0::RuntimeChannel> channelPublisher( sub0::ChannelId( 3U ) );
+        for ( uint32_t iValue = 0U; iValue < 4U; ++iValue )
+            publisher.publish( Temperature{ iValue } );
+        const Temperature batch[3] = { { 2U }, { 4U }, { 5U } };
+        publisher.publishBatch( batch, 3U );
+        channelPublisher.publish( Temperature{ 8U } );
+
+        std::vector<sub0::stats::BrokerSnapshot> brokers;
+        sub0::stats::snapshot( brokers );
+        const sub0::stats::BrokerSnapshot broker = find( brokers, "" );
+        SUB0PUB_TEST_CHECK( (broker.typeName != nullptr) && (std::strcmp( broker.typeName, "Temperature" ) == 0) );
+        SUB0PUB_TEST_CHECK( (broker.publishCount == 7U) && (broker.deliveryCount == 7U) && (broker.filterRejectCount == 3U) );
+        SUB0PUB_TEST_CHECK( (broker.subscribers.size() == 1U) && (broker.subscribers[0].subscriber == &sink) );
+        SUB0PUB_TEST_CHECK( (sink.count == 4U) && (broker.subscribers[0].receiveCount > 0U) );
+
+        const sub0::stats::BrokerSnapshot channel = find( brokers, "#3" );
+        SUB0PUB_TEST_CHECK( (channel.publishCount == 1U) && (channel.filterRejectCount == 0U) && (channelSink.count == 1U) );
+
+        sub0test::MemoryStream prometheus;
+        sub0::stats::writePrometheus( prometheus );
+        const std::string exposition = text( prometheus );
+        SUB0PUB_TEST_CHECK( exposition.find( "# TYPE sub0pub_publish_total counter\n" ) != std::string::npos );
+        SUB0PUB_TEST_CHECK( exposition.find( "sub0pub_publish_total{type=\"Temperature\",id=\"11\",channel=\"\"} 7\n" ) != std::string::npos );
+        SUB0PUB_TEST_CHECK( exposition.find( "sub0pub_filter_reject_total{type=\"Temperature\",id=\"11\",channel=\"#3\"} 0\n" ) != std::string::npos );
+        SUB0PUB_TEST_CHECK( exposition.find( "sub0pub_receive_nanoseconds_bucket{type=\"Temperature\",channel=\"\"" ) != std::string::npos );
+
+        sub0test::MemoryStream json;
+        sub0::stats::writeJson( json );
+        const std::string document = text( json );
+        SUB0PUB_TEST_CHECK( document.find( "{\"type\":\"Temperature\",\"id\":11,\"channel\":\"\",\"publish\":7,\"delivery\":7,\"filterReject\":3," ) != std::string::npos );
+        SUB0PUB_TEST_CHECK( (document.compare( 0U, 12U, "{\"brokers\":[" ) == 0) && (document.compare( document.size() - 3U, 3U, "]}\n" ) == 0) );
+    }
+} // END: namespace
+
+int main()
+{
+    testCounters();
+    return sub0test::result();
+}
@@ -0,0 +1,120 @@
+/** Trace tests: broker events recorded per thread by RingSink are dumped and decoded in timestamp order
+ */
+
+#include "sub0pub_test.hpp"
+
+#include <string> //< std::string
+#include <thread> //< std::thread
+#include <vector> //< std::vector
+
+namespace
+{
+    /** Published data of the traced broker
+     */
+    struct Probe
+    {
+        uint32_t value;
+    };
+} // END: namespace
+
+SUB0_TYPEID( Probe, "Probe", 13U )
+
+namespace
+{
+    /** Receives Probe
+     */
+    class ProbeSink : public sub0::Subscribe<Probe>
+    {
+    public:
+        virtual void receive( const Probe& ) final
+        {}
+    };
+
+    /** @return Count of decoded Probe records of 'event' with 'address'
+     */
+    uint32_t countOf( const std::vector<sub0::trace::Record>& records, const sub0::trace::Event event, const void* const address )
+    {
+        uint32_t count = 0U;
+        for ( const sub0::trace::Record& record : records )
+        {
+            if ( (record.typeId == 13U) && (record.event == event) && (record.address == reinterpret_cast<uintptr_t>(address)) )
+                ++count;
+        }
+        return count;
+    }
+
+    /** Subscribe, publish, batch and receive events of two threads decode in order with their payload hashes
+     */
+    void testRingDump()
+    {
+        ProbeSink sink;
+        const sub0::Publish<Probe> publisher;
+        publisher.publish( Probe{ 1U } );
+        const Probe batch[3] = { { 2U }, { 3U }, { 4U } };
+        publisher.publishBatch( batch, 3U );
+        std::thread other( []()
+        {
+            const sub0::Publish<Probe> threadPublisher;
+            threadPublisher.publish( Probe{ 5U } );
+        } );
+        other.join();
+
+        sub0test::MemoryStream stream;
+        SUB0PUB_TEST_CHECK( sub0::trace::RingSink::dump( stream ) );
+        sub0::trace::Decoder decoder;
+        SUB0PUB_TEST_CHECK( decoder.parse( stream.buffer.data(), stream.buffer.size() ) );
+        const std::vector<sub0::trace::Record>& records = decoder.records();
+
+        SUB0PUB_TEST_CHECK( countOf( records, sub0::trace::cSubscription, &sink ) == 1U );
+        SUB0PUB_TEST_CHECK( countOf( records, sub0::trace::cPublication, &publisher ) == 1U );
+        SUB0PUB_TEST_CHECK( countOf( records, sub0::trace::cPublish, &publisher ) == 1U );
+        SUB0PUB_TEST_CHECK( countOf( records, sub0::trace::cPublishBatch, &publisher ) == 1U );
+        SUB0PUB_TEST_CHECK( countOf( records, sub0::trace::cReceive, &sink ) == 3U ); //< A batch is traced once per subscription
+
+        bool ordered = true;
+        uint16_t mainThread = 0U;
+        uint16_t otherThread = 0U;
+        for ( size_t iRecord = 0U; iRecord < records.size(); ++iRecord )
+        {
+            const sub0::trace::Record& record = records[iRecord];
+            ordered = ordered && ((iRecord == 0U) || (records[iRecord - 1U].timestamp <= record.timestamp));
+            if ( record.typeId != 13U )
+                continue;
+            if ( record.event == sub0::trace::cPublishBatch )
+                SUB0PUB_TEST_CHECK( (record.count == 3U) && (record.payloadHash == sub0::trace::payloadHash( batch[0] )) );
+            if ( record.event == sub0::trace::cSubscription )
+                mainThread = record.thread;
+            if ( (record.event == sub0::trace::cPublish) && (record.payloadHash == sub0::trace::payloadHash( Probe{ 5U } )) )
+                otherThread = record.thread;
+        }
+        SUB0PUB_TEST_CHECK( ordered && (mainThread != otherThread) );
+
+        sub0test::MemoryStream text;
+        decoder.print( text );
+        const std::string lines( text.buffer.begin(), text.buffer.end() );
+        SUB0PUB_TEST_CHECK( lines.find( " publish-batch type=13 " ) != std::string::npos );
+        SUB0PUB_TEST_CHECK( static_cast<size_t>( std::count( lines.begin(), lines.end(), '\n' ) ) == records.size() );
+    }
+
+    /** A trace with a different magic or fewer records than its header counts is rejected
+     */
+    void testDecodeInvalid()
+    {
+        sub0test::MemoryStream stream;
+        SUB0PUB_TEST_CHECK( sub0::trace::RingSink::dump( stream ) );
+        sub0::trace::Decoder decoder;
+        std::vector<char> trace = stream.buffer;
+        SUB0PUB_TEST_CHECK( decoder.parse( trace.data(), trace.size() ) && !decoder.records().empty() );
+        SUB0PUB_TEST_CHECK( !decoder.parse( trace.data(), trace.size() - 1U ) );
+        SUB0PUB_TEST_CHECK( !decoder.parse( trace.data(), sizeof(sub0::trace::Header) - 1U ) );
+        trace[0] ^= 0x5A;
+        SUB0PUB_TEST_CHECK( !decoder.parse( trace.data(), trace.size() ) && decoder.records().empty() );
+    }
+} // END: namespace
+
+int main()
+{
+    testRingDump();
+    testDecodeInvalid();
+    return sub0test::result();
+}
@@ -0,0 +1,38 @@
+/** Sub0Pub trace decoder
+ * @remark Prints a binary trace written by sub0::trace::RingSink::dump() as one line per record in timestamp order
+ *  Usage: Sub0Pub_TraceDecoder <trace file>
+ */
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <fstream> //< std::ifstream
+#include <iostream> //< std::cout, std::cerr
+#include <iterator> //< std::istreambuf_iterator
+#include <vector> //< std::vector
+
+int main( int argc, char* argv[] )
+{
+    if ( argc != 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <trace file>" << std::endl;
+        return 1;
+    }
+
+    std::ifstream file( argv[1], std::ios::binary );
+    if ( !file )
+    {
+        std::cerr << "Unable to open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    const std::vector<char> content( (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>() );
+    sub0::trace::Decoder decoder;
+    if ( !decoder.parse( content.data(), content.size() ) )
+    {
+        std::cerr << argv[1] << " is not a Sub0Pub trace" << std::endl;
+        return 1;
+    }
+
+    decoder.print( std::cout );
+    return 0;
+}